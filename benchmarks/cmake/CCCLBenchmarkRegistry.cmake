@@ -1,4 +1,5 @@
-find_package(CUDAToolkit REQUIRED)
+# The host benchmarks register without a CUDA toolkit
+find_package(CUDAToolkit QUIET)
 
 find_package(Git REQUIRED)
 if(GIT_FOUND)
@@ -26,9 +27,19 @@ function(get_meta_path meta_path)
 endfunction()
 
 function(create_benchmark_registry)
+  # Several benchmark suites share the registry; only the first one creates it
+  get_property(registry_created GLOBAL PROPERTY CCCL_BENCHMARK_REGISTRY_CREATED)
+  if (registry_created)
+    return()
+  endif()
+  set_property(GLOBAL PROPERTY CCCL_BENCHMARK_REGISTRY_CREATED TRUE)
+
   get_meta_path(meta_path)
 
   set(ctk_version "${CUDAToolkit_VERSION}")
+  if ("${ctk_version}" STREQUAL "")
+    set(ctk_version "none")
+  endif()
   message(STATUS "CTK version: ${ctk_version}")
 
   file(REMOVE "${meta_path}")
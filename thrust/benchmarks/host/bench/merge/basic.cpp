@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#include "host_bench.h"
+
+#include <thrust/merge.h>
+#include <thrust/sort.h>
+
+template <typename T>
+static void basic(host_bench::state &state, host_bench::type_list<T>)
+{
+  const auto elements   = static_cast<std::size_t>(state.get_int64("Elements"));
+  const auto size_ratio = static_cast<std::size_t>(state.get_int64("InputSizeRatio"));
+  const auto entropy    = state.get_string("Entropy");
+  const auto elements_in_lhs =
+    static_cast<std::size_t>(static_cast<double>(size_ratio * elements) / 100.0);
+
+  host_bench::vector<T> out(elements);
+  host_bench::vector<T> in = host_bench::generate<T>(elements, entropy);
+  thrust::sort(host_bench::policy, in.begin(), in.begin() + elements_in_lhs);
+  thrust::sort(host_bench::policy, in.begin() + elements_in_lhs, in.end());
+
+  state.add_element_count(elements);
+  state.add_global_memory_reads<T>(elements);
+  state.add_global_memory_writes<T>(elements);
+
+  state.exec([&] {
+    thrust::merge(host_bench::policy,
+                  in.cbegin(),
+                  in.cbegin() + elements_in_lhs,
+                  in.cbegin() + elements_in_lhs,
+                  in.cend(),
+                  out.begin());
+  });
+}
+
+HOST_BENCH_TYPES(basic, host_bench::fundamental_types)
+  .set_name("base")
+  .set_type_axes_names({"T{ct}"})
+  .add_int64_power_of_two_axis("Elements", host_bench::range(16, 28, 4))
+  .add_string_axis("Entropy", {"1.000", "0.201"})
+  .add_int64_axis("InputSizeRatio", {25, 50, 75});
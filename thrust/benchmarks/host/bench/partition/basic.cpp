@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#include "host_bench.h"
+
+#include <thrust/iterator/reverse_iterator.h>
+#include <thrust/partition.h>
+
+#include <limits>
+
+template <typename T>
+struct less_then_t
+{
+  T m_val;
+
+  bool operator()(const T &val) const { return val < m_val; }
+};
+
+template <typename T>
+T value_from_entropy(double percentage)
+{
+  if (percentage == 1)
+  {
+    return std::numeric_limits<T>::max();
+  }
+
+  const auto max_val = static_cast<double>(std::numeric_limits<T>::max());
+  const auto min_val = static_cast<double>(std::numeric_limits<T>::lowest());
+  const auto result  = min_val + percentage * max_val - percentage * min_val;
+  return static_cast<T>(result);
+}
+
+template <typename T>
+static void basic(host_bench::state &state, host_bench::type_list<T>)
+{
+  using select_op_t = less_then_t<T>;
+
+  const auto elements       = static_cast<std::size_t>(state.get_int64("Elements"));
+  const std::string entropy = state.get_string("Entropy");
+
+  T val = value_from_entropy<T>(host_bench::entropy_to_probability(entropy));
+  select_op_t select_op{val};
+
+  host_bench::vector<T> input = host_bench::generate<T>(elements);
+  host_bench::vector<T> output(elements);
+
+  state.add_element_count(elements);
+  state.add_global_memory_reads<T>(elements);
+  state.add_global_memory_writes<T>(elements);
+
+  state.exec([&] {
+    thrust::partition_copy(host_bench::policy,
+                           input.cbegin(),
+                           input.cend(),
+                           output.begin(),
+                           thrust::make_reverse_iterator(output.begin() + elements),
+                           select_op);
+  });
+}
+
+HOST_BENCH_TYPES(basic, host_bench::fundamental_types)
+  .set_name("base")
+  .set_type_axes_names({"T{ct}"})
+  .add_int64_power_of_two_axis("Elements", host_bench::range(16, 28, 4))
+  .add_string_axis("Entropy", {"1.000", "0.544", "0.000"});
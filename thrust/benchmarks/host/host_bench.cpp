@@ -0,0 +1,1061 @@
+/******************************************************************************
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#include "host_bench.h"
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+#include <omp.h>
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+#include <tbb/global_control.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/stat.h>
+
+namespace host_bench
+{
+
+std::vector<std::int64_t> range(std::int64_t start, std::int64_t end, std::int64_t stride)
+{
+  std::vector<std::int64_t> result;
+  for (std::int64_t value = start; value <= end; value += stride)
+  {
+    result.push_back(value);
+  }
+  return result;
+}
+
+
+double entropy_to_probability(const std::string &entropy)
+{
+  // validates the entropy
+  detail::entropy_to_and_count(entropy);
+  return std::stod(entropy);
+}
+
+namespace detail
+{
+
+int entropy_to_and_count(const std::string &entropy)
+{
+  const char *entropies[] = {"0.000", "1.000", "0.811", "0.544", "0.337", "0.201"};
+
+  for (int i = 0; i < 6; ++i)
+  {
+    if (entropy == entropies[i])
+    {
+      return i;
+    }
+  }
+
+  throw std::runtime_error("unsupported entropy: " + entropy);
+}
+
+} // namespace detail
+
+
+std::int64_t state::get_int64(const std::string &name) const
+{
+  for (const auto &value : m_int64_values)
+  {
+    if (value.first == name)
+    {
+      return value.second;
+    }
+  }
+  throw std::runtime_error("no int64 axis named " + name);
+}
+
+const std::string &state::get_string(const std::string &name) const
+{
+  for (const auto &value : m_string_values)
+  {
+    if (value.first == name)
+    {
+      return value.second;
+    }
+  }
+  throw std::runtime_error("no string axis named " + name);
+}
+
+void state::add_sample(double seconds)
+{
+  m_samples.push_back(static_cast<float>(seconds));
+  m_sum += seconds;
+  m_sum_squares += seconds * seconds;
+}
+
+double state::mean() const
+{
+  return m_samples.empty() ? 0.0 : m_sum / static_cast<double>(m_samples.size());
+}
+
+double state::noise() const
+{
+  const double n = static_cast<double>(m_samples.size());
+
+  if (n < 2)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  const double variance = (std::max)(0.0, (m_sum_squares - m_sum * m_sum / n) / (n - 1));
+  return 100.0 * std::sqrt(variance) / mean();
+}
+
+
+namespace
+{
+
+std::int64_t hardware_threads()
+{
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+  return omp_get_num_procs();
+#else
+  return (std::max)(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+// 1, 2, 4, ... up to every hardware thread; the CPP system is serial
+axis threads_axis()
+{
+  std::vector<std::int64_t> counts{1};
+
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CPP
+  const std::int64_t max_threads = hardware_threads();
+  for (std::int64_t threads = 2; threads < max_threads; threads *= 2)
+  {
+    counts.push_back(threads);
+  }
+  if (max_threads > 1)
+  {
+    counts.push_back(max_threads);
+  }
+#endif
+
+  axis result{"Threads", axis::int64_axis, false, {}};
+  for (std::int64_t threads : counts)
+  {
+    result.values.push_back({std::to_string(threads), "", threads});
+  }
+  return result;
+}
+
+} // namespace
+
+
+benchmark &benchmark::set_name(std::string name)
+{
+  m_name = std::move(name);
+  return *this;
+}
+
+benchmark &benchmark::set_type_axes_names(std::vector<std::string> names)
+{
+  if (names.size() != 1)
+  {
+    throw std::logic_error("host benchmarks support exactly one type axis");
+  }
+  m_type_axis.name = std::move(names.front());
+  return *this;
+}
+
+benchmark &benchmark::add_int64_axis(std::string name, std::vector<std::int64_t> values)
+{
+  axis a{std::move(name), axis::int64_axis, false, {}};
+  for (std::int64_t value : values)
+  {
+    a.values.push_back({std::to_string(value), "", value});
+  }
+  m_axes.push_back(std::move(a));
+  return *this;
+}
+
+benchmark &benchmark::add_int64_power_of_two_axis(std::string name, std::vector<std::int64_t> exponents)
+{
+  axis a{std::move(name), axis::int64_axis, true, {}};
+  for (std::int64_t exponent : exponents)
+  {
+    const std::int64_t value = std::int64_t{1} << exponent;
+    a.values.push_back({std::to_string(exponent), "2^" + std::to_string(exponent) + " = " + std::to_string(value), value});
+  }
+  m_axes.push_back(std::move(a));
+  return *this;
+}
+
+benchmark &benchmark::add_string_axis(std::string name, std::vector<std::string> values)
+{
+  axis a{std::move(name), axis::string_axis, false, {}};
+  for (std::string &value : values)
+  {
+    a.values.push_back({std::move(value), "", 0});
+  }
+  m_axes.push_back(std::move(a));
+  return *this;
+}
+
+void benchmark::add_type(std::string input_string, std::string description, instance run)
+{
+  m_type_axis.values.push_back({std::move(input_string), std::move(description), 0});
+  m_instances.push_back(std::move(run));
+}
+
+std::vector<axis> benchmark::axes() const
+{
+  std::vector<axis> result{m_type_axis};
+  result.insert(result.end(), m_axes.begin(), m_axes.end());
+  result.push_back(threads_axis());
+  return result;
+}
+
+
+std::vector<std::unique_ptr<benchmark>> &registry()
+{
+  static std::vector<std::unique_ptr<benchmark>> benchmarks;
+  return benchmarks;
+}
+
+benchmark &add_benchmark()
+{
+  registry().emplace_back(new benchmark);
+  return *registry().back();
+}
+
+
+namespace
+{
+
+// limits the system to `threads` workers for the lifetime of the object
+class thread_limit
+{
+public:
+  explicit thread_limit(std::int64_t threads)
+  {
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+    m_previous = omp_get_max_threads();
+    omp_set_num_threads(static_cast<int>(threads));
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+    m_control.reset(
+      new ::tbb::global_control(::tbb::global_control::max_allowed_parallelism, static_cast<std::size_t>(threads)));
+#else
+    (void) threads;
+#endif
+  }
+
+  ~thread_limit()
+  {
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+    omp_set_num_threads(m_previous);
+#endif
+  }
+
+  thread_limit(const thread_limit &)            = delete;
+  thread_limit &operator=(const thread_limit &) = delete;
+
+private:
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+  int m_previous;
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+  std::unique_ptr<::tbb::global_control> m_control;
+#endif
+};
+
+
+std::string cpu_name()
+{
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+
+  while (std::getline(cpuinfo, line))
+  {
+    if (line.compare(0, 10, "model name") == 0)
+    {
+      const std::size_t colon = line.find(':');
+      if (colon != std::string::npos && colon + 2 <= line.size())
+      {
+        return line.substr(colon + 2);
+      }
+    }
+  }
+
+  return "Host CPU";
+}
+
+
+std::string json_string(const std::string &str)
+{
+  std::string result = "\"";
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"': result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\t': result += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          result += escaped;
+        }
+        else
+        {
+          result += c;
+        }
+    }
+  }
+  return result + "\"";
+}
+
+std::string to_string(double value)
+{
+  std::ostringstream out;
+  out.precision(17);
+  out << value;
+  return out.str();
+}
+
+std::string format_duration(double seconds)
+{
+  char buffer[32];
+  if (seconds >= 1.0)
+  {
+    std::snprintf(buffer, sizeof(buffer), "%.3f s", seconds);
+  }
+  else if (seconds >= 1e-3)
+  {
+    std::snprintf(buffer, sizeof(buffer), "%.3f ms", seconds * 1e3);
+  }
+  else
+  {
+    std::snprintf(buffer, sizeof(buffer), "%.3f us", seconds * 1e6);
+  }
+  return buffer;
+}
+
+std::string format_rate(double rate, const char *unit)
+{
+  const char *prefixes[] = {"", "K", "M", "G", "T"};
+  int prefix = 0;
+  while (rate >= 1000.0 && prefix < 4)
+  {
+    rate /= 1000.0;
+    ++prefix;
+  }
+
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f%s%s", rate, prefixes[prefix], unit);
+  return buffer;
+}
+
+
+// an axis restricted by `-a`
+struct axis_override
+{
+  std::string name;
+  bool power_of_two;
+  std::vector<std::string> tokens;
+};
+
+// one `-b` and the `-a` that follow it
+struct selection
+{
+  std::size_t benchmark_index;
+  std::vector<axis_override> overrides;
+};
+
+
+struct state_result
+{
+  std::size_t type_index;
+  std::vector<std::size_t> value_indices; // per axis, after overrides
+  std::vector<float> samples;
+  double mean;
+  double noise;
+  std::size_t elements;
+  std::size_t bytes;
+  std::string skip_reason;
+};
+
+} // namespace
+
+
+class runner
+{
+public:
+  runner(int argc, char **argv)
+  {
+    for (int i = 0; i < argc; ++i)
+    {
+      m_argv.push_back(argv[i]);
+    }
+  }
+
+  int run()
+  {
+    try
+    {
+      parse();
+
+      if (m_list_devices)
+      {
+        std::cout << "{\n  \"devices\": [\n    " << device_json() << "\n  ]\n}\n";
+        return 0;
+      }
+
+      if (m_list_benches)
+      {
+        print_bench_list();
+        return 0;
+      }
+
+      if (m_list)
+      {
+        print_human_list();
+        return 0;
+      }
+
+      std::vector<std::string> bench_jsons;
+      for (const selection &sel : selections())
+      {
+        bench_jsons.push_back(run_benchmark(sel));
+      }
+
+      if (!m_json_path.empty())
+      {
+        write_json(bench_jsons);
+      }
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << "error: " << e.what() << "\n";
+      return 1;
+    }
+
+    return 0;
+  }
+
+private:
+  std::string next_arg(std::size_t &i) const
+  {
+    if (i + 1 >= m_argv.size())
+    {
+      throw std::runtime_error("missing value for " + m_argv[i]);
+    }
+    return m_argv[++i];
+  }
+
+  std::size_t find_benchmark(const std::string &name_or_index) const
+  {
+    const auto &benchmarks = registry();
+    for (std::size_t i = 0; i < benchmarks.size(); ++i)
+    {
+      if (benchmarks[i]->name() == name_or_index || std::to_string(i) == name_or_index)
+      {
+        return i;
+      }
+    }
+    throw std::runtime_error("no benchmark named " + name_or_index);
+  }
+
+  // parses `Name[flags]=value`, `Name=[v1,v2]` and `Name=[start:end(:stride)]`
+  static axis_override parse_axis(const std::string &spec)
+  {
+    const std::size_t eq = spec.find('=');
+    if (eq == std::string::npos)
+    {
+      throw std::runtime_error("malformed axis: " + spec);
+    }
+
+    axis_override result{spec.substr(0, eq), false, {}};
+
+    const std::size_t flags = result.name.find('[');
+    if (flags != std::string::npos)
+    {
+      const std::string flag = result.name.substr(flags);
+      if (flag != "[pow2]")
+      {
+        throw std::runtime_error("unsupported axis flag: " + flag);
+      }
+      result.power_of_two = true;
+      result.name         = result.name.substr(0, flags);
+    }
+
+    std::string values = spec.substr(eq + 1);
+    if (!values.empty() && values.front() == '[' && values.back() == ']')
+    {
+      values = values.substr(1, values.size() - 2);
+    }
+
+    std::istringstream in(values);
+    std::string token;
+    while (std::getline(in, token, ','))
+    {
+      const std::size_t first = token.find_first_not_of(' ');
+      const std::size_t last  = token.find_last_not_of(' ');
+      if (first != std::string::npos)
+      {
+        result.tokens.push_back(token.substr(first, last - first + 1));
+      }
+    }
+
+    return result;
+  }
+
+  void parse()
+  {
+    for (std::size_t i = 1; i < m_argv.size(); ++i)
+    {
+      const std::string &arg = m_argv[i];
+
+      if (arg == "-b" || arg == "--benchmark")
+      {
+        m_selections.push_back({find_benchmark(next_arg(i)), {}});
+      }
+      else if (arg == "-a" || arg == "--axis")
+      {
+        const axis_override o = parse_axis(next_arg(i));
+        if (m_selections.empty())
+        {
+          m_global_overrides.push_back(o);
+        }
+        else
+        {
+          m_selections.back().overrides.push_back(o);
+        }
+      }
+      else if (arg == "-d" || arg == "--device" || arg == "--devices")
+      {
+        if (next_arg(i) != "0")
+        {
+          throw std::runtime_error("host benchmarks only have device 0");
+        }
+      }
+      else if (arg == "--json")
+      {
+        m_json_path = next_arg(i);
+      }
+      else if (arg == "--jsonbin")
+      {
+        m_json_path = next_arg(i);
+        m_json_bins = true;
+      }
+      else if (arg == "--jsonlist-benches")
+      {
+        m_list_benches = true;
+      }
+      else if (arg == "--jsonlist-devices")
+      {
+        m_list_devices = true;
+      }
+      else if (arg == "-l" || arg == "--list")
+      {
+        m_list = true;
+      }
+      else if (arg == "--min-samples")
+      {
+        m_criteria.min_samples = static_cast<std::size_t>(std::stoull(next_arg(i)));
+      }
+      else if (arg == "--min-time")
+      {
+        m_criteria.min_time = std::stod(next_arg(i));
+      }
+      else if (arg == "--max-noise")
+      {
+        m_criteria.max_noise = std::stod(next_arg(i));
+      }
+      else if (arg == "--timeout")
+      {
+        m_criteria.timeout = std::stod(next_arg(i));
+      }
+      else
+      {
+        throw std::runtime_error("unknown argument: " + arg);
+      }
+    }
+  }
+
+  std::vector<selection> selections() const
+  {
+    std::vector<selection> result = m_selections;
+
+    if (result.empty())
+    {
+      for (std::size_t i = 0; i < registry().size(); ++i)
+      {
+        result.push_back({i, {}});
+      }
+    }
+
+    // overrides given before any -b apply to every benchmark
+    for (selection &sel : result)
+    {
+      sel.overrides.insert(sel.overrides.begin(), m_global_overrides.begin(), m_global_overrides.end());
+    }
+
+    return result;
+  }
+
+  // replaces the values of the overridden axes
+  static std::vector<axis> apply_overrides(std::vector<axis> axes, const std::vector<axis_override> &overrides)
+  {
+    for (const axis_override &o : overrides)
+    {
+      auto a = std::find_if(axes.begin(), axes.end(), [&](const axis &x) {
+        return x.name == o.name;
+      });
+
+      if (a == axes.end())
+      {
+        // like NVBench, global axes need not exist in every benchmark
+        continue;
+      }
+
+      std::vector<axis_value> values;
+
+      for (const std::string &token : o.tokens)
+      {
+        if (a->type == axis::type_axis)
+        {
+          auto v = std::find_if(a->values.begin(), a->values.end(), [&](const axis_value &x) {
+            return x.input_string == token;
+          });
+          if (v == a->values.end())
+          {
+            throw std::runtime_error("no type " + token + " in axis " + a->name);
+          }
+          values.push_back(*v);
+        }
+        else if (a->type == axis::string_axis)
+        {
+          values.push_back({token, "", 0});
+        }
+        else
+        {
+          for (std::int64_t value : expand_int64(token))
+          {
+            if (o.power_of_two)
+            {
+              const std::int64_t power = std::int64_t{1} << value;
+              values.push_back({std::to_string(value), "2^" + std::to_string(value) + " = " + std::to_string(power), power});
+            }
+            else
+            {
+              values.push_back({std::to_string(value), "", value});
+            }
+          }
+        }
+      }
+
+      a->power_of_two = o.power_of_two && a->type == axis::int64_axis;
+      a->values       = values;
+    }
+
+    return axes;
+  }
+
+  static std::vector<std::int64_t> expand_int64(const std::string &token)
+  {
+    std::vector<std::int64_t> parts;
+    std::istringstream in(token);
+    std::string part;
+    while (std::getline(in, part, ':'))
+    {
+      parts.push_back(std::stoll(part));
+    }
+
+    if (parts.size() == 1)
+    {
+      return parts;
+    }
+    return range(parts.at(0), parts.at(1), parts.size() > 2 ? parts[2] : 1);
+  }
+
+  std::string run_benchmark(const selection &sel)
+  {
+    const benchmark &bench = *registry().at(sel.benchmark_index);
+    const std::vector<axis> declared = bench.axes();
+    const std::vector<axis> axes     = apply_overrides(declared, sel.overrides);
+
+    std::vector<state_result> results;
+
+    // odometer over every axis; the type axis is always first
+    std::vector<std::size_t> indices(axes.size(), 0);
+    bool done = std::any_of(axes.begin(), axes.end(), [](const axis &a) {
+      return a.values.empty();
+    });
+
+    while (!done)
+    {
+      results.push_back(run_state(bench, declared, axes, indices));
+
+      done = true;
+      for (std::size_t i = axes.size(); i-- > 0;)
+      {
+        if (++indices[i] < axes[i].values.size())
+        {
+          done = false;
+          break;
+        }
+        indices[i] = 0;
+      }
+    }
+
+    print_markdown(bench, axes, results);
+    return bench_json(bench, sel.benchmark_index, axes, results);
+  }
+
+  state_result run_state(const benchmark &bench,
+                         const std::vector<axis> &declared,
+                         const std::vector<axis> &axes,
+                         const std::vector<std::size_t> &indices)
+  {
+    state s(m_criteria);
+    std::int64_t threads = 1;
+
+    for (std::size_t i = 1; i < axes.size(); ++i)
+    {
+      const axis_value &v = axes[i].values[indices[i]];
+      if (axes[i].type == axis::int64_axis)
+      {
+        s.m_int64_values.emplace_back(axes[i].name, v.value);
+        if (axes[i].name == "Threads")
+        {
+          threads = v.value;
+        }
+      }
+      else
+      {
+        s.m_string_values.emplace_back(axes[i].name, v.input_string);
+      }
+    }
+
+    // map the (possibly restricted) type back to the benchmark's instance
+    const std::string &type = axes[0].values[indices[0]].input_string;
+    const auto &types       = declared[0].values;
+    const std::size_t type_index =
+      std::find_if(types.begin(), types.end(), [&](const axis_value &v) { return v.input_string == type; })
+      - types.begin();
+
+    try
+    {
+      thread_limit limit(threads);
+      bench.run_type(type_index, s);
+    }
+    catch (const std::exception &e)
+    {
+      s.skip(e.what());
+    }
+
+    if (s.skip_reason().empty() && s.samples().empty())
+    {
+      s.skip("the benchmark did not call state.exec");
+    }
+
+    return {type_index, indices, s.samples(), s.mean(), s.noise(), s.elements(), s.bytes(), s.skip_reason()};
+  }
+
+  static void print_markdown(const benchmark &bench, const std::vector<axis> &axes, const std::vector<state_result> &results)
+  {
+    std::ostringstream out;
+    out << "\n## " << bench.name() << " [" << system_name() << "]\n\n|";
+
+    for (const axis &a : axes)
+    {
+      out << " " << a.name << " |";
+    }
+    out << " Samples | CPU Time | Noise | Elem/s | GlobalMem BW |\n|";
+    for (std::size_t i = 0; i < axes.size() + 5; ++i)
+    {
+      out << "---|";
+    }
+    out << "\n";
+
+    for (const state_result &r : results)
+    {
+      out << "|";
+      for (std::size_t i = 0; i < axes.size(); ++i)
+      {
+        const axis_value &v = axes[i].values[r.value_indices[i]];
+        out << " " << (axes[i].power_of_two ? "2^" + v.input_string : v.input_string) << " |";
+      }
+
+      if (!r.skip_reason.empty())
+      {
+        out << " skipped: " << r.skip_reason << " | | | | |\n";
+        continue;
+      }
+
+      char noise[32];
+      std::snprintf(noise, sizeof(noise), "%.2f%%", r.noise);
+
+      out << " " << r.samples.size() << "x | " << format_duration(r.mean) << " | " << noise << " | "
+          << format_rate(static_cast<double>(r.elements) / r.mean, "") << " | "
+          << format_rate(static_cast<double>(r.bytes) / r.mean, "B/s") << " |\n";
+    }
+
+    std::cout << out.str() << std::flush;
+  }
+
+  static std::string axis_json(const axis &a)
+  {
+    std::ostringstream out;
+    out << "{\"name\": " << json_string(a.name) << ", \"type\": "
+        << json_string(a.type == axis::type_axis ? "type" : a.type == axis::int64_axis ? "int64" : "string")
+        << ", \"flags\": " << json_string(a.power_of_two ? "pow2" : "") << ", \"values\": [";
+
+    for (std::size_t i = 0; i < a.values.size(); ++i)
+    {
+      const axis_value &v = a.values[i];
+      out << (i ? ", " : "") << "{\"input_string\": " << json_string(v.input_string)
+          << ", \"description\": " << json_string(v.description);
+      if (a.type == axis::int64_axis)
+      {
+        out << ", \"value\": " << v.value;
+      }
+      else if (a.type == axis::string_axis)
+      {
+        out << ", \"value\": " << json_string(v.input_string);
+      }
+      else
+      {
+        out << ", \"is_active\": true";
+      }
+      out << "}";
+    }
+
+    out << "]}";
+    return out.str();
+  }
+
+  static std::string summary_json(const std::string &tag,
+                                  const std::string &name,
+                                  const std::vector<std::pair<std::string, std::pair<std::string, std::string>>> &data)
+  {
+    std::ostringstream out;
+    out << "{\"tag\": " << json_string(tag) << ", \"name\": " << json_string(name) << ", \"data\": [";
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+      out << (i ? ", " : "") << "{\"name\": " << json_string(data[i].first) << ", \"type\": "
+          << json_string(data[i].second.first) << ", \"value\": " << json_string(data[i].second.second) << "}";
+    }
+    out << "]}";
+    return out.str();
+  }
+
+  static std::string value_summary_json(const std::string &tag, const std::string &name, double value)
+  {
+    return summary_json(tag, name, {{"value", {"float64", to_string(value)}}});
+  }
+
+  std::string bench_json(const benchmark &bench,
+                         std::size_t index,
+                         const std::vector<axis> &axes,
+                         const std::vector<state_result> &results)
+  {
+    std::ostringstream out;
+    out << "{\"name\": " << json_string(bench.name()) << ", \"index\": " << index << ", \"min_samples\": "
+        << m_criteria.min_samples << ", \"min_time\": " << to_string(m_criteria.min_time)
+        << ", \"max_noise\": " << to_string(m_criteria.max_noise) << ", \"timeout\": " << to_string(m_criteria.timeout)
+        << ", \"devices\": [0], \"axes\": [";
+
+    for (std::size_t i = 0; i < axes.size(); ++i)
+    {
+      out << (i ? ", " : "") << axis_json(axes[i]);
+    }
+
+    out << "], \"states\": [";
+
+    for (std::size_t s = 0; s < results.size(); ++s)
+    {
+      const state_result &r = results[s];
+
+      std::string state_name = "Device=0";
+      std::ostringstream axis_values;
+      for (std::size_t i = 0; i < axes.size(); ++i)
+      {
+        const axis_value &v = axes[i].values[r.value_indices[i]];
+        const std::string value =
+          axes[i].type == axis::int64_axis ? std::to_string(v.value) : v.input_string;
+        state_name += " " + axes[i].name + "=" + (axes[i].power_of_two ? "2^" + v.input_string : value);
+
+        axis_values << (i ? ", " : "") << "{\"name\": " << json_string(axes[i].name) << ", \"type\": "
+                    << json_string(axes[i].type == axis::type_axis    ? "type"
+                                   : axes[i].type == axis::int64_axis ? "int64"
+                                                                      : "string")
+                    << ", \"value\": " << json_string(value) << "}";
+      }
+
+      std::vector<std::string> summaries;
+      if (r.skip_reason.empty())
+      {
+        summaries.push_back(value_summary_json("nv/cold/time/cpu/mean", "CPU Time", r.mean));
+        summaries.push_back(value_summary_json("nv/cold/time/cpu/stdev/relative", "Noise", r.noise / 100.0));
+        summaries.push_back(summary_json("nv/cold/sample_size", "Samples",
+                                         {{"value", {"int64", std::to_string(r.samples.size())}}}));
+        summaries.push_back(value_summary_json("nv/cold/bw/item_rate", "Elem/s", static_cast<double>(r.elements) / r.mean));
+        summaries.push_back(
+          value_summary_json("nv/cold/bw/global/bytes_per_second", "GlobalMem BW", static_cast<double>(r.bytes) / r.mean));
+
+        if (m_json_bins)
+        {
+          summaries.push_back(summary_json("nv/json/bin:nv/cold/sample_times", "Samples Times File",
+                                           {{"filename", {"string", write_samples(r.samples)}},
+                                            {"size", {"int64", std::to_string(r.samples.size())}}}));
+        }
+      }
+
+      out << (s ? ", " : "") << "{\"name\": " << json_string(state_name)
+          << ", \"device\": 0, \"type_config_index\": " << r.type_index << ", \"axis_values\": ["
+          << axis_values.str() << "], \"summaries\": [";
+      for (std::size_t i = 0; i < summaries.size(); ++i)
+      {
+        out << (i ? ", " : "") << summaries[i];
+      }
+      out << "], \"is_skipped\": " << (r.skip_reason.empty() ? "false" : "true")
+          << ", \"skip_reason\": " << json_string(r.skip_reason) << "}";
+    }
+
+    out << "]}";
+    return out.str();
+  }
+
+  // samples are stored next to the JSON file as little-endian float32
+  std::string write_samples(const std::vector<float> &samples)
+  {
+    const std::string dir = m_json_path + "-bin";
+    ::mkdir(dir.c_str(), 0755);
+
+    const std::string filename = dir + "/" + std::to_string(m_sample_files++) + ".bin";
+    std::ofstream out(filename, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(samples.data()),
+              static_cast<std::streamsize>(samples.size() * sizeof(float)));
+
+    if (!out)
+    {
+      throw std::runtime_error("unable to write " + filename);
+    }
+    return filename;
+  }
+
+  std::string device_json() const
+  {
+    std::ostringstream out;
+    out << "{\"id\": 0, \"name\": " << json_string(cpu_name() + " [" + system_name() + "]")
+        << ", \"global_memory_bus_width\": 0, \"number_of_sms\": " << hardware_threads()
+        << ", \"ecc_state\": false}";
+    return out.str();
+  }
+
+  void write_json(const std::vector<std::string> &bench_jsons) const
+  {
+    std::ofstream out(m_json_path);
+
+    out << "{\n  \"meta\": {\"argv\": [";
+    for (std::size_t i = 0; i < m_argv.size(); ++i)
+    {
+      out << (i ? ", " : "") << json_string(m_argv[i]);
+    }
+    out << "]},\n  \"devices\": [" << device_json() << "],\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < bench_jsons.size(); ++i)
+    {
+      out << (i ? ",\n    " : "    ") << bench_jsons[i];
+    }
+    out << "\n  ]\n}\n";
+
+    if (!out)
+    {
+      throw std::runtime_error("unable to write " + m_json_path);
+    }
+  }
+
+  void print_bench_list() const
+  {
+    std::cout << "{\n  \"benchmarks\": [\n";
+    const auto &benchmarks = registry();
+    for (std::size_t b = 0; b < benchmarks.size(); ++b)
+    {
+      const std::vector<axis> axes = benchmarks[b]->axes();
+
+      std::cout << (b ? ",\n    " : "    ") << "{\"name\": " << json_string(benchmarks[b]->name())
+                << ", \"index\": " << b << ", \"axes\": [";
+      for (std::size_t i = 0; i < axes.size(); ++i)
+      {
+        std::cout << (i ? ", " : "") << axis_json(axes[i]);
+      }
+      std::cout << "], \"states\": []}";
+    }
+    std::cout << "\n  ]\n}\n";
+  }
+
+  void print_human_list() const
+  {
+    const auto &benchmarks = registry();
+    for (std::size_t b = 0; b < benchmarks.size(); ++b)
+    {
+      std::cout << b << ": " << benchmarks[b]->name() << " [" << system_name() << "]\n";
+      for (const axis &a : benchmarks[b]->axes())
+      {
+        std::cout << "  " << a.full_name() << ":";
+        for (const axis_value &v : a.values)
+        {
+          std::cout << " " << v.input_string;
+        }
+        std::cout << "\n";
+      }
+    }
+  }
+
+  std::vector<std::string> m_argv;
+  criteria m_criteria;
+  std::vector<selection> m_selections;
+  std::vector<axis_override> m_global_overrides;
+  std::string m_json_path;
+  bool m_json_bins    = false;
+  bool m_list_benches = false;
+  bool m_list_devices = false;
+  bool m_list         = false;
+  std::size_t m_sample_files = 0;
+};
+
+} // namespace host_bench
+
+
+int main(int argc, char **argv)
+{
+  return host_bench::runner(argc, argv).run();
+}
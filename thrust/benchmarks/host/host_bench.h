@@ -0,0 +1,423 @@
+/******************************************************************************
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+// A CPU benchmark harness for the CPP, OMP and TBB systems.
+//
+// Benchmarks are written against a subset of the NVBench API, and the
+// executables accept NVBench's command line (`-b`, `-a`, `--json`,
+// `--jsonbin`, `--jsonlist-benches`, `--jsonlist-devices`, ...) and emit its
+// JSON layout, so that `benchmarks/scripts` can run and analyze them the same
+// way as the CUDA benchmarks. Every benchmark gets a `Threads` axis on top of
+// the axes it declares.
+
+#include <thrust/detail/config.h>
+
+#include <thrust/random.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_CPP
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/cpp/vector.h>
+#define HOST_BENCH_SYSTEM cpp
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/omp/vector.h>
+#define HOST_BENCH_SYSTEM omp
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+#include <thrust/system/tbb/execution_policy.h>
+#include <thrust/system/tbb/vector.h>
+#define HOST_BENCH_SYSTEM tbb
+#else
+#error "host benchmarks measure the CPP, OMP and TBB systems"
+#endif
+
+#define HOST_BENCH_STRINGIZE_IMPL(x) #x
+#define HOST_BENCH_STRINGIZE(x) HOST_BENCH_STRINGIZE_IMPL(x)
+#define HOST_BENCH_CONCAT_IMPL(x, y) x##y
+#define HOST_BENCH_CONCAT(x, y) HOST_BENCH_CONCAT_IMPL(x, y)
+
+namespace host_bench
+{
+
+// the system under test is the one Thrust was configured with as its device
+static const auto &policy = thrust::HOST_BENCH_SYSTEM::par;
+
+template <typename T>
+using vector = thrust::HOST_BENCH_SYSTEM::vector<T>;
+
+inline const char *system_name()
+{
+  return HOST_BENCH_STRINGIZE(HOST_BENCH_SYSTEM);
+}
+
+template <typename... Ts>
+struct type_list
+{};
+
+using fundamental_types = type_list<std::int8_t, std::int16_t, std::int32_t, std::int64_t, float, double>;
+using integral_types    = type_list<std::int8_t, std::int16_t, std::int32_t, std::int64_t>;
+
+// type names match NVBench's so that results line up with the CUDA benchmarks
+template <typename T>
+struct type_strings;
+
+#define HOST_BENCH_DECLARE_TYPE_STRINGS(T, input, desc)   \
+  template <>                                             \
+  struct type_strings<T>                                  \
+  {                                                       \
+    static std::string input_string() { return input; }   \
+    static std::string description() { return desc; }    \
+  }
+
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::int8_t, "I8", "int8_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::int16_t, "I16", "int16_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::int32_t, "I32", "int32_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::int64_t, "I64", "int64_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::uint8_t, "U8", "uint8_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::uint16_t, "U16", "uint16_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::uint32_t, "U32", "uint32_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(std::uint64_t, "U64", "uint64_t");
+HOST_BENCH_DECLARE_TYPE_STRINGS(float, "F32", "float");
+HOST_BENCH_DECLARE_TYPE_STRINGS(double, "F64", "double");
+
+std::vector<std::int64_t> range(std::int64_t start, std::int64_t end, std::int64_t stride = 1);
+
+
+struct axis_value
+{
+  std::string input_string;
+  std::string description;
+  std::int64_t value; // only meaningful for int64 axes
+};
+
+struct axis
+{
+  enum axis_type
+  {
+    type_axis,
+    int64_axis,
+    string_axis
+  };
+
+  std::string name;
+  axis_type type;
+  bool power_of_two;
+  std::vector<axis_value> values;
+
+  // the name as written in JSON and on the command line, e.g. `Elements[pow2]`
+  std::string full_name() const { return power_of_two ? name + "[pow2]" : name; }
+};
+
+
+struct criteria
+{
+  std::size_t min_samples = 10;
+  double min_time         = 0.5;  // seconds
+  double max_noise        = 0.5;  // percent relative standard deviation
+  double timeout          = 15.0; // seconds
+};
+
+
+class timer
+{
+public:
+  void start() { m_begin = clock::now(); }
+  void stop() { m_end = clock::now(); }
+
+  double get_duration() const { return std::chrono::duration<double>(m_end - m_begin).count(); }
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  clock::time_point m_begin;
+  clock::time_point m_end;
+};
+
+
+namespace exec_tag
+{
+
+struct timer_t
+{};
+
+// the launcher starts and stops a timer around the measured region itself
+constexpr timer_t timer{};
+
+} // namespace exec_tag
+
+
+class state
+{
+public:
+  explicit state(const criteria &c)
+      : m_criteria(c)
+  {}
+
+  std::int64_t get_int64(const std::string &name) const;
+  const std::string &get_string(const std::string &name) const;
+
+  void add_element_count(std::size_t elements) { m_elements += elements; }
+
+  template <typename T>
+  void add_global_memory_reads(std::size_t count)
+  {
+    m_bytes += count * sizeof(T);
+  }
+
+  template <typename T>
+  void add_global_memory_writes(std::size_t count)
+  {
+    m_bytes += count * sizeof(T);
+  }
+
+  void skip(const std::string &reason) { m_skip_reason = reason; }
+
+  template <typename Launcher>
+  void exec(Launcher &&launcher)
+  {
+    exec(exec_tag::timer, [&](timer &t) {
+      t.start();
+      launcher();
+      t.stop();
+    });
+  }
+
+  template <typename Launcher>
+  void exec(exec_tag::timer_t, Launcher &&launcher)
+  {
+    timer t;
+
+    // warm up caches, fault in pages and spin up the thread pool
+    launcher(t);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (;;)
+    {
+      launcher(t);
+      add_sample(t.get_duration());
+
+      const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      if (elapsed >= m_criteria.timeout)
+      {
+        break;
+      }
+
+      if (m_samples.size() >= m_criteria.min_samples && elapsed >= m_criteria.min_time
+          && noise() <= m_criteria.max_noise)
+      {
+        break;
+      }
+    }
+  }
+
+  // results
+  const std::vector<float> &samples() const { return m_samples; }
+  double mean() const;
+  double noise() const;
+  std::size_t elements() const { return m_elements; }
+  std::size_t bytes() const { return m_bytes; }
+  const std::string &skip_reason() const { return m_skip_reason; }
+
+private:
+  friend class runner;
+
+  void add_sample(double seconds);
+
+  criteria m_criteria;
+  std::vector<std::pair<std::string, std::int64_t>> m_int64_values;
+  std::vector<std::pair<std::string, std::string>> m_string_values;
+
+  std::vector<float> m_samples;
+  double m_sum         = 0;
+  double m_sum_squares = 0;
+  std::size_t m_elements{};
+  std::size_t m_bytes{};
+  std::string m_skip_reason;
+};
+
+
+class benchmark
+{
+public:
+  using instance = std::function<void(state &)>;
+
+  benchmark &set_name(std::string name);
+  benchmark &set_type_axes_names(std::vector<std::string> names);
+  benchmark &add_int64_axis(std::string name, std::vector<std::int64_t> values);
+  benchmark &add_int64_power_of_two_axis(std::string name, std::vector<std::int64_t> exponents);
+  benchmark &add_string_axis(std::string name, std::vector<std::string> values);
+
+  void add_type(std::string input_string, std::string description, instance run);
+
+  const std::string &name() const { return m_name; }
+
+  // the type axis, then the declared axes, then Threads
+  std::vector<axis> axes() const;
+
+  void run_type(std::size_t type_index, state &s) const { m_instances[type_index](s); }
+
+private:
+  std::string m_name;
+  axis m_type_axis{"T", axis::type_axis, false, {}};
+  std::vector<axis> m_axes;
+  std::vector<instance> m_instances;
+};
+
+
+std::vector<std::unique_ptr<benchmark>> &registry();
+
+benchmark &add_benchmark();
+
+
+namespace detail
+{
+
+template <typename Fn>
+void add_types(benchmark &, Fn, type_list<>)
+{}
+
+template <typename Fn, typename T, typename... Ts>
+void add_types(benchmark &b, Fn fn, type_list<T, Ts...>)
+{
+  b.add_type(type_strings<T>::input_string(), type_strings<T>::description(), [fn](state &s) {
+    fn(s, type_list<T>{});
+  });
+  add_types(b, fn, type_list<Ts...>{});
+}
+
+} // namespace detail
+
+template <typename Fn, typename... Ts>
+benchmark &make_benchmark(Fn fn, type_list<Ts...> types)
+{
+  benchmark &b = add_benchmark();
+  detail::add_types(b, fn, types);
+  return b;
+}
+
+#define HOST_BENCH_TYPES(fn, types)                                                 \
+  static ::host_bench::benchmark &HOST_BENCH_CONCAT(host_bench_registration_, __LINE__) = \
+    ::host_bench::make_benchmark([](::host_bench::state &s, auto tl) { fn(s, tl); }, types{})
+
+
+template <typename T>
+void do_not_optimize(T const &value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+
+// input generation; a fixed seed keeps every run on the same data
+//
+// entropy is one of "1.000", "0.811", "0.544", "0.337", "0.201" or "0.000";
+// values of lower entropy AND together more random words, as NVBench does
+
+// the fraction of the value range selected by predicate benchmarks
+double entropy_to_probability(const std::string &entropy);
+
+namespace detail
+{
+
+int entropy_to_and_count(const std::string &entropy);
+
+template <typename T>
+T random_value(thrust::default_random_engine &rng, int and_count, std::true_type /* integral */)
+{
+  using unsigned_t = typename std::make_unsigned<T>::type;
+  thrust::uniform_int_distribution<std::uint64_t> dist;
+
+  std::uint64_t bits = and_count == 0 ? 0 : ~std::uint64_t{};
+  for (int i = 0; i < and_count; ++i)
+  {
+    bits &= dist(rng);
+  }
+
+  return static_cast<T>(static_cast<unsigned_t>(bits));
+}
+
+template <typename T>
+T random_value(thrust::default_random_engine &rng, int and_count, std::false_type /* integral */)
+{
+  // quantize through an integer so that entropy has the same meaning
+  const auto bits = random_value<std::uint32_t>(rng, and_count, std::true_type{});
+  return static_cast<T>(bits) / static_cast<T>(std::numeric_limits<std::uint32_t>::max());
+}
+
+} // namespace detail
+
+template <typename T>
+vector<T> generate(std::size_t elements, const std::string &entropy = "1.000")
+{
+  thrust::default_random_engine rng(42);
+  const int and_count = detail::entropy_to_and_count(entropy);
+
+  std::vector<T> values(elements);
+  for (T &value : values)
+  {
+    value = detail::random_value<T>(rng, and_count, std::is_integral<T>{});
+  }
+
+  return vector<T>(values.begin(), values.end());
+}
+
+// runs of equal keys whose lengths are uniform in [min_segment_size, max_segment_size]
+template <typename T>
+vector<T> generate_key_segments(std::size_t elements, std::size_t min_segment_size, std::size_t max_segment_size)
+{
+  thrust::default_random_engine rng(42);
+  thrust::uniform_int_distribution<std::size_t> segment_size(min_segment_size, max_segment_size);
+
+  std::vector<T> values(elements);
+  std::size_t key = 0;
+  for (std::size_t i = 0; i < elements; ++key)
+  {
+    const std::size_t end = (std::min)(elements, i + segment_size(rng));
+    for (; i < end; ++i)
+    {
+      values[i] = static_cast<T>(key);
+    }
+  }
+
+  return vector<T>(values.begin(), values.end());
+}
+
+} // namespace host_bench
@@ -2,7 +2,8 @@
 // elements of a device_vector. For example, the default behavior of
 // zero-initializing numeric data may introduce undesirable overhead.
 // This example demonstrates how to avoid default construction of a
-// device_vector's data by using a custom allocator.
+// device_vector's data, by passing thrust::no_init to its constructor and
+// resize, or by using a custom allocator.
 
 #include <thrust/device_allocator.h>
 #include <thrust/device_vector.h>
@@ -58,6 +59,17 @@ typedef thrust::device_vector<float, uninitialized_allocator<float> > uninitiali
 
 int main()
 {
+  // thrust::no_init leaves the elements of a vector with a trivially
+  // constructible element type uninitialized, without a custom allocator
+  thrust::device_vector<float> no_init_vec(10, thrust::no_init);
+
+  // the initial value of no_init_vec's 10 elements is undefined
+
+  // resize with thrust::no_init does not initialize the new elements
+  no_init_vec.resize(20, thrust::no_init);
+
+  // alternatively, an allocator with a no-op construct never initializes
+  // elements that aren't given a value
   uninitialized_vector vec(10);
 
   // the initial value of vec's 10 elements is undefined
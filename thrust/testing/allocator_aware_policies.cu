@@ -128,11 +128,11 @@ typedef policy_info<
 > cpp_par_info;
 typedef policy_info<
     thrust::system::omp::detail::par_t,
-    thrust::system::omp::detail::execution_policy
+    thrust::system::omp::detail::execute_with_tuning_base
 > omp_par_info;
 typedef policy_info<
     thrust::system::tbb::detail::par_t,
-    thrust::system::tbb::detail::execution_policy
+    thrust::system::tbb::detail::execute_with_tuning_base
 > tbb_par_info;
 
 #if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_CUDA
@@ -7,6 +7,8 @@
 #include <thrust/iterator/discard_iterator.h>
 #include <thrust/iterator/retag.h>
 
+#include <vector>
+
 
 //////////////////////
 // Vector Functions //
@@ -393,6 +395,42 @@ struct TestVectorBinarySearch
 };
 VariableUnitTest<TestVectorBinarySearch, SignedIntegralTypes> TestVectorBinarySearchInstance;
 
+template <typename T>
+struct TestVectorSearchSortedValues
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T>   h_vec = unittest::random_integers<T>(n); thrust::sort(h_vec.begin(), h_vec.end());
+    thrust::device_vector<T> d_vec = h_vec;
+
+    // sorted values are searched for differently than unsorted ones
+    thrust::host_vector<T>   h_input = unittest::random_integers<T>(2*n); thrust::sort(h_input.begin(), h_input.end());
+    thrust::device_vector<T> d_input = h_input;
+
+    typedef typename thrust::host_vector<T>::difference_type int_type;
+    thrust::host_vector<int_type> lower(2*n), upper(2*n), found(2*n);
+
+    for(size_t i = 0; i < 2*n; i++)
+    {
+      lower[i] = thrust::lower_bound(h_vec.begin(), h_vec.end(), h_input[i]) - h_vec.begin();
+      upper[i] = thrust::upper_bound(h_vec.begin(), h_vec.end(), h_input[i]) - h_vec.begin();
+      found[i] = thrust::binary_search(h_vec.begin(), h_vec.end(), h_input[i]);
+    }
+
+    thrust::device_vector<int_type> d_output(2*n);
+
+    thrust::lower_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+    ASSERT_EQUAL(lower, d_output);
+
+    thrust::upper_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+    ASSERT_EQUAL(upper, d_output);
+
+    thrust::binary_search(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+    ASSERT_EQUAL(found, d_output);
+  }
+};
+VariableUnitTest<TestVectorSearchSortedValues, SignedIntegralTypes> TestVectorSearchSortedValuesInstance;
+
 template <typename T>
 struct TestVectorLowerBoundDiscardIterator
 {
@@ -466,3 +504,65 @@ struct TestVectorBinarySearchDiscardIterator
 };
 VariableUnitTest<TestVectorBinarySearchDiscardIterator, SignedIntegralTypes> TestVectorBinarySearchDiscardIteratorInstance;
 
+
+// the values searched for are neither default constructible nor comparable with each other
+struct search_key
+{
+  __host__ __device__
+  explicit search_key(int key) : key(key) {}
+
+  int key;
+};
+
+struct search_key_less
+{
+  __host__ __device__
+  bool operator()(int x, const search_key &value) const
+  {
+    return x < value.key;
+  }
+
+  __host__ __device__
+  bool operator()(const search_key &value, int x) const
+  {
+    return value.key < x;
+  }
+};
+
+void TestVectorSearchHeterogeneousValues(const size_t n)
+{
+  thrust::host_vector<int>   h_vec = unittest::random_integers<int>(n); thrust::sort(h_vec.begin(), h_vec.end());
+  thrust::device_vector<int> d_vec = h_vec;
+
+  // a tile of sorted values followed by unsorted ones
+  thrust::host_vector<int> h_keys = unittest::random_integers<int>(2*n);
+  thrust::sort(h_keys.begin(), h_keys.begin() + n);
+
+  std::vector<search_key> h_input;
+  for(size_t i = 0; i < 2*n; i++)
+  {
+    h_input.push_back(search_key(h_keys[i]));
+  }
+  thrust::device_vector<search_key> d_input(h_input.begin(), h_input.end());
+
+  thrust::host_vector<std::ptrdiff_t> lower(2*n), upper(2*n), found(2*n);
+
+  for(size_t i = 0; i < 2*n; i++)
+  {
+    lower[i] = thrust::lower_bound(h_vec.begin(), h_vec.end(), h_keys[i]) - h_vec.begin();
+    upper[i] = thrust::upper_bound(h_vec.begin(), h_vec.end(), h_keys[i]) - h_vec.begin();
+    found[i] = thrust::binary_search(h_vec.begin(), h_vec.end(), h_keys[i]);
+  }
+
+  thrust::device_vector<std::ptrdiff_t> d_output(2*n);
+
+  thrust::lower_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin(), search_key_less());
+  ASSERT_EQUAL(lower, d_output);
+
+  thrust::upper_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin(), search_key_less());
+  ASSERT_EQUAL(upper, d_output);
+
+  thrust::binary_search(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin(), search_key_less());
+  ASSERT_EQUAL(found, d_output);
+}
+DECLARE_SIZED_UNITTEST(TestVectorSearchHeterogeneousValues);
@@ -4,6 +4,9 @@
 #include <thrust/mr/disjoint_pool.h>
 #include <thrust/mr/new.h>
 
+#include <new>
+#include <vector>
+
 #if THRUST_CPP_DIALECT >= 2011
 #include <thrust/mr/disjoint_sync_pool.h>
 #endif
@@ -274,6 +277,312 @@ void TestDisjointSynchronizedPoolCachingOversized()
 DECLARE_UNITTEST(TestDisjointSynchronizedPoolCachingOversized);
 #endif
 
+template<template<typename, typename> class PoolTemplate>
+void TestDisjointPoolManyOversized()
+{
+    dummy_resource upstream;
+    thrust::mr::new_delete_resource bookkeeper;
+
+    typedef PoolTemplate<
+        dummy_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = false;
+    opts.largest_block_size = 1024;
+
+    Pool pool(&upstream, &bookkeeper, opts);
+
+    const std::size_t n = 1000;
+    std::vector<alloc_id> blocks(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        upstream.id_to_allocate = i + 1;
+        blocks[i] = pool.do_allocate(2048 + i, 32 << (i % 4));
+        ASSERT_EQUAL(blocks[i].id, i + 1);
+    }
+
+    // free the blocks out of order, with more allocations in between; upstream checks that each block is
+    // returned with the size and alignment it was allocated with
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::size_t j = (i * 7919) % n;
+
+        upstream.id_to_deallocate = blocks[j].id;
+        pool.do_deallocate(blocks[j], 2048 + j, 32 << (j % 4));
+
+        if (i % 2 == 0)
+        {
+            upstream.id_to_allocate = n + i + 1;
+            alloc_id extra = pool.do_allocate(4096 + i, 64);
+
+            upstream.id_to_deallocate = extra.id;
+            pool.do_deallocate(extra, 4096 + i, 64);
+        }
+    }
+}
+
+void TestDisjointUnsynchronizedPoolManyOversized()
+{
+    TestDisjointPoolManyOversized<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolManyOversized);
+
+// a bookkeeper that can be made to run out of memory
+class failing_resource final : public thrust::mr::memory_resource<>
+{
+public:
+    failing_resource() : fail(false)
+    {
+    }
+
+    virtual void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (fail)
+        {
+            throw std::bad_alloc();
+        }
+
+        return upstream.do_allocate(bytes, alignment);
+    }
+
+    virtual void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+    {
+        upstream.do_deallocate(p, bytes, alignment);
+    }
+
+    thrust::mr::new_delete_resource upstream;
+    bool fail;
+};
+
+void TestDisjointPoolOversizedIndexGrowthFailure()
+{
+    dummy_resource upstream;
+    failing_resource bookkeeper;
+
+    typedef thrust::mr::disjoint_unsynchronized_pool_resource<
+        dummy_resource,
+        failing_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = false;
+    opts.largest_block_size = 1024;
+
+    Pool pool(&upstream, &bookkeeper, opts);
+
+    // the index of the first blocks has room for 8 of them
+    const std::size_t n = 8;
+    std::vector<alloc_id> blocks(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        upstream.id_to_allocate = i + 1;
+        blocks[i] = pool.do_allocate(2048 + i, 32);
+    }
+
+    // growing the index fails before upstream is asked for the block, which dummy_resource would reject
+    bookkeeper.fail = true;
+
+    bool thrown = false;
+    try
+    {
+        alloc_id unexpected = pool.do_allocate(4096, 32);
+        (void) unexpected;
+    }
+    catch (const std::bad_alloc &)
+    {
+        thrown = true;
+    }
+    ASSERT_EQUAL(thrown, true);
+
+    bookkeeper.fail = false;
+
+    // the blocks allocated before are still found
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        upstream.id_to_deallocate = blocks[i].id;
+        pool.do_deallocate(blocks[i], 2048 + i, 32);
+        ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+    }
+
+    upstream.id_to_allocate = n + 1;
+    alloc_id block = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(block.id, n + 1);
+
+    upstream.id_to_deallocate = block.id;
+    pool.do_deallocate(block, 4096, 32);
+}
+DECLARE_UNITTEST(TestDisjointPoolOversizedIndexGrowthFailure);
+
+template<template<typename, typename> class PoolTemplate>
+void TestDisjointPoolTrimOversized()
+{
+    dummy_resource upstream;
+    thrust::mr::new_delete_resource bookkeeper;
+
+    typedef PoolTemplate<
+        dummy_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+
+    Pool pool(&upstream, &bookkeeper, opts);
+
+    upstream.id_to_allocate = 1;
+    alloc_id a1 = pool.do_allocate(2048, 32);
+    upstream.id_to_allocate = 2;
+    alloc_id a2 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    pool.do_deallocate(a1, 2048, 32);
+    pool.do_deallocate(a2, 4096, 32);
+    ASSERT_EQUAL(pool.cached_bytes(), 2048u + 4096u);
+
+    // the least recently cached block is returned first
+    upstream.id_to_deallocate = 1;
+    pool.trim(4096);
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+    ASSERT_EQUAL(pool.cached_bytes(), 4096u);
+
+    upstream.id_to_deallocate = 2;
+    pool.trim();
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    // and returned blocks aren't handed out anymore
+    upstream.id_to_allocate = 3;
+    alloc_id a3 = pool.do_allocate(2048, 32);
+    ASSERT_EQUAL(a3.id, 3u);
+
+    // with a limit, caching a block returns the least recently cached ones, until three quarters of the limit are left
+    opts.max_cached_bytes = 8192;
+    Pool limited(&upstream, &bookkeeper, opts);
+
+    upstream.id_to_allocate = 4;
+    alloc_id a4 = limited.do_allocate(2048, 32);
+    upstream.id_to_allocate = 5;
+    alloc_id a5 = limited.do_allocate(4096, 32);
+    upstream.id_to_allocate = 6;
+    alloc_id a6 = limited.do_allocate(4096, 32);
+
+    limited.do_deallocate(a4, 2048, 32);
+    limited.do_deallocate(a5, 4096, 32);
+    ASSERT_EQUAL(limited.cached_bytes(), 2048u + 4096u);
+
+    upstream.id_to_deallocate = 4;
+    limited.do_deallocate(a6, 4096, 32);
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+    ASSERT_EQUAL(limited.cached_bytes(), 4096u);
+
+    // the most recently cached block is the one left
+    alloc_id a7 = limited.do_allocate(4096, 32);
+    ASSERT_EQUAL(a7.id, 6u);
+    limited.do_deallocate(a7, 4096, 32);
+}
+
+void TestDisjointUnsynchronizedPoolTrimOversized()
+{
+    TestDisjointPoolTrimOversized<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolTrimOversized);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestDisjointSynchronizedPoolTrimOversized()
+{
+    TestDisjointPoolTrimOversized<thrust::mr::disjoint_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolTrimOversized);
+#endif
+
+template<template<typename, typename> class PoolTemplate>
+void TestDisjointPoolTrimChunks()
+{
+    thrust::mr::new_delete_resource upstream;
+    thrust::mr::new_delete_resource bookkeeper;
+
+    typedef PoolTemplate<
+        thrust::mr::new_delete_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+
+    Pool pool(&upstream, &bookkeeper, opts);
+
+    // chunks of 16 blocks of 256 bytes, and of 64 blocks of 16 bytes
+    void * a1 = pool.do_allocate(16);
+    void * a2 = pool.do_allocate(16);
+    void * a3 = pool.do_allocate(256);
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    pool.do_deallocate(a3, 256);
+    ASSERT_EQUAL(pool.cached_bytes(), 4096u);
+
+    pool.do_deallocate(a1, 16);
+    ASSERT_EQUAL(pool.cached_bytes(), 4096u);
+    pool.do_deallocate(a2, 16);
+    ASSERT_EQUAL(pool.cached_bytes(), 4096u + 1024u);
+
+    // the chunk that became idle first is returned first
+    pool.trim(1024);
+    ASSERT_EQUAL(pool.cached_bytes(), 1024u);
+
+    a1 = pool.do_allocate(16);
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+    pool.do_deallocate(a1, 16);
+
+    pool.trim();
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    // new chunks are allocated after the old ones are gone
+    std::vector<void *> blocks;
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        blocks.push_back(pool.do_allocate(256));
+    }
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+        pool.do_deallocate(blocks[i], 256);
+    }
+    ASSERT_EQUAL(pool.cached_bytes() >= 100u * 256u, true);
+
+    pool.trim();
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    // without room for idle memory, a chunk is returned as soon as it becomes idle
+    opts.max_cached_bytes = 0;
+    Pool limited(&upstream, &bookkeeper, opts);
+
+    void * a4 = limited.do_allocate(16);
+    void * a5 = limited.do_allocate(16);
+    limited.do_deallocate(a4, 16);
+    ASSERT_EQUAL(limited.cached_bytes(), 0u);
+    limited.do_deallocate(a5, 16);
+    ASSERT_EQUAL(limited.cached_bytes(), 0u);
+}
+
+void TestDisjointUnsynchronizedPoolTrimChunks()
+{
+    TestDisjointPoolTrimChunks<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolTrimChunks);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestDisjointSynchronizedPoolTrimChunks()
+{
+    TestDisjointPoolTrimChunks<thrust::mr::disjoint_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolTrimChunks);
+#endif
+
 template<template<typename, typename> class PoolTemplate>
 void TestDisjointGlobalPool()
 {
@@ -0,0 +1,110 @@
+#include <unittest/unittest.h>
+
+#include <thrust/host_vector.h>
+#include <thrust/mr/host_temporary_cache.h>
+#include <thrust/sort.h>
+
+#include <algorithm>
+
+void TestHostTemporaryCacheSizeClasses()
+{
+    typedef thrust::detail::host_temporary_cache cache;
+
+    ASSERT_EQUAL(cache::size_class(1), 256u);
+    ASSERT_EQUAL(cache::size_class(256), 256u);
+    ASSERT_EQUAL(cache::size_class(257), 320u);
+    ASSERT_EQUAL(cache::size_class(1024), 1024u);
+    ASSERT_EQUAL(cache::size_class(1025), 1280u);
+    ASSERT_EQUAL(cache::size_class(1500), 1536u);
+}
+DECLARE_UNITTEST(TestHostTemporaryCacheSizeClasses);
+
+void TestHostTemporaryCache()
+{
+    bool was_enabled = thrust::mr::host_temporary_cache_enabled();
+    thrust::detail::host_temporary_cache & cache = thrust::detail::host_temporary_cache::thread_instance();
+
+    thrust::mr::release_host_temporary_cache();
+    thrust::mr::enable_host_temporary_cache();
+
+    thrust::host_vector<int> h_data = unittest::random_integers<int>(10000);
+    thrust::host_vector<int> h_expected = h_data;
+    std::stable_sort(h_expected.begin(), h_expected.end());
+
+    // the temporary storage of the first sort stays cached...
+    thrust::host_vector<int> h_sorted = h_data;
+    thrust::stable_sort(thrust::host, h_sorted.begin(), h_sorted.end());
+    ASSERT_EQUAL(h_sorted, h_expected);
+
+    std::size_t cached = cache.cached_bytes();
+    ASSERT_EQUAL(cached > 0, true);
+
+    // ...and is reused by the second one
+    h_sorted = h_data;
+    thrust::stable_sort(thrust::host, h_sorted.begin(), h_sorted.end());
+    ASSERT_EQUAL(h_sorted, h_expected);
+    ASSERT_EQUAL(cache.cached_bytes(), cached);
+
+    thrust::mr::release_host_temporary_cache();
+    ASSERT_EQUAL(cache.cached_bytes(), 0u);
+
+    // nothing is cached while disabled
+    thrust::mr::enable_host_temporary_cache(false);
+
+    h_sorted = h_data;
+    thrust::stable_sort(thrust::host, h_sorted.begin(), h_sorted.end());
+    ASSERT_EQUAL(h_sorted, h_expected);
+    ASSERT_EQUAL(cache.cached_bytes(), 0u);
+
+    thrust::mr::enable_host_temporary_cache(was_enabled);
+}
+DECLARE_UNITTEST(TestHostTemporaryCache);
+
+void TestHostTemporaryCacheToggledWhileInUse()
+{
+    typedef thrust::detail::host_temporary_cache cache_type;
+
+    bool was_enabled = thrust::mr::host_temporary_cache_enabled();
+    cache_type & cache = cache_type::thread_instance();
+
+    thrust::mr::release_host_temporary_cache();
+
+    // a block allocated while the cache is disabled is not kept when it's returned after enabling it...
+    thrust::mr::enable_host_temporary_cache(false);
+    void * uncached = cache.allocate(1000);
+    ASSERT_EQUAL(uncached != 0, true);
+
+    thrust::mr::enable_host_temporary_cache();
+    void * cached = cache.allocate(1000);
+    ASSERT_EQUAL(cached != 0, true);
+
+    cache.deallocate(uncached);
+    ASSERT_EQUAL(cache.cached_bytes(), 0u);
+
+    // ...and one allocated while it's enabled is freed when it's returned after disabling it
+    thrust::mr::enable_host_temporary_cache(false);
+    cache.deallocate(cached);
+    ASSERT_EQUAL(cache.cached_bytes(), 0u);
+
+    // blocks returned while enabled are reused for requests of the same size class
+    thrust::mr::enable_host_temporary_cache();
+    void * first = cache.allocate(1000);
+    cache.deallocate(first);
+    ASSERT_EQUAL(cache.cached_bytes() >= 1000u, true);
+
+    thrust::mr::enable_host_temporary_cache(false);
+    void * second = cache.allocate(1000);
+    ASSERT_EQUAL(cache.cached_bytes() >= 1000u, true);
+
+    thrust::mr::enable_host_temporary_cache();
+    void * third = cache.allocate(1000);
+    ASSERT_EQUAL(third, first);
+    ASSERT_EQUAL(cache.cached_bytes(), 0u);
+
+    cache.deallocate(second);
+    cache.deallocate(third);
+
+    thrust::mr::release_host_temporary_cache();
+    thrust::mr::enable_host_temporary_cache(was_enabled);
+}
+DECLARE_UNITTEST(TestHostTemporaryCacheToggledWhileInUse);
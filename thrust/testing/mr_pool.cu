@@ -4,8 +4,13 @@
 #include <thrust/mr/pool.h>
 #include <thrust/mr/new.h>
 
+#include <vector>
+
 #if THRUST_CPP_DIALECT >= 2011
 #include <thrust/mr/sync_pool.h>
+#include <thrust/mr/concurrent_pool.h>
+
+#include <thread>
 #endif
 
 template<typename T>
@@ -249,6 +254,12 @@ void TestSynchronizedPool()
     TestPool<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedPool);
+
+void TestConcurrentPool()
+{
+    TestPool<thrust::mr::concurrent_pool_resource>();
+}
+DECLARE_UNITTEST(TestConcurrentPool);
 #endif
 
 template<template<typename> class PoolTemplate>
@@ -332,6 +343,261 @@ void TestSynchronizedPoolCachingOversized()
     TestPoolCachingOversized<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedPoolCachingOversized);
+
+void TestConcurrentPoolCachingOversized()
+{
+    TestPoolCachingOversized<thrust::mr::concurrent_pool_resource>();
+}
+DECLARE_UNITTEST(TestConcurrentPoolCachingOversized);
+#endif
+
+template<template<typename> class PoolTemplate>
+void TestPoolCachingOversizedReuse()
+{
+    tracked_resource upstream;
+
+    upstream.id_to_allocate = -1u;
+
+    typedef PoolTemplate<
+        tracked_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+
+    Pool pool(&upstream, opts);
+
+    // cache blocks of many different sizes
+    std::vector<tracked_pointer<void> > blocks;
+    for (std::size_t i = 0; i < 12; ++i)
+    {
+        upstream.id_to_allocate = i + 1;
+        blocks.push_back(pool.do_allocate(2048u << i, 32));
+        ASSERT_EQUAL(blocks.back().id, i + 1);
+    }
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+        pool.do_deallocate(blocks[i], 2048u << i, 32);
+    }
+
+    // the best fitting cached block is reused, even if it's bigger than requested...
+    tracked_pointer<void> a1 = pool.do_allocate(3000u << 4, 32);
+    ASSERT_EQUAL(a1.id, 6u);
+
+    tracked_pointer<void> a2 = pool.do_allocate(2048u << 4, 32);
+    ASSERT_EQUAL(a2.id, 5u);
+
+    // ...and it can be deallocated with the smaller size it was handed out with, after which
+    // its whole size is available again
+    pool.do_deallocate(a1, 3000u << 4, 32);
+    tracked_pointer<void> a3 = pool.do_allocate(2048u << 5, 32);
+    ASSERT_EQUAL(a3.id, 6u);
+
+    pool.do_deallocate(a3, 2048u << 5, 32);
+    pool.do_deallocate(a2, 2048u << 4, 32);
+}
+
+void TestUnsynchronizedPoolCachingOversizedReuse()
+{
+    TestPoolCachingOversizedReuse<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolCachingOversizedReuse);
+
+template<template<typename> class PoolTemplate>
+void TestPoolTrim()
+{
+    tracked_resource upstream;
+
+    upstream.id_to_allocate = -1u;
+
+    typedef PoolTemplate<
+        tracked_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+
+    Pool pool(&upstream, opts);
+
+    upstream.id_to_allocate = 1;
+    tracked_pointer<void> a1 = pool.do_allocate(16, THRUST_MR_DEFAULT_ALIGNMENT);
+    tracked_pointer<void> a2 = pool.do_allocate(16, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a2.id, 1u);
+
+    upstream.id_to_allocate = 2;
+    tracked_pointer<void> a3 = pool.do_allocate(256, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a3.id, 2u);
+
+    upstream.id_to_allocate = 3;
+    tracked_pointer<void> a4 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a4.id, 3u);
+
+    // nothing is idle while every chunk has a block allocated from it
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    pool.do_deallocate(a3, 256, THRUST_MR_DEFAULT_ALIGNMENT);
+    std::size_t chunk_bytes = pool.cached_bytes();
+    ASSERT_EQUAL(chunk_bytes > 0, true);
+
+    pool.do_deallocate(a4, 4096, 32);
+    ASSERT_EQUAL(pool.cached_bytes() > chunk_bytes + 4096, true);
+
+    // the chunk became idle first, so it's the first to be returned
+    upstream.id_to_deallocate = 2;
+    pool.trim(pool.cached_bytes() - 1);
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    upstream.id_to_deallocate = 3;
+    pool.trim();
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+    ASSERT_EQUAL(pool.cached_bytes(), 0u);
+
+    // a chunk with allocated blocks is kept, and is returned once they are all deallocated
+    pool.do_deallocate(a1, 16, THRUST_MR_DEFAULT_ALIGNMENT);
+    pool.do_deallocate(a2, 16, THRUST_MR_DEFAULT_ALIGNMENT);
+
+    upstream.id_to_deallocate = 1;
+    pool.trim();
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    // the blocks of returned chunks aren't handed out anymore
+    upstream.id_to_allocate = 4;
+    tracked_pointer<void> a5 = pool.do_allocate(16, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a5.id, 4u);
+
+    upstream.id_to_allocate = 5;
+    tracked_pointer<void> a6 = pool.do_allocate(256, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a6.id, 5u);
+
+    upstream.id_to_allocate = 6;
+    tracked_pointer<void> a7 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a7.id, 6u);
+
+    pool.do_deallocate(a5, 16, THRUST_MR_DEFAULT_ALIGNMENT);
+    pool.do_deallocate(a6, 256, THRUST_MR_DEFAULT_ALIGNMENT);
+    pool.do_deallocate(a7, 4096, 32);
+}
+
+void TestUnsynchronizedPoolTrim()
+{
+    TestPoolTrim<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolTrim);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestSynchronizedPoolTrim()
+{
+    TestPoolTrim<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolTrim);
+#endif
+
+template<template<typename> class PoolTemplate>
+void TestPoolMaxCachedBytes()
+{
+    tracked_resource upstream;
+
+    upstream.id_to_allocate = -1u;
+
+    typedef PoolTemplate<
+        tracked_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+    opts.max_cached_bytes = 10000;
+
+    Pool pool(&upstream, opts);
+
+    std::vector<tracked_pointer<void> > blocks;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        upstream.id_to_allocate = i + 1;
+        blocks.push_back(pool.do_allocate(4096, 32));
+        ASSERT_EQUAL(blocks.back().id, i + 1);
+    }
+
+    // two blocks fit in the limit...
+    pool.do_deallocate(blocks[0], 4096, 32);
+    pool.do_deallocate(blocks[1], 4096, 32);
+    ASSERT_EQUAL(pool.cached_bytes() <= opts.max_cached_bytes, true);
+
+    // ...but the third one makes the least recently cached one be returned
+    upstream.id_to_deallocate = 1;
+    pool.do_deallocate(blocks[2], 4096, 32);
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+    ASSERT_EQUAL(pool.cached_bytes() <= opts.max_cached_bytes, true);
+
+    tracked_pointer<void> a1 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a1.id, 3u);
+    tracked_pointer<void> a2 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a2.id, 2u);
+
+    // a chunk that is bigger than the limit is returned as soon as it becomes idle
+    upstream.id_to_allocate = 4;
+    tracked_pointer<void> a3 = pool.do_allocate(1024, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a3.id, 4u);
+
+    upstream.id_to_deallocate = 4;
+    pool.do_deallocate(a3, 1024, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    pool.do_deallocate(a1, 4096, 32);
+    pool.do_deallocate(a2, 4096, 32);
+}
+
+void TestUnsynchronizedPoolMaxCachedBytes()
+{
+    TestPoolMaxCachedBytes<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolMaxCachedBytes);
+
+void TestPoolOptionsWithoutCacheLimit()
+{
+    tracked_resource upstream;
+
+    upstream.id_to_allocate = -1u;
+
+    // options set up by hand, which predate max_cached_bytes, keep caching everything
+    thrust::mr::pool_options opts;
+    opts.min_blocks_per_chunk = 16;
+    opts.min_bytes_per_chunk = 1024;
+    opts.max_blocks_per_chunk = 1024;
+    opts.max_bytes_per_chunk = 1024 * 1024;
+    opts.smallest_block_size = THRUST_MR_DEFAULT_ALIGNMENT;
+    opts.largest_block_size = 1024;
+    opts.alignment = THRUST_MR_DEFAULT_ALIGNMENT;
+    opts.cache_oversized = true;
+    opts.cached_size_cutoff_factor = 16;
+    opts.cached_alignment_cutoff_factor = 16;
+    ASSERT_EQUAL(opts.max_cached_bytes, ~static_cast<std::size_t>(0));
+
+    thrust::mr::unsynchronized_pool_resource<tracked_resource> pool(&upstream, opts);
+
+    upstream.id_to_allocate = 1;
+    tracked_pointer<void> a1 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a1.id, 1u);
+
+    pool.do_deallocate(a1, 4096, 32);
+    ASSERT_EQUAL(pool.cached_bytes() >= 4096u, true);
+
+    // taken from the cache; upstream would reject another allocation
+    tracked_pointer<void> a2 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a2.id, 1u);
+
+    pool.do_deallocate(a2, 4096, 32);
+}
+DECLARE_UNITTEST(TestPoolOptionsWithoutCacheLimit);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestSynchronizedPoolMaxCachedBytes()
+{
+    TestPoolMaxCachedBytes<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolMaxCachedBytes);
 #endif
 
 template<template<typename> class PoolTemplate>
@@ -356,5 +622,80 @@ void TestSynchronizedGlobalPool()
     TestGlobalPool<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedGlobalPool);
+
+void TestConcurrentGlobalPool()
+{
+    TestGlobalPool<thrust::mr::concurrent_pool_resource>();
+}
+DECLARE_UNITTEST(TestConcurrentGlobalPool);
+
+void TestConcurrentPoolManyThreads()
+{
+    typedef thrust::mr::concurrent_pool_resource<
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    Pool pool;
+
+    const std::size_t thread_count = 8;
+    const std::size_t iterations = 2000;
+
+    std::vector<std::vector<std::size_t> > errors(thread_count);
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]{
+            std::vector<std::pair<unsigned char *, std::size_t> > held;
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                // sizes across several pools, including oversized ones
+                std::size_t size = 8u << ((i + t) % 18);
+                unsigned char * ptr = static_cast<unsigned char *>(pool.do_allocate(size));
+                ptr[0] = static_cast<unsigned char>(t);
+                ptr[size - 1] = static_cast<unsigned char>(t);
+                held.push_back(std::make_pair(ptr, size));
+
+                // free blocks out of order, so that magazines are exchanged with the depot
+                if (i % 3 == 2)
+                {
+                    for (std::size_t j = 0; j < held.size(); j += 2)
+                    {
+                        if (held[j].first[0] != t || held[j].first[held[j].second - 1] != t)
+                        {
+                            errors[t].push_back(i);
+                        }
+                        pool.do_deallocate(held[j].first, held[j].second);
+                    }
+
+                    std::vector<std::pair<unsigned char *, std::size_t> > kept;
+                    for (std::size_t j = 1; j < held.size(); j += 2)
+                    {
+                        kept.push_back(held[j]);
+                    }
+                    held.swap(kept);
+                }
+            }
+
+            for (std::size_t j = 0; j < held.size(); ++j)
+            {
+                pool.do_deallocate(held[j].first, held[j].second);
+            }
+        });
+    }
+
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        threads[t].join();
+        ASSERT_EQUAL(errors[t].size(), 0u);
+    }
+
+    // blocks cached by threads aren't idle memory, but the rest of it is returned by trim
+    pool.trim();
+    const Pool & trimmed = pool;
+    ASSERT_EQUAL(trimmed.cached_bytes(), 0u);
+}
+DECLARE_UNITTEST(TestConcurrentPoolManyThreads);
 #endif
 
@@ -0,0 +1,143 @@
+#include <unittest/unittest.h>
+
+#include <thrust/mr/new.h>
+#include <thrust/mr/pool.h>
+#include <thrust/mr/statistics.h>
+
+#include <sstream>
+
+void TestStatisticsResource()
+{
+    thrust::mr::statistics_resource<thrust::mr::new_delete_resource> stats;
+
+    void * a = stats.do_allocate(100);
+    void * b = stats.do_allocate(3000);
+    stats.do_deallocate(a, 100);
+    void * c = stats.do_allocate(128);
+
+    const thrust::mr::allocation_statistics & s = stats.statistics();
+    ASSERT_EQUAL(s.allocations, 3u);
+    ASSERT_EQUAL(s.deallocations, 1u);
+    ASSERT_EQUAL(s.bytes_in_use, 3128u);
+    ASSERT_EQUAL(s.peak_bytes_in_use, 3128u);
+
+    ASSERT_EQUAL(s.requests[7], 2u);
+    ASSERT_EQUAL(s.requests[12], 1u);
+
+    // without upstream statistics, nothing is known about hits and misses
+    ASSERT_EQUAL(s.hits[7], 0u);
+    ASSERT_EQUAL(s.misses[7], 0u);
+    ASSERT_EQUAL(stats.fragmentation(), 0.0);
+
+    stats.do_deallocate(b, 3000);
+    stats.reset_statistics();
+    ASSERT_EQUAL(s.allocations, 0u);
+    ASSERT_EQUAL(s.requests[7], 0u);
+    ASSERT_EQUAL(s.bytes_in_use, 128u);
+    ASSERT_EQUAL(s.peak_bytes_in_use, 128u);
+
+    stats.do_deallocate(c, 128);
+    ASSERT_EQUAL(s.bytes_in_use, 0u);
+}
+DECLARE_UNITTEST(TestStatisticsResource);
+
+// the adaptor can be derived from, to act on the requests it observes
+class counting_statistics_resource : public thrust::mr::statistics_resource<thrust::mr::new_delete_resource>
+{
+public:
+    counting_statistics_resource() : large_allocations(0)
+    {
+    }
+
+    virtual void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        if (bytes >= 1024)
+        {
+            ++large_allocations;
+        }
+        return thrust::mr::statistics_resource<thrust::mr::new_delete_resource>::do_allocate(bytes, alignment);
+    }
+
+    std::size_t large_allocations;
+};
+
+void TestStatisticsResourceDerived()
+{
+    counting_statistics_resource stats;
+
+    void * a = stats.do_allocate(100);
+    void * b = stats.do_allocate(3000);
+    ASSERT_EQUAL(stats.large_allocations, 1u);
+    ASSERT_EQUAL(stats.statistics().allocations, 2u);
+
+    stats.do_deallocate(a, 100);
+    stats.do_deallocate(b, 3000);
+    ASSERT_EQUAL(stats.statistics().bytes_in_use, 0u);
+}
+DECLARE_UNITTEST(TestStatisticsResourceDerived);
+
+struct size_class_counter
+{
+    std::size_t * classes;
+    std::size_t * requests;
+
+    void operator()(std::size_t, std::size_t r, std::size_t, std::size_t) const
+    {
+        ++*classes;
+        *requests += r;
+    }
+};
+
+void TestStatisticsResourceAroundPool()
+{
+    typedef thrust::mr::statistics_resource<thrust::mr::new_delete_resource> upstream_stats;
+    typedef thrust::mr::unsynchronized_pool_resource<upstream_stats> pool;
+
+    upstream_stats upstream;
+
+    thrust::mr::pool_options opts = pool::get_default_options();
+    opts.largest_block_size = 1024;
+
+    pool p(&upstream, opts);
+    thrust::mr::statistics_resource<pool> stats(&p);
+    stats.attach_upstream_statistics(upstream.statistics(), opts);
+
+    const thrust::mr::allocation_statistics & s = stats.statistics();
+
+    // the pool allocates its bookkeeping from upstream too
+    std::size_t bookkeeping_allocations = upstream.statistics().allocations;
+
+    // the first allocation of a size needs a chunk from upstream, the second doesn't
+    void * a1 = stats.do_allocate(64);
+    void * a2 = stats.do_allocate(64);
+    ASSERT_EQUAL(s.misses[6], 1u);
+    ASSERT_EQUAL(s.hits[6], 1u);
+    ASSERT_EQUAL(upstream.statistics().allocations, bookkeeping_allocations + 1);
+
+    // oversized blocks are cached and reused
+    void * b = stats.do_allocate(4096);
+    stats.do_deallocate(b, 4096);
+    b = stats.do_allocate(4096);
+    ASSERT_EQUAL(s.oversized_misses, 1u);
+    ASSERT_EQUAL(s.oversized_hits, 1u);
+    ASSERT_EQUAL(s.hits[12], 1u);
+
+    // the pool holds more memory than is in use
+    ASSERT_EQUAL(stats.fragmentation() > 0.0, true);
+    ASSERT_EQUAL(stats.fragmentation() < 1.0, true);
+
+    std::size_t classes = 0, requests = 0;
+    size_class_counter counter = { &classes, &requests };
+    stats.visit_size_classes(counter);
+    ASSERT_EQUAL(classes, 2u);
+    ASSERT_EQUAL(requests, 4u);
+
+    std::ostringstream os;
+    stats.dump(os);
+    ASSERT_EQUAL(os.str().find("oversized hits: 1") != std::string::npos, true);
+
+    stats.do_deallocate(a1, 64);
+    stats.do_deallocate(a2, 64);
+    stats.do_deallocate(b, 4096);
+}
+DECLARE_UNITTEST(TestStatisticsResourceAroundPool);
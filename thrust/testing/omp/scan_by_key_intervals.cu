@@ -0,0 +1,49 @@
+#include <unittest/unittest.h>
+
+#include <thrust/functional.h>
+#include <thrust/scan.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/execution_policy.h>
+
+// the OpenMP system splits the input into one interval per processor; scan
+// over more intervals than that to exercise the carries between them
+template<typename T>
+void TestOmpScanByKeyIntervals(const size_t n)
+{
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  thrust::host_vector<T> values = unittest::random_integers<T>(n);
+  thrust::host_vector<int> keys = unittest::random_integers<bool>(n);
+
+  // make segments of various lengths, some of them spanning several intervals
+  for (size_t i = 1; i < n; i++)
+  {
+    keys[i] = keys[i - 1] + (keys[i] && i % 37 == 0);
+  }
+
+  if (n == 0)
+  {
+    return;
+  }
+
+  thrust::omp::tag omp_tag;
+
+  for (int num_intervals = 1; num_intervals <= 9; num_intervals += 4)
+  {
+    uniform_decomposition<long> decomp(n, 1, num_intervals);
+
+    thrust::host_vector<T> reference(n);
+    thrust::host_vector<T> result(n);
+
+    thrust::inclusive_scan_by_key(thrust::seq, keys.begin(), keys.end(), values.begin(), reference.begin());
+    thrust::system::omp::detail::scan_by_key_detail::inclusive_scan_by_key(
+      omp_tag, keys.begin(), values.begin(), result.begin(), thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(reference, result);
+
+    thrust::exclusive_scan_by_key(thrust::seq, keys.begin(), keys.end(), values.begin(), reference.begin(), T(13));
+    thrust::system::omp::detail::scan_by_key_detail::exclusive_scan_by_key(
+      omp_tag, keys.begin(), values.begin(), result.begin(), T(13), thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(reference, result);
+  }
+}
+DECLARE_VARIABLE_UNITTEST(TestOmpScanByKeyIntervals);
@@ -0,0 +1,57 @@
+#include <unittest/unittest.h>
+
+#include <thrust/random.h>
+#include <thrust/sequence.h>
+#include <thrust/shuffle.h>
+#include <thrust/sort.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/omp/vector.h>
+
+#include <cstddef>
+
+// the parallel shuffle must produce the permutation of the sequential one for the same generator
+template<typename Policy>
+void check_shuffle(Policy policy, std::size_t n)
+{
+  thrust::host_vector<int> h_data(n);
+  thrust::sequence(h_data.begin(), h_data.end());
+  thrust::omp::vector<int> d_data = h_data;
+
+  thrust::host_vector<int> h_result(n);
+  thrust::omp::vector<int> d_result(n);
+
+  thrust::default_random_engine host_g(0xD5);
+  thrust::default_random_engine device_g(0xD5);
+
+  thrust::shuffle_copy(thrust::seq, h_data.begin(), h_data.end(), h_result.begin(), host_g);
+  thrust::shuffle_copy(policy, d_data.begin(), d_data.end(), d_result.begin(), device_g);
+  ASSERT_EQUAL(h_result, d_result);
+
+  thrust::shuffle(thrust::seq, h_data.begin(), h_data.end(), host_g);
+  thrust::shuffle(policy, d_data.begin(), d_data.end(), device_g);
+  ASSERT_EQUAL(h_data, d_data);
+
+  // and the result is a permutation of the input
+  thrust::sort(d_result.begin(), d_result.end());
+  thrust::sort(d_data.begin(), d_data.end());
+  thrust::sequence(h_data.begin(), h_data.end());
+  ASSERT_EQUAL(h_data, d_result);
+  ASSERT_EQUAL(h_data, d_data);
+}
+
+void TestOmpShuffleMatchesSequential(void)
+{
+  // empty, single element, below and above a power of two, and more elements than
+  // the intervals of any of the teams below
+  const std::size_t sizes[] = {0, 1, 2, 1000, 1024, 1025, 100003};
+
+  for(std::size_t i = 0; i != sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    check_shuffle(thrust::omp::par, sizes[i]);
+    check_shuffle(thrust::omp::par.with(thrust::omp::num_threads(1)), sizes[i]);
+    check_shuffle(thrust::omp::par.with(thrust::omp::num_threads(2)), sizes[i]);
+    check_shuffle(thrust::omp::par.with(thrust::omp::num_threads(3)), sizes[i]);
+    check_shuffle(thrust::omp::par.with(thrust::omp::num_threads(7)), sizes[i]);
+  }
+}
+DECLARE_UNITTEST(TestOmpShuffleMatchesSequential);
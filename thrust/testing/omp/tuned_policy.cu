@@ -0,0 +1,167 @@
+#include <unittest/unittest.h>
+
+#include <thrust/count.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/merge.h>
+#include <thrust/mr/host_temporary_cache.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/set_operations.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/unique.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/omp/vector.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+
+#include <omp.h>
+
+template<typename Policy>
+thrust::system::omp::detail::tuning get_policy_tuning(Policy policy)
+{
+  return thrust::system::omp::detail::tuning_of(policy);
+}
+
+void TestOmpTunedPolicyCarriesTuning(void)
+{
+  typedef thrust::system::omp::detail::tuning tuning;
+
+  tuning t = get_policy_tuning(thrust::omp::par);
+  ASSERT_EQUAL(t.thread_count, 0);
+  ASSERT_EQUAL(t.kind == thrust::omp::schedule_static, true);
+  ASSERT_EQUAL(t.chunk_size, 0u);
+  ASSERT_EQUAL(t.team_size(), omp_get_max_threads());
+  ASSERT_EQUAL(t.num_intervals(), omp_get_num_procs());
+
+  t = get_policy_tuning(thrust::omp::par.with(thrust::omp::num_threads(3),
+                                              thrust::omp::schedule(thrust::omp::schedule_dynamic, 64)));
+  ASSERT_EQUAL(t.thread_count, 3);
+  ASSERT_EQUAL(t.kind == thrust::omp::schedule_dynamic, true);
+  ASSERT_EQUAL(t.chunk_size, 64u);
+  ASSERT_EQUAL(t.team_size(), 3);
+  ASSERT_EQUAL(t.num_intervals(), 3);
+
+  // later arguments and later calls override earlier ones
+  t = get_policy_tuning(thrust::omp::par.with(thrust::omp::num_threads(2), thrust::omp::num_threads(5))
+                                        .with(thrust::omp::schedule(thrust::omp::schedule_guided)));
+  ASSERT_EQUAL(t.thread_count, 5);
+  ASSERT_EQUAL(t.kind == thrust::omp::schedule_guided, true);
+  ASSERT_EQUAL(t.chunk_size, 0u);
+
+  // tuning survives an attached allocator
+  std::allocator<char> alloc;
+  t = get_policy_tuning(thrust::omp::par(alloc).with(thrust::omp::num_threads(7)));
+  ASSERT_EQUAL(t.thread_count, 7);
+}
+DECLARE_UNITTEST(TestOmpTunedPolicyCarriesTuning);
+
+void TestOmpTunedPolicyDecomposition(void)
+{
+  thrust::system::omp::detail::execute_with_tuning policy = thrust::omp::par.with(thrust::omp::num_threads(5));
+
+  // one interval per thread, unless there are fewer elements than threads
+  ASSERT_EQUAL(thrust::system::omp::detail::default_decomposition(policy, 1000).size(), 5);
+  ASSERT_EQUAL(thrust::system::omp::detail::default_decomposition(policy, 3).size(), 3);
+}
+DECLARE_UNITTEST(TestOmpTunedPolicyDecomposition);
+
+struct record_team_size
+{
+  template<typename T>
+  void operator()(T &x) const
+  {
+    x = omp_get_num_threads();
+  }
+};
+
+void TestOmpTunedPolicyTeamSize(void)
+{
+  thrust::omp::vector<int> team_sizes(1000);
+
+  // OpenMP may only give a region fewer threads than requested when dynamic adjustment is on
+  const int saved_dynamic = omp_get_dynamic();
+  omp_set_dynamic(0);
+
+  thrust::for_each(thrust::omp::par.with(thrust::omp::num_threads(3)), team_sizes.begin(), team_sizes.end(), record_team_size());
+  ASSERT_EQUAL(thrust::count(team_sizes.begin(), team_sizes.end(), 3), 1000);
+
+  thrust::for_each(thrust::omp::par.with(thrust::omp::num_threads(2), thrust::omp::schedule(thrust::omp::schedule_dynamic, 7)),
+                   team_sizes.begin(), team_sizes.end(), record_team_size());
+  ASSERT_EQUAL(thrust::count(team_sizes.begin(), team_sizes.end(), 2), 1000);
+
+  omp_set_dynamic(saved_dynamic);
+}
+DECLARE_UNITTEST(TestOmpTunedPolicyTeamSize);
+
+template<typename Policy>
+void check_tuned_algorithms(Policy policy, size_t n)
+{
+  thrust::host_vector<int> h_data = unittest::random_integers<int>(n);
+  thrust::omp::vector<int> d_data = h_data;
+
+  ASSERT_EQUAL(thrust::reduce(policy, d_data.begin(), d_data.end()),
+               thrust::reduce(h_data.begin(), h_data.end()));
+
+  thrust::host_vector<int> h_result(n);
+  thrust::omp::vector<int> d_result(n);
+  thrust::transform(h_data.begin(), h_data.end(), h_result.begin(), thrust::negate<int>());
+  thrust::transform(policy, d_data.begin(), d_data.end(), d_result.begin(), thrust::negate<int>());
+  ASSERT_EQUAL(h_result, d_result);
+
+  thrust::inclusive_scan(h_data.begin(), h_data.end(), h_result.begin());
+  thrust::inclusive_scan(policy, d_data.begin(), d_data.end(), d_result.begin());
+  ASSERT_EQUAL(h_result, d_result);
+
+  thrust::sort(h_data.begin(), h_data.end());
+  thrust::sort(policy, d_data.begin(), d_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+
+  thrust::host_vector<int> h_merged(2 * n);
+  thrust::omp::vector<int> d_merged(2 * n);
+  thrust::merge(h_data.begin(), h_data.end(), h_data.begin(), h_data.end(), h_merged.begin());
+  thrust::merge(policy, d_data.begin(), d_data.end(), d_data.begin(), d_data.end(), d_merged.begin());
+  ASSERT_EQUAL(h_merged, d_merged);
+
+  h_merged.erase(thrust::set_union(h_data.begin(), h_data.end(), h_data.begin() + n / 2, h_data.end(), h_merged.begin()), h_merged.end());
+  d_merged.erase(thrust::set_union(policy, d_data.begin(), d_data.end(), d_data.begin() + n / 2, d_data.end(), d_merged.begin()), d_merged.end());
+  ASSERT_EQUAL(h_merged, d_merged);
+
+  h_data.erase(thrust::unique(h_data.begin(), h_data.end()), h_data.end());
+  d_data.erase(thrust::unique(policy, d_data.begin(), d_data.end()), d_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+}
+
+void TestOmpTunedPolicyAlgorithms(size_t n)
+{
+  check_tuned_algorithms(thrust::omp::par.with(thrust::omp::num_threads(1)), n);
+  check_tuned_algorithms(thrust::omp::par.with(thrust::omp::num_threads(3)), n);
+  check_tuned_algorithms(thrust::omp::par.with(thrust::omp::num_threads(4), thrust::omp::schedule(thrust::omp::schedule_static, 16)), n);
+  check_tuned_algorithms(thrust::omp::par.with(thrust::omp::schedule(thrust::omp::schedule_dynamic, 100)), n);
+  check_tuned_algorithms(thrust::omp::par.with(thrust::omp::num_threads(2), thrust::omp::schedule(thrust::omp::schedule_guided)), n);
+}
+DECLARE_SIZED_UNITTEST(TestOmpTunedPolicyAlgorithms);
+
+void TestOmpTunedPolicyUsesHostTemporaryCache(void)
+{
+  bool was_enabled = thrust::mr::host_temporary_cache_enabled();
+  thrust::detail::host_temporary_cache & cache = thrust::detail::host_temporary_cache::thread_instance();
+
+  thrust::mr::release_host_temporary_cache();
+  thrust::mr::enable_host_temporary_cache();
+
+  // large enough for the parallel sort, which allocates temporary storage
+  thrust::host_vector<int> h_data = unittest::random_integers<int>(1 << 17);
+  thrust::omp::vector<int> d_data = h_data;
+
+  // the temporary storage of a tuned policy is cached like the one of the untuned policy
+  thrust::stable_sort(thrust::omp::par.with(thrust::omp::num_threads(2)), d_data.begin(), d_data.end());
+  ASSERT_EQUAL(cache.cached_bytes() > 0, true);
+
+  thrust::stable_sort(h_data.begin(), h_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+
+  thrust::mr::release_host_temporary_cache();
+  thrust::mr::enable_host_temporary_cache(was_enabled);
+}
+DECLARE_UNITTEST(TestOmpTunedPolicyUsesHostTemporaryCache);
@@ -739,6 +739,211 @@ void TestRanlux48Unequal(void)
 DECLARE_UNITTEST(TestRanlux48Unequal);
 
 
+void TestPhilox4x32_10Validation(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  TestEngineValidation<Engine,1955073260u>();
+}
+DECLARE_UNITTEST(TestPhilox4x32_10Validation);
+
+
+void TestPhilox4x32_10Min(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32_10Min);
+
+
+void TestPhilox4x32_10Max(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32_10Max);
+
+
+void TestPhilox4x32_10SaveRestore(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32_10SaveRestore);
+
+
+void TestPhilox4x32_10Equal(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32_10Equal);
+
+
+void TestPhilox4x32_10Unequal(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32_10Unequal);
+
+
+void TestPhilox4x64_10Validation(void)
+{
+  typedef thrust::random::philox4x64_10 Engine;
+
+  TestEngineValidation<Engine,3409172418970261260ull>();
+}
+DECLARE_UNITTEST(TestPhilox4x64_10Validation);
+
+
+void TestPhilox4x64_10Min(void)
+{
+  typedef thrust::random::philox4x64_10 Engine;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64_10Min);
+
+
+void TestPhilox4x64_10Max(void)
+{
+  typedef thrust::random::philox4x64_10 Engine;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64_10Max);
+
+
+void TestPhilox4x64_10SaveRestore(void)
+{
+  typedef thrust::random::philox4x64_10 Engine;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64_10SaveRestore);
+
+
+void TestPhilox4x64_10Equal(void)
+{
+  typedef thrust::random::philox4x64_10 Engine;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64_10Equal);
+
+
+void TestPhilox4x64_10Unequal(void)
+{
+  typedef thrust::random::philox4x64_10 Engine;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64_10Unequal);
+
+
+template<typename Engine>
+  struct ValidatePhiloxDiscard
+{
+  __host__ __device__
+  bool operator()(void) const
+  {
+    bool result = true;
+
+    // discard must agree with stepping from every position in a group of results
+    for(unsigned int offset = 0; offset < 5; ++offset)
+    {
+      for(unsigned int z = 0; z < 11; ++z)
+      {
+        Engine e0(13), e1(13);
+        e0.discard(offset);
+        e1.discard(offset);
+
+        e0.discard(z);
+        for(unsigned int i = 0; i < z; ++i)
+        {
+          e1();
+        }
+
+        result &= (e0 == e1);
+        result &= (e0() == e1());
+      }
+    }
+
+    // a discard spanning a carry between counter words
+    Engine e2(13), e3(13);
+    e2.discard(4ull * 0xFFFFFFFFull + 1);
+    e3.discard(4ull * 0xFFFFFFFEull);
+    e3.discard(5);
+    result &= (e2 == e3);
+    result &= (e2() == e3());
+
+    return result;
+  }
+};
+
+
+void TestPhilox4x32_10Discard(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  // test host
+  thrust::host_vector<bool> h(1);
+  thrust::generate(h.begin(), h.end(), ValidatePhiloxDiscard<Engine>());
+
+  ASSERT_EQUAL(true, h[0]);
+
+  // test device
+  thrust::device_vector<bool> d(1);
+  thrust::generate(d.begin(), d.end(), ValidatePhiloxDiscard<Engine>());
+
+  ASSERT_EQUAL(true, d[0]);
+}
+DECLARE_UNITTEST(TestPhilox4x32_10Discard);
+
+
+void TestPhilox4x32_10KnownAnswer(void)
+{
+  // the Random123 known-answer test for a zero counter and key
+  thrust::random::philox4x32_10 e(0);
+
+  ASSERT_EQUAL(e(), 0x6627e8d5u);
+  ASSERT_EQUAL(e(), 0xe169c58du);
+  ASSERT_EQUAL(e(), 0xbc57ac4cu);
+  ASSERT_EQUAL(e(), 0x9b00dbd8u);
+}
+DECLARE_UNITTEST(TestPhilox4x32_10KnownAnswer);
+
+
+void TestPhilox4x32_10Streams(void)
+{
+  typedef thrust::random::philox4x32_10 Engine;
+
+  // stream 0 is the stream of the single argument constructor
+  Engine e0(13, 0), e1(13);
+  ASSERT_EQUAL(true, e0 == e1);
+
+  // stream s begins 4 * 2^96 results after stream 0, which no discard can reach
+  Engine e2(13, 1), e3(13, 1);
+  ASSERT_EQUAL(true, e0 != e2);
+  ASSERT_EQUAL(true, e2 == e3);
+
+  e3.seed(13, 2);
+  ASSERT_EQUAL(true, e2 != e3);
+
+  e2.discard(1000);
+  e3.seed(13, 1);
+  e3.discard(1000);
+  ASSERT_EQUAL(e2(), e3());
+}
+DECLARE_UNITTEST(TestPhilox4x32_10Streams);
+
+
 THRUST_DISABLE_MSVC_WARNING_BEGIN(4305) // truncation warning
 template<typename Distribution, typename Validator>
   void ValidateDistributionCharacteristic(void)
@@ -0,0 +1,217 @@
+#include <unittest/unittest.h>
+#include <thrust/random.h>
+#include <thrust/random/generate_n.h>
+#include <thrust/count.h>
+#include <thrust/extrema.h>
+#include <thrust/reduce.h>
+#include <thrust/functional.h>
+
+#include <climits>
+#include <cmath>
+
+template<typename T>
+struct is_outside
+{
+  T a, b;
+
+  is_outside(T a, T b) : a(a), b(b) {}
+
+  __host__ __device__
+  bool operator()(T x) const
+  {
+    return x < a || b < x;
+  }
+};
+
+template<typename T>
+void TestRandomGenerateNUniformReal(const size_t n)
+{
+  thrust::random::uniform_real_distribution<T> dist(T(-2), T(3));
+
+  thrust::host_vector<T>   h_result(n);
+  thrust::device_vector<T> d_result(n);
+
+  thrust::random::generate_n(dist, 13u, h_result.begin(), n);
+  thrust::random::generate_n(dist, 13u, d_result.begin(), n);
+
+  // the result depends only on the distribution, seed and position
+  ASSERT_EQUAL(h_result, d_result);
+
+  ASSERT_EQUAL(thrust::count_if(h_result.begin(), h_result.end(), is_outside<T>(T(-2), T(3))), 0);
+}
+
+void TestRandomGenerateNUniformRealFloat(const size_t n)
+{
+  TestRandomGenerateNUniformReal<float>(n);
+}
+DECLARE_SIZED_UNITTEST(TestRandomGenerateNUniformRealFloat);
+
+void TestRandomGenerateNUniformRealDouble(const size_t n)
+{
+  TestRandomGenerateNUniformReal<double>(n);
+}
+DECLARE_SIZED_UNITTEST(TestRandomGenerateNUniformRealDouble);
+
+void TestRandomGenerateNUniformInt(const size_t n)
+{
+  thrust::random::uniform_int_distribution<int> dist(-3, 5);
+
+  thrust::host_vector<int>   h_result(n);
+  thrust::device_vector<int> d_result(n);
+
+  thrust::random::generate_n(dist, 7u, h_result.begin(), n);
+  thrust::random::generate_n(thrust::device, dist, 7u, d_result.begin(), n);
+
+  ASSERT_EQUAL(h_result, d_result);
+
+  ASSERT_EQUAL(thrust::count_if(h_result.begin(), h_result.end(), is_outside<int>(-3, 5)), 0);
+
+  if(n >= 10000)
+  {
+    // every value appears
+    for(int i = -3; i <= 5; ++i)
+    {
+      ASSERT_EQUAL(thrust::count(h_result.begin(), h_result.end(), i) > 0, true);
+    }
+  }
+}
+DECLARE_SIZED_UNITTEST(TestRandomGenerateNUniformInt);
+
+void TestRandomGenerateNUniformIntFullRange(void)
+{
+  const size_t n = 1000;
+
+  // a range of 2^32 values
+  thrust::host_vector<int> h_int(n);
+  thrust::random::generate_n(thrust::random::uniform_int_distribution<int>(INT_MIN, INT_MAX), 3u, h_int.begin(), n);
+  ASSERT_EQUAL(*thrust::min_element(h_int.begin(), h_int.end()) < 0, true);
+  ASSERT_EQUAL(*thrust::max_element(h_int.begin(), h_int.end()) > 0, true);
+
+  // a range wider than a word of the engine
+  const long long a = -(1ll << 40), b = 1ll << 40;
+  thrust::host_vector<long long> h_wide(n);
+  thrust::random::generate_n(thrust::random::uniform_int_distribution<long long>(a, b), 3u, h_wide.begin(), n);
+  ASSERT_EQUAL(thrust::count_if(h_wide.begin(), h_wide.end(), is_outside<long long>(a, b)), 0);
+  ASSERT_EQUAL(*thrust::max_element(h_wide.begin(), h_wide.end()) > (1ll << 32), true);
+}
+DECLARE_UNITTEST(TestRandomGenerateNUniformIntFullRange);
+
+template<typename T>
+void TestRandomGenerateNNormal(void)
+{
+  const size_t n = 100000;
+
+  thrust::random::normal_distribution<T> dist(T(2), T(3));
+
+  thrust::device_vector<T> d_result(n);
+  thrust::random::generate_n(dist, 11u, d_result.begin(), n);
+
+  thrust::host_vector<T> h_result = d_result;
+
+  double sum = 0, sum_of_squares = 0;
+  for(size_t i = 0; i < n; ++i)
+  {
+    sum            += h_result[i];
+    sum_of_squares += double(h_result[i]) * h_result[i];
+  }
+
+  const double mean   = sum / n;
+  const double stddev = std::sqrt(sum_of_squares / n - mean * mean);
+
+  ASSERT_EQUAL(std::fabs(mean - 2) < 0.05, true);
+  ASSERT_EQUAL(std::fabs(stddev - 3) < 0.05, true);
+}
+
+void TestRandomGenerateNNormalFloat(void)
+{
+  TestRandomGenerateNNormal<float>();
+}
+DECLARE_UNITTEST(TestRandomGenerateNNormalFloat);
+
+void TestRandomGenerateNNormalDouble(void)
+{
+  TestRandomGenerateNNormal<double>();
+}
+DECLARE_UNITTEST(TestRandomGenerateNNormalDouble);
+
+void TestRandomGenerateNPrefix(void)
+{
+  thrust::random::normal_distribution<float> dist;
+
+  thrust::device_vector<float> long_result(1000);
+  thrust::device_vector<float> short_result(333);
+
+  thrust::random::generate_n(dist, 5u, long_result.begin(), long_result.size());
+  thrust::random::generate_n(dist, 5u, short_result.begin(), short_result.size());
+
+  // a shorter range is a prefix of a longer one
+  long_result.resize(short_result.size());
+  ASSERT_EQUAL(long_result, short_result);
+
+  // different seeds give different values
+  thrust::random::generate_n(dist, 6u, short_result.begin(), short_result.size());
+  ASSERT_EQUAL(long_result == short_result, false);
+}
+DECLARE_UNITTEST(TestRandomGenerateNPrefix);
+
+void TestRandomGenerateNMatchesPhilox(void)
+{
+  const size_t n = 1000;
+
+  // the full range of unsigned int passes the words of the engine through
+  thrust::host_vector<unsigned int> h_result(n);
+  thrust::random::generate_n(thrust::random::uniform_int_distribution<unsigned int>(0, UINT_MAX), 17u, h_result.begin(), n);
+
+  // each block of 128 values is the start of one stream of philox4x32_10
+  for(size_t i = 0; i < n; ++i)
+  {
+    thrust::random::philox4x32_10 rng(17, static_cast<unsigned int>(i / 128));
+    rng.discard(i % 128);
+
+    ASSERT_EQUAL(h_result[i], rng());
+  }
+}
+DECLARE_UNITTEST(TestRandomGenerateNMatchesPhilox);
+
+// a distribution without a batched implementation
+struct coin_flip
+{
+  typedef int result_type;
+
+  template<typename UniformRandomNumberGenerator>
+  __host__ __device__
+  int operator()(UniformRandomNumberGenerator &urng)
+  {
+    return urng() & 1;
+  }
+};
+
+void TestRandomGenerateNGenericDistribution(void)
+{
+  const size_t n = 10000;
+
+  thrust::host_vector<int>   h_result(n);
+  thrust::device_vector<int> d_result(n);
+
+  thrust::random::generate_n(coin_flip(), 1u, h_result.begin(), n);
+  thrust::random::generate_n(coin_flip(), 1u, d_result.begin(), n);
+
+  ASSERT_EQUAL(h_result, d_result);
+
+  const int heads = thrust::reduce(h_result.begin(), h_result.end());
+  ASSERT_EQUAL(heads > 4500 && heads < 5500, true);
+}
+DECLARE_UNITTEST(TestRandomGenerateNGenericDistribution);
+
+void TestRandomGenerateNReturnValue(void)
+{
+  thrust::device_vector<float> d_result(10);
+
+  thrust::device_vector<float>::iterator end =
+    thrust::random::generate_n(thrust::random::uniform_real_distribution<float>(), 1u, d_result.begin(), 10);
+  ASSERT_EQUAL(end - d_result.begin(), 10);
+
+  end = thrust::random::generate_n(thrust::random::uniform_real_distribution<float>(), 1u, d_result.begin(), 0);
+  ASSERT_EQUAL(end - d_result.begin(), 0);
+}
+DECLARE_UNITTEST(TestRandomGenerateNReturnValue);
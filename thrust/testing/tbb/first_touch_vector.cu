@@ -0,0 +1,43 @@
+#include <unittest/unittest.h>
+
+#include <thrust/reduce.h>
+#include <thrust/sequence.h>
+#include <thrust/system/tbb/execution_policy.h>
+#include <thrust/system/tbb/vector.h>
+
+void TestTbbFirstTouchResourceAlignsLargeAllocations(void)
+{
+  thrust::system::tbb::first_touch_memory_resource resource;
+
+  // small allocations are left alone
+  thrust::tbb::pointer<void> small = resource.allocate(100);
+  ASSERT_EQUAL(reinterpret_cast<std::size_t>(small.get()) % THRUST_MR_DEFAULT_ALIGNMENT, 0u);
+  resource.deallocate(small, 100);
+
+  // large ones start at a page boundary and are already touched
+  const std::size_t bytes = std::size_t(1) << 20;
+  thrust::tbb::pointer<void> large = resource.allocate(bytes);
+  ASSERT_EQUAL(reinterpret_cast<std::size_t>(large.get()) % 4096, 0u);
+  ASSERT_EQUAL(static_cast<char *>(large.get())[4096], 0);
+  resource.deallocate(large, bytes);
+}
+DECLARE_UNITTEST(TestTbbFirstTouchResourceAlignsLargeAllocations);
+
+template<typename T>
+void TestTbbFirstTouchVector(const size_t n)
+{
+  thrust::tbb::first_touch_vector<T> v(n);
+  thrust::sequence(thrust::tbb::par, v.begin(), v.end());
+
+  thrust::tbb::vector<T> reference(n);
+  thrust::sequence(thrust::tbb::par, reference.begin(), reference.end());
+
+  ASSERT_EQUAL(v, reference);
+  ASSERT_EQUAL(thrust::reduce(thrust::tbb::par, v.begin(), v.end()),
+               thrust::reduce(thrust::tbb::par, reference.begin(), reference.end()));
+
+  v.resize(2 * n + 1, T(1));
+  ASSERT_EQUAL(v.size(), 2 * n + 1);
+  ASSERT_EQUAL(v[2 * n], T(1));
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbFirstTouchVector);
@@ -0,0 +1,81 @@
+#include <unittest/unittest.h>
+
+#include <thrust/random.h>
+#include <thrust/sequence.h>
+#include <thrust/shuffle.h>
+#include <thrust/sort.h>
+#include <thrust/system/tbb/execution_policy.h>
+#include <thrust/system/tbb/vector.h>
+
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+#include <cstddef>
+
+// the parallel shuffle must produce the permutation of the sequential one for the same generator
+template<typename Policy>
+void check_shuffle(Policy policy, std::size_t n)
+{
+  thrust::host_vector<int> h_data(n);
+  thrust::sequence(h_data.begin(), h_data.end());
+  thrust::tbb::vector<int> d_data = h_data;
+
+  thrust::host_vector<int> h_result(n);
+  thrust::tbb::vector<int> d_result(n);
+
+  thrust::default_random_engine host_g(0xD5);
+  thrust::default_random_engine device_g(0xD5);
+
+  thrust::shuffle_copy(thrust::seq, h_data.begin(), h_data.end(), h_result.begin(), host_g);
+  thrust::shuffle_copy(policy, d_data.begin(), d_data.end(), d_result.begin(), device_g);
+  ASSERT_EQUAL(h_result, d_result);
+
+  thrust::shuffle(thrust::seq, h_data.begin(), h_data.end(), host_g);
+  thrust::shuffle(policy, d_data.begin(), d_data.end(), device_g);
+  ASSERT_EQUAL(h_data, d_data);
+
+  // and the result is a permutation of the input
+  thrust::sort(d_result.begin(), d_result.end());
+  thrust::sort(d_data.begin(), d_data.end());
+  thrust::sequence(h_data.begin(), h_data.end());
+  ASSERT_EQUAL(h_data, d_result);
+  ASSERT_EQUAL(h_data, d_data);
+}
+
+template<typename Policy>
+struct shuffle_in_arena
+{
+  Policy policy;
+  std::size_t n;
+
+  void operator()() const
+  {
+    check_shuffle(policy, n);
+  }
+};
+
+template<typename Policy>
+void check_shuffle_in_arena(int num_threads, Policy policy, std::size_t n)
+{
+  ::tbb::task_arena arena(num_threads);
+  shuffle_in_arena<Policy> body = {policy, n};
+  arena.execute(body);
+}
+
+void TestTbbShuffleMatchesSequential(void)
+{
+  // empty, single element, below and above a power of two, and more elements than
+  // the grain of the loops below
+  const std::size_t sizes[] = {0, 1, 2, 1000, 1024, 1025, 100003};
+
+  for(std::size_t i = 0; i != sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    check_shuffle(thrust::tbb::par, sizes[i]);
+    check_shuffle(thrust::tbb::par.with(thrust::tbb::grain(1), ::tbb::simple_partitioner()), sizes[i]);
+    check_shuffle(thrust::tbb::par.with(thrust::tbb::grain(7), ::tbb::simple_partitioner()), sizes[i]);
+    check_shuffle(thrust::tbb::par.with(thrust::tbb::grain(1000), ::tbb::static_partitioner()), sizes[i]);
+    check_shuffle_in_arena(1, thrust::tbb::par, sizes[i]);
+    check_shuffle_in_arena(3, thrust::tbb::par.with(thrust::tbb::grain(64)), sizes[i]);
+  }
+}
+DECLARE_UNITTEST(TestTbbShuffleMatchesSequential);
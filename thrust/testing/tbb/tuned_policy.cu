@@ -0,0 +1,201 @@
+#include <unittest/unittest.h>
+
+#include <thrust/adjacent_difference.h>
+#include <thrust/functional.h>
+#include <thrust/inner_product.h>
+#include <thrust/merge.h>
+#include <thrust/mr/host_temporary_cache.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/system/tbb/execution_policy.h>
+#include <thrust/system/tbb/vector.h>
+
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+#include <utility>
+
+template<typename Policy>
+thrust::system::tbb::detail::tuning get_policy_tuning(Policy policy)
+{
+  return thrust::system::tbb::detail::tuning_of(policy);
+}
+
+void TestTbbTunedPolicyCarriesTuning(void)
+{
+  typedef thrust::system::tbb::detail::tuning tuning;
+
+  tuning t = get_policy_tuning(thrust::tbb::par);
+  ASSERT_EQUAL(t.grain_size, 0u);
+  ASSERT_EQUAL(t.partitioner == tuning::auto_partitioner, true);
+
+  t = get_policy_tuning(thrust::tbb::par.with(thrust::tbb::grain(4096), ::tbb::static_partitioner()));
+  ASSERT_EQUAL(t.grain_size, 4096u);
+  ASSERT_EQUAL(t.partitioner == tuning::static_partitioner, true);
+
+  // later arguments and later calls override earlier ones
+  t = get_policy_tuning(thrust::tbb::par.with(::tbb::static_partitioner(), ::tbb::simple_partitioner()).with(thrust::tbb::grain(7)));
+  ASSERT_EQUAL(t.grain_size, 7u);
+  ASSERT_EQUAL(t.partitioner == tuning::simple_partitioner, true);
+
+  ::tbb::affinity_partitioner ap;
+  t = get_policy_tuning(thrust::tbb::par.with(ap));
+  ASSERT_EQUAL(t.partitioner == tuning::affinity_partitioner, true);
+  ASSERT_EQUAL(t.affinity == &ap, true);
+
+  // tuning survives an attached allocator
+  std::allocator<char> alloc;
+  t = get_policy_tuning(thrust::tbb::par(alloc).with(thrust::tbb::grain(3000)));
+  ASSERT_EQUAL(t.grain_size, 3000u);
+}
+DECLARE_UNITTEST(TestTbbTunedPolicyCarriesTuning);
+
+template<typename T, typename = void>
+struct is_tuning_argument : thrust::detail::false_type
+{};
+
+template<typename T>
+struct is_tuning_argument<T, decltype(std::declval<thrust::system::tbb::detail::tuning &>().set(std::declval<T>()))>
+  : thrust::detail::true_type
+{};
+
+void TestTbbTunedPolicyRejectsTemporaryAffinityPartitioner(void)
+{
+  // the policy keeps a pointer to an affinity_partitioner, so it must not be a temporary
+  ASSERT_EQUAL(is_tuning_argument< ::tbb::affinity_partitioner &>::value, true);
+  ASSERT_EQUAL(is_tuning_argument< ::tbb::affinity_partitioner>::value, false);
+  ASSERT_EQUAL(is_tuning_argument< ::tbb::static_partitioner>::value, true);
+  ASSERT_EQUAL(is_tuning_argument<thrust::tbb::grain>::value, true);
+}
+DECLARE_UNITTEST(TestTbbTunedPolicyRejectsTemporaryAffinityPartitioner);
+
+template<typename Policy>
+void check_tuned_algorithms(Policy policy, size_t n)
+{
+  thrust::host_vector<int> h_data = unittest::random_integers<int>(n);
+  thrust::tbb::vector<int> d_data = h_data;
+
+  ASSERT_EQUAL(thrust::reduce(policy, d_data.begin(), d_data.end()),
+               thrust::reduce(h_data.begin(), h_data.end()));
+
+  thrust::host_vector<int> h_scan(n);
+  thrust::tbb::vector<int> d_scan(n);
+  thrust::inclusive_scan(h_data.begin(), h_data.end(), h_scan.begin());
+  thrust::inclusive_scan(policy, d_data.begin(), d_data.end(), d_scan.begin());
+  ASSERT_EQUAL(h_scan, d_scan);
+
+  // segments of various lengths, some spanning many ranges
+  thrust::host_vector<int> h_keys(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    h_keys[i] = static_cast<int>(i / (1 + i % 97));
+  }
+  thrust::tbb::vector<int> d_keys = h_keys;
+
+  thrust::inclusive_scan_by_key(h_keys.begin(), h_keys.end(), h_data.begin(), h_scan.begin());
+  thrust::inclusive_scan_by_key(policy, d_keys.begin(), d_keys.end(), d_data.begin(), d_scan.begin());
+  ASSERT_EQUAL(h_scan, d_scan);
+
+  thrust::exclusive_scan_by_key(h_keys.begin(), h_keys.end(), h_data.begin(), h_scan.begin(), 13);
+  thrust::exclusive_scan_by_key(policy, d_keys.begin(), d_keys.end(), d_data.begin(), d_scan.begin(), 13);
+  ASSERT_EQUAL(h_scan, d_scan);
+
+  // accumulate in long long so that the order of a parallel sum cannot overflow
+  ASSERT_EQUAL(thrust::inner_product(policy, d_data.begin(), d_data.end(), d_keys.begin(), 0LL,
+                                     thrust::plus<long long>(), thrust::minus<long long>()),
+               thrust::inner_product(h_data.begin(), h_data.end(), h_keys.begin(), 0LL,
+                                     thrust::plus<long long>(), thrust::minus<long long>()));
+
+  ASSERT_EQUAL(thrust::transform_reduce(policy, d_data.begin(), d_data.end(), thrust::negate<long long>(), 0LL, thrust::plus<long long>()),
+               thrust::transform_reduce(h_data.begin(), h_data.end(), thrust::negate<long long>(), 0LL, thrust::plus<long long>()));
+
+  thrust::adjacent_difference(h_data.begin(), h_data.end(), h_scan.begin(), thrust::bit_xor<int>());
+  thrust::adjacent_difference(policy, d_data.begin(), d_data.end(), d_scan.begin(), thrust::bit_xor<int>());
+  ASSERT_EQUAL(h_scan, d_scan);
+
+  // in place, each range boundary reads an input that another range overwrites
+  thrust::tbb::vector<int> d_diff = d_data;
+  thrust::adjacent_difference(policy, d_diff.begin(), d_diff.end(), d_diff.begin(), thrust::bit_xor<int>());
+  ASSERT_EQUAL(h_scan, d_diff);
+
+  thrust::sort(h_data.begin(), h_data.end());
+  thrust::sort(policy, d_data.begin(), d_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+
+  thrust::host_vector<int> h_merged(2 * n);
+  thrust::tbb::vector<int> d_merged(2 * n);
+  thrust::merge(h_data.begin(), h_data.end(), h_data.begin(), h_data.end(), h_merged.begin());
+  thrust::merge(policy, d_data.begin(), d_data.end(), d_data.begin(), d_data.end(), d_merged.begin());
+  ASSERT_EQUAL(h_merged, d_merged);
+}
+
+void TestTbbTunedPolicyAlgorithms(size_t n)
+{
+  ::tbb::affinity_partitioner ap;
+
+  check_tuned_algorithms(thrust::tbb::par.with(thrust::tbb::grain(1)), n);
+  check_tuned_algorithms(thrust::tbb::par.with(thrust::tbb::grain(512), ::tbb::static_partitioner()), n);
+  check_tuned_algorithms(thrust::tbb::par.with(thrust::tbb::grain(64), ::tbb::simple_partitioner()), n);
+  check_tuned_algorithms(thrust::tbb::par.with(ap), n);
+}
+DECLARE_SIZED_UNITTEST(TestTbbTunedPolicyAlgorithms);
+
+struct sort_in_arena
+{
+  thrust::tbb::vector<unsigned int> &data;
+
+  void operator()() const
+  {
+    thrust::sort(thrust::tbb::par, data.begin(), data.end());
+  }
+};
+
+void TestTbbSortInTaskArena(size_t n)
+{
+  thrust::host_vector<unsigned int> h_data = unittest::random_integers<unsigned int>(n);
+  thrust::tbb::vector<unsigned int> d_data = h_data;
+
+  // the radix sort splits the input into one tile per thread of the arena
+  ::tbb::task_arena arena(2);
+  sort_in_arena body = {d_data};
+  arena.execute(body);
+
+  thrust::sort(h_data.begin(), h_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+}
+DECLARE_SIZED_UNITTEST(TestTbbSortInTaskArena);
+
+// not a radix sort candidate, so the sort always allocates temporary storage
+struct descending
+{
+  bool operator()(int a, int b) const
+  {
+    return a > b;
+  }
+};
+
+void TestTbbTunedPolicyUsesHostTemporaryCache(void)
+{
+  bool was_enabled = thrust::mr::host_temporary_cache_enabled();
+  thrust::detail::host_temporary_cache & cache = thrust::detail::host_temporary_cache::thread_instance();
+
+  thrust::mr::release_host_temporary_cache();
+  thrust::mr::enable_host_temporary_cache();
+
+  thrust::host_vector<int> h_data = unittest::random_integers<int>(10000);
+  thrust::tbb::vector<int> d_data = h_data;
+
+  // the temporary storage of a tuned policy is cached like the one of the untuned policy
+  thrust::stable_sort(thrust::tbb::par.with(thrust::tbb::grain(1024)), d_data.begin(), d_data.end(), descending());
+  ASSERT_EQUAL(cache.cached_bytes() > 0, true);
+
+  thrust::stable_sort(h_data.begin(), h_data.end(), descending());
+  ASSERT_EQUAL(h_data, d_data);
+
+  thrust::mr::release_host_temporary_cache();
+  thrust::mr::enable_host_temporary_cache(was_enabled);
+}
+DECLARE_UNITTEST(TestTbbTunedPolicyUsesHostTemporaryCache);
@@ -3,6 +3,7 @@
 #include <thrust/detail/config.h>
 #include <thrust/sequence.h>
 #include <thrust/device_malloc_allocator.h>
+#include <thrust/type_traits/is_trivially_relocatable.h>
 
 #if THRUST_CPP_DIALECT >= 2011
 #include <initializer_list>
@@ -10,6 +11,8 @@
 #include <vector>
 #include <list>
 #include <limits>
+#include <memory>
+#include <string>
 #include <utility>
 
 template <class Vector>
@@ -638,6 +641,74 @@ void TestVectorResizing(void)
 }
 DECLARE_VECTOR_UNITTEST(TestVectorResizing);
 
+template <class Vector>
+void TestVectorDefaultInit(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector v(3, thrust::default_init);
+    ASSERT_EQUAL(v.size(), 3lu);
+
+    v[0] = 0; v[1] = 1; v[2] = 2;
+
+    v.resize(5, thrust::default_init);
+    ASSERT_EQUAL(v.size(), 5lu);
+    ASSERT_EQUAL(v[2], T(2));
+
+    // growing beyond the capacity keeps the existing elements
+    v.resize(2 * v.capacity() + 1, thrust::default_init);
+    ASSERT_EQUAL(v[0], T(0));
+    ASSERT_EQUAL(v[1], T(1));
+    ASSERT_EQUAL(v[2], T(2));
+
+    v.resize(2, thrust::default_init);
+    ASSERT_EQUAL(v.size(), 2lu);
+    ASSERT_EQUAL(v[1], T(1));
+
+    Vector w(4, thrust::default_init, typename Vector::allocator_type());
+    ASSERT_EQUAL(w.size(), 4lu);
+}
+DECLARE_VECTOR_UNITTEST(TestVectorDefaultInit);
+
+void TestVectorNoInit(void)
+{
+    thrust::host_vector<int> h(3, thrust::no_init);
+    ASSERT_EQUAL(h.size(), 3lu);
+
+    h[0] = 0; h[1] = 1; h[2] = 2;
+    h.resize(2 * h.capacity() + 1, thrust::no_init);
+    ASSERT_EQUAL(h[2], 2);
+
+    thrust::device_vector<int> d(3, thrust::no_init);
+    thrust::sequence(d.begin(), d.end());
+    d.resize(10, thrust::no_init);
+    ASSERT_EQUAL(d[2], 2);
+}
+DECLARE_UNITTEST(TestVectorNoInit);
+
+struct default_init_counted
+{
+    int value;
+
+    __host__ __device__
+    default_init_counted() : value(42) {}
+};
+
+void TestVectorDefaultInitRunsConstructors(void)
+{
+    // default initialization of a type with a default constructor runs it
+    thrust::host_vector<default_init_counted> h(3, thrust::default_init);
+    ASSERT_EQUAL(h[2].value, 42);
+
+    h.resize(8, thrust::default_init);
+    ASSERT_EQUAL(h[7].value, 42);
+
+    thrust::device_vector<default_init_counted> d(3, thrust::default_init);
+    default_init_counted x = d[2];
+    ASSERT_EQUAL(x.value, 42);
+}
+DECLARE_UNITTEST(TestVectorDefaultInitRunsConstructors);
+
 
 
 template <class Vector>
@@ -671,6 +742,195 @@ DECLARE_VECTOR_UNITTEST(TestVectorReserving)
 
 
 
+template <class Vector>
+void TestVectorEmplaceBack(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector v;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        v.emplace_back(static_cast<T>(i));
+    }
+
+    ASSERT_EQUAL(v.size(), 100lu);
+    for(int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQUAL(v[i], static_cast<T>(i));
+    }
+
+    // the argument may refer to an element when the vector grows
+    v.shrink_to_fit();
+    v.emplace_back(v[1]);
+
+    ASSERT_EQUAL(v.size(), 101lu);
+    ASSERT_EQUAL(v[100], static_cast<T>(1));
+}
+DECLARE_VECTOR_UNITTEST(TestVectorEmplaceBack);
+
+
+template <class Vector>
+void TestVectorEmplace(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector v(3);
+    v[0] = T(0); v[1] = T(1); v[2] = T(2);
+
+    typename Vector::iterator iter = v.emplace(v.begin() + 1, T(5));
+    ASSERT_EQUAL(iter - v.begin(), 1);
+
+    iter = v.emplace(v.end(), T(6));
+    ASSERT_EQUAL(iter - v.begin(), 4);
+
+    iter = v.emplace(v.begin(), v[2]);
+    ASSERT_EQUAL(iter - v.begin(), 0);
+
+    ASSERT_EQUAL(v.size(), 6lu);
+    ASSERT_EQUAL(v[0], T(1));
+    ASSERT_EQUAL(v[1], T(0));
+    ASSERT_EQUAL(v[2], T(5));
+    ASSERT_EQUAL(v[3], T(1));
+    ASSERT_EQUAL(v[4], T(2));
+    ASSERT_EQUAL(v[5], T(6));
+}
+DECLARE_VECTOR_UNITTEST(TestVectorEmplace);
+
+
+struct copy_counted
+{
+    static int copies;
+
+    int value;
+
+    copy_counted(int value) : value(value) {}
+
+    copy_counted(const copy_counted &other) : value(other.value) { ++copies; }
+
+    copy_counted(copy_counted &&other) noexcept : value(other.value) {}
+
+    copy_counted &operator=(const copy_counted &other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+};
+
+int copy_counted::copies = 0;
+
+void TestVectorGrowthMovesElements(void)
+{
+    copy_counted::copies = 0;
+
+    thrust::host_vector<copy_counted> v;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        v.emplace_back(i);
+    }
+
+    v.reserve(1000);
+
+    ASSERT_EQUAL(copy_counted::copies, 0);
+
+    // growing to insert copies the inserted elements, but none of the old ones
+    thrust::host_vector<copy_counted> empty;
+
+    copy_counted::copies = 0;
+    empty.insert(empty.begin(), 1000, copy_counted(-1));
+    const int copies_to_insert = copy_counted::copies;
+
+    copy_counted::copies = 0;
+    v.insert(v.begin() + 50, 1000, copy_counted(-1));
+
+    ASSERT_EQUAL(copy_counted::copies, copies_to_insert);
+
+    ASSERT_EQUAL(v.size(), 1100lu);
+    ASSERT_EQUAL(v[49].value, 49);
+    ASSERT_EQUAL(v[50].value, -1);
+    ASSERT_EQUAL(v[1050].value, 50);
+    ASSERT_EQUAL(v[1099].value, 99);
+}
+DECLARE_UNITTEST(TestVectorGrowthMovesElements);
+
+
+void TestVectorGrowthOfMoveOnlyType(void)
+{
+    thrust::host_vector<std::unique_ptr<int> > v;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        v.emplace_back(new int(i));
+    }
+
+    ASSERT_EQUAL(v.size(), 100lu);
+    for(int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQUAL(*v[i], i);
+    }
+
+    thrust::host_vector<std::pair<std::string, int> > strings;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        strings.emplace_back(std::string(100, 'a' + i % 26), i);
+    }
+
+    ASSERT_EQUAL(strings[99].first, std::string(100, 'a' + 99 % 26));
+    ASSERT_EQUAL(strings[99].second, 99);
+}
+DECLARE_UNITTEST(TestVectorGrowthOfMoveOnlyType);
+
+
+struct relocation_counted
+{
+    static int copies;
+    static int destructions;
+
+    int value;
+
+    relocation_counted(int value) : value(value) {}
+
+    relocation_counted(const relocation_counted &other) : value(other.value) { ++copies; }
+
+    ~relocation_counted() { ++destructions; }
+};
+
+int relocation_counted::copies       = 0;
+int relocation_counted::destructions = 0;
+
+THRUST_PROCLAIM_TRIVIALLY_RELOCATABLE(relocation_counted)
+
+void TestVectorGrowthRelocatesTriviallyRelocatable(void)
+{
+    relocation_counted::copies       = 0;
+    relocation_counted::destructions = 0;
+
+    {
+        thrust::host_vector<relocation_counted> v;
+
+        for(int i = 0; i < 100; ++i)
+        {
+            v.emplace_back(i);
+        }
+
+        // the elements' bytes were copied, so neither their copy constructors
+        // nor destructors ran
+        ASSERT_EQUAL(relocation_counted::copies, 0);
+        ASSERT_EQUAL(relocation_counted::destructions, 0);
+
+        ASSERT_EQUAL(v[0].value, 0);
+        ASSERT_EQUAL(v[99].value, 99);
+    }
+
+    ASSERT_EQUAL(relocation_counted::destructions, 100);
+}
+DECLARE_UNITTEST(TestVectorGrowthRelocatesTriviallyRelocatable);
+
+
+
 template <class Vector>
 void TestVectorUninitialisedCopy(void)
 {
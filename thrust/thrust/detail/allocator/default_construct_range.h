@@ -34,6 +34,13 @@ __host__ __device__
 inline void default_construct_range(Allocator &a, Pointer p, Size n);
 
 
+// like default_construct_range, but leaves elements with a trivial default constructor
+// uninitialized, unless the Allocator constructs them itself
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+inline void default_initialize_range(Allocator &a, Pointer p, Size n);
+
+
 } // end detail
 THRUST_NAMESPACE_END
 
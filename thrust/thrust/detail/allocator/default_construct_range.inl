@@ -102,6 +102,35 @@ __host__ __device__
 }
 
 
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  typename enable_if<
+    needs_default_construct_via_allocator<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    default_initialize_range(Allocator &a, Pointer p, Size n)
+{
+  thrust::for_each_n(allocator_system<Allocator>::get(a), p, n, construct1_via_allocator<Allocator>(a));
+}
+
+
+// default initialization of a trivially constructible type leaves its value indeterminate,
+// so there is nothing to do
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  typename disable_if<
+    needs_default_construct_via_allocator<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    default_initialize_range(Allocator &, Pointer, Size)
+{
+}
+
+
 } // end allocator_traits_detail
 
 
@@ -113,6 +142,14 @@ __host__ __device__
 }
 
 
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  void default_initialize_range(Allocator &a, Pointer p, Size n)
+{
+  return allocator_traits_detail::default_initialize_range(a,p,n);
+}
+
+
 } // end detail
 THRUST_NAMESPACE_END
 
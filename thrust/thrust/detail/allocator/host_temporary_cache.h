@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/integer_math.h>
+#include <thrust/detail/type_traits.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+
+// whether the built-in host systems cache temporary storage by default; can be changed at runtime with
+// thrust::mr::enable_host_temporary_cache
+#ifndef THRUST_HOST_TEMPORARY_CACHE
+#define THRUST_HOST_TEMPORARY_CACHE 0
+#endif
+
+// the most memory the temporary storage cache of a single thread holds on to
+#ifndef THRUST_HOST_TEMPORARY_CACHE_MAX_BYTES
+#define THRUST_HOST_TEMPORARY_CACHE_MAX_BYTES (static_cast<std::size_t>(1) << 28)
+#endif
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace cpp
+{
+namespace detail
+{
+struct tag;
+struct par_t;
+} // end detail
+} // end cpp
+namespace omp
+{
+namespace detail
+{
+struct tag;
+struct par_t;
+struct execute_with_tuning;
+} // end detail
+} // end omp
+namespace tbb
+{
+namespace detail
+{
+struct tag;
+struct par_t;
+struct execute_with_tuning;
+} // end detail
+} // end tbb
+} // end system
+
+namespace detail
+{
+
+
+// the systems whose temporary storage may be cached; only Thrust's own host policies qualify, because
+// user-defined systems derived from them may customize get_temporary_buffer and return_temporary_buffer
+template<typename System>
+struct uses_host_temporary_cache
+  : integral_constant<
+      bool,
+      is_same<System, thrust::system::cpp::detail::tag>::value ||
+      is_same<System, thrust::system::cpp::detail::par_t>::value ||
+      is_same<System, thrust::system::omp::detail::tag>::value ||
+      is_same<System, thrust::system::omp::detail::par_t>::value ||
+      is_same<System, thrust::system::omp::detail::execute_with_tuning>::value ||
+      is_same<System, thrust::system::tbb::detail::tag>::value ||
+      is_same<System, thrust::system::tbb::detail::par_t>::value ||
+      is_same<System, thrust::system::tbb::detail::execute_with_tuning>::value
+    >
+{};
+
+
+// A per-thread cache of temporary storage for the host systems. Repeated invocations of an algorithm
+// on data of similar size reuse the same, already faulted-in, blocks instead of going through malloc
+// (and, for large blocks, mmap and munmap) every time.
+//
+// Requests are rounded up to a size class (a quarter of a power of two), and a cached block is only
+// reused for a request of the same size class. Every block, cached or not, is obtained from std::malloc
+// and starts with a header recording its size class, or zero if it was allocated while the cache was
+// disabled, so a block is always released the way it was allocated, whatever the state of the cache
+// by then, and may be returned by a different thread than the one that allocated it.
+class host_temporary_cache
+{
+  typedef std::multimap<std::size_t, void *> block_map;
+
+  static const std::size_t smallest_size_class = 256;
+
+  // keeps the storage following the header aligned like the one std::malloc returns
+  static const std::size_t header_size = alignof(std::max_align_t);
+
+  static_assert(header_size >= sizeof(std::size_t), "the block header does not fit its size class");
+
+public:
+  host_temporary_cache() : m_cached_bytes(0)
+  {
+  }
+
+  ~host_temporary_cache()
+  {
+    release();
+  }
+
+  static host_temporary_cache &thread_instance()
+  {
+    static thread_local host_temporary_cache cache;
+    return cache;
+  }
+
+  static bool enabled()
+  {
+    return enabled_flag().load(std::memory_order_relaxed);
+  }
+
+  static void set_enabled(bool enabled)
+  {
+    enabled_flag().store(enabled, std::memory_order_relaxed);
+  }
+
+  void *allocate(std::size_t bytes)
+  {
+    if(!enabled())
+    {
+      return make_block(std::malloc(header_size + bytes), 0);
+    }
+
+    std::size_t size = size_class(header_size + bytes);
+
+    block_map::iterator it = m_blocks.find(size);
+    if(it != m_blocks.end())
+    {
+      void *ret = it->second;
+      m_blocks.erase(it);
+      m_cached_bytes -= size;
+      return make_block(ret, size);
+    }
+
+    void *ret = std::malloc(size);
+
+    // the cache may be what's holding on to the memory; retry with an empty one
+    if(!ret && m_cached_bytes)
+    {
+      release();
+      ret = std::malloc(size);
+    }
+
+    return make_block(ret, size);
+  }
+
+  void deallocate(void *ptr)
+  {
+    if(!ptr)
+    {
+      return;
+    }
+
+    void *block = static_cast<char *>(ptr) - header_size;
+    std::size_t size = *static_cast<std::size_t *>(block);
+
+    // blocks allocated while the cache was disabled do not have the size of their size class
+    if(!size || !enabled() || m_cached_bytes + size > THRUST_HOST_TEMPORARY_CACHE_MAX_BYTES)
+    {
+      std::free(block);
+      return;
+    }
+
+    m_blocks.insert(block_map::value_type(size, block));
+    m_cached_bytes += size;
+  }
+
+  // returns all cached blocks to the system
+  void release()
+  {
+    for(block_map::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+    {
+      std::free(it->second);
+    }
+
+    m_blocks.clear();
+    m_cached_bytes = 0;
+  }
+
+  std::size_t cached_bytes() const
+  {
+    return m_cached_bytes;
+  }
+
+  static std::size_t size_class(std::size_t bytes)
+  {
+    if(bytes <= smallest_size_class)
+    {
+      return smallest_size_class;
+    }
+
+    std::size_t step = static_cast<std::size_t>(1) << (thrust::detail::log2(bytes) - 2);
+    return (bytes + step - 1) & ~(step - 1);
+  }
+
+private:
+  static void *make_block(void *block, std::size_t size)
+  {
+    if(!block)
+    {
+      return 0;
+    }
+
+    *static_cast<std::size_t *>(block) = size;
+    return static_cast<char *>(block) + header_size;
+  }
+
+  static std::atomic<bool> &enabled_flag()
+  {
+    static std::atomic<bool> flag(THRUST_HOST_TEMPORARY_CACHE != 0);
+    return flag;
+  }
+
+  block_map m_blocks;
+  std::size_t m_cached_bytes;
+};
+
+
+} // end detail
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,48 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+// relocating n elements from p to result is done in two steps so that nothing
+// can throw after the first element has been released:
+// relocate_construct_range constructs [result, result + n) from the elements of
+// [p, p + n), which stay alive, and relocate_destroy_range then releases them
+
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  inline Pointer relocate_construct_range(Allocator &a, Pointer p, Size n, Pointer result);
+
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  inline void relocate_destroy_range(Allocator &a, Pointer p, Size n);
+
+} // end detail
+THRUST_NAMESPACE_END
+
+#include <thrust/detail/allocator/relocate_range.inl>
+
@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+
+#include <thrust/detail/allocator/relocate_range.h>
+#include <thrust/detail/allocator/allocator_traits.h>
+#include <thrust/detail/allocator/copy_construct_range.h>
+#include <thrust/detail/allocator/destroy_range.h>
+#include <thrust/detail/copy.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/type_traits/pointer_traits.h>
+#include <thrust/iterator/detail/host_system_tag.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/system/detail/sequential/trivial_copy.h>
+#include <thrust/type_traits/is_trivially_relocatable.h>
+#include <thrust/for_each.h>
+#include <thrust/tuple.h>
+#include <thrust/detail/memory_wrapper.h>
+
+#include <type_traits>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+namespace allocator_traits_detail
+{
+
+
+// relocate_construct_range has three cases:
+// 1. if T is trivially relocatable, the allocator neither constructs nor destroys
+//    Ts, and its memory is accessible from the host, copy the bytes; the sources
+//    are then released without running their destructors
+// 2. if T has a trivial copy constructor, copy the range
+// 3. otherwise construct each element from its source via the allocator, moving
+//    unless the move may throw and a copy can be made instead, so that a failure
+//    leaves the sources intact
+
+template<typename Allocator, typename T>
+  struct has_effectful_member_move_construct
+    : has_member_constructN<Allocator,T,T>
+{};
+
+// std::allocator::construct's only effect is to call T's constructor
+template<typename U, typename T>
+  struct has_effectful_member_move_construct<std::allocator<U>, T>
+    : thrust::detail::false_type
+{};
+
+template<typename Allocator, typename T>
+  struct relocates_bitwise
+    : integral_constant<
+        bool,
+        thrust::is_trivially_relocatable<T>::value &&
+        !has_effectful_member_move_construct<Allocator,T>::value &&
+        !has_effectful_member_destroy<Allocator,T>::value &&
+        thrust::detail::is_convertible<
+          typename allocator_system<Allocator>::type,
+          thrust::host_system_tag
+        >::value
+      >
+{};
+
+
+template<typename Allocator, typename T>
+  struct move_if_noexcept_construct_with_allocator
+{
+  typedef typename thrust::detail::conditional<
+    std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value,
+    T &&,
+    const T &
+  >::type source_reference;
+
+  Allocator &a;
+
+  __host__ __device__
+  move_if_noexcept_construct_with_allocator(Allocator &a)
+    : a(a)
+  {}
+
+  __thrust_exec_check_disable__
+  template<typename Tuple>
+  inline __host__ __device__
+  void operator()(Tuple t)
+  {
+    T &in = thrust::get<0>(t);
+    T &out = thrust::get<1>(t);
+
+    allocator_traits<Allocator>::construct(a, &out, static_cast<source_reference>(in));
+  }
+};
+
+
+// relocate_construct_range case 1: copy the bytes
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  typename enable_if<
+    relocates_bitwise<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value,
+    Pointer
+  >::type
+    relocate_construct_range(Allocator &, Pointer p, Size n, Pointer result)
+{
+  typedef typename pointer_element<Pointer>::type T;
+
+  // T needn't be trivially copyable, so copy its representation
+  thrust::system::detail::sequential::trivial_copy_n(reinterpret_cast<const unsigned char *>(thrust::raw_pointer_cast(p)),
+                                                      n * sizeof(T),
+                                                      reinterpret_cast<unsigned char *>(thrust::raw_pointer_cast(result)));
+
+  return result + n;
+}
+
+
+// relocate_construct_range case 2: copy construct
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  typename enable_if<
+    !relocates_bitwise<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value &&
+    !needs_copy_construct_via_allocator<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value,
+    Pointer
+  >::type
+    relocate_construct_range(Allocator &a, Pointer p, Size n, Pointer result)
+{
+  return thrust::detail::two_system_copy_n(allocator_system<Allocator>::get(a), allocator_system<Allocator>::get(a), p, n, result);
+}
+
+
+// relocate_construct_range case 3: move or copy construct via the allocator
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  typename enable_if<
+    !relocates_bitwise<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value &&
+    needs_copy_construct_via_allocator<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value,
+    Pointer
+  >::type
+    relocate_construct_range(Allocator &a, Pointer p, Size n, Pointer result)
+{
+  typedef typename pointer_element<Pointer>::type T;
+
+  typedef thrust::tuple<Pointer,Pointer>       IteratorTuple;
+  typedef thrust::zip_iterator<IteratorTuple> ZipIterator;
+
+  ZipIterator begin = thrust::make_zip_iterator(thrust::make_tuple(p,result));
+
+  ZipIterator end = thrust::for_each_n(allocator_system<Allocator>::get(a), begin, n, move_if_noexcept_construct_with_allocator<Allocator,T>(a));
+
+  return thrust::get<1>(end.get_iterator_tuple());
+}
+
+
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  typename enable_if<
+    relocates_bitwise<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    relocate_destroy_range(Allocator &, Pointer, Size)
+{
+  // the bytes now belong to the new elements
+}
+
+
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  typename disable_if<
+    relocates_bitwise<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    relocate_destroy_range(Allocator &a, Pointer p, Size n)
+{
+  thrust::detail::destroy_range(a, p, n);
+}
+
+
+} // end allocator_traits_detail
+
+
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  Pointer relocate_construct_range(Allocator &a, Pointer p, Size n, Pointer result)
+{
+  return allocator_traits_detail::relocate_construct_range(a, p, n, result);
+}
+
+
+template<typename Allocator, typename Pointer, typename Size>
+__host__ __device__
+  void relocate_destroy_range(Allocator &a, Pointer p, Size n)
+{
+  allocator_traits_detail::relocate_destroy_range(a, p, n);
+}
+
+
+} // end detail
+THRUST_NAMESPACE_END
+
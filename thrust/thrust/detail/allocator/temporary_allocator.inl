@@ -24,6 +24,7 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/detail/allocator/temporary_allocator.h>
+#include <thrust/detail/allocator/host_temporary_cache.h>
 #include <thrust/detail/temporary_buffer.h>
 #include <thrust/system/detail/bad_alloc.h>
 #include <cassert>
@@ -39,6 +40,51 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 THRUST_NAMESPACE_BEGIN
 namespace detail
 {
+namespace temporary_allocator_detail
+{
+
+
+__thrust_exec_check_disable__
+template<typename T, typename System>
+__host__ __device__
+  thrust::pair<thrust::pointer<T,System>, typename thrust::pointer<T,System>::difference_type>
+    get_temporary_buffer(System &system, typename thrust::pointer<T,System>::difference_type n, thrust::detail::false_type)
+{
+  return thrust::get_temporary_buffer<T>(system, n);
+} // end get_temporary_buffer()
+
+
+__thrust_exec_check_disable__
+template<typename T, typename System>
+__host__ __device__
+  thrust::pair<thrust::pointer<T,System>, typename thrust::pointer<T,System>::difference_type>
+    get_temporary_buffer(System &, typename thrust::pointer<T,System>::difference_type n, thrust::detail::true_type)
+{
+  T *ptr = static_cast<T*>(host_temporary_cache::thread_instance().allocate(sizeof(T) * n));
+
+  return thrust::make_pair(thrust::pointer<T,System>(ptr), ptr ? n : 0);
+} // end get_temporary_buffer()
+
+
+__thrust_exec_check_disable__
+template<typename System, typename Pointer>
+__host__ __device__
+  void return_temporary_buffer(System &system, Pointer p, std::ptrdiff_t n, thrust::detail::false_type)
+{
+  thrust::return_temporary_buffer(system, p, n);
+} // end return_temporary_buffer()
+
+
+__thrust_exec_check_disable__
+template<typename System, typename Pointer>
+__host__ __device__
+  void return_temporary_buffer(System &, Pointer p, std::ptrdiff_t, thrust::detail::true_type)
+{
+  host_temporary_cache::thread_instance().deallocate(thrust::raw_pointer_cast(p));
+} // end return_temporary_buffer()
+
+
+} // end temporary_allocator_detail
 
 
 template<typename T, typename System>
@@ -47,7 +93,7 @@ __host__ __device__
     temporary_allocator<T,System>
       ::allocate(typename temporary_allocator<T,System>::size_type cnt)
 {
-  pointer_and_size result = thrust::get_temporary_buffer<T>(system(), cnt);
+  pointer_and_size result = temporary_allocator_detail::get_temporary_buffer<T>(system(), cnt, uses_host_temporary_cache<System>());
 
   // handle failure
   if(result.second < cnt)
@@ -76,7 +122,7 @@ __host__ __device__
   void temporary_allocator<T,System>
     ::deallocate(typename temporary_allocator<T,System>::pointer p, typename temporary_allocator<T,System>::size_type n)
 {
-  return thrust::return_temporary_buffer(system(), p, n);
+  return temporary_allocator_detail::return_temporary_buffer(system(), p, n, uses_host_temporary_cache<System>());
 } // end temporary_allocator
 
 
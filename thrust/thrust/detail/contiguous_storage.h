@@ -121,6 +121,9 @@ template<typename T, typename Alloc>
     __host__ __device__
     void default_construct_n(iterator first, size_type n);
 
+    __host__ __device__
+    void default_initialize_n(iterator first, size_type n);
+
     __host__ __device__
     void uninitialized_fill_n(iterator first, size_type n, const value_type &value);
 
@@ -146,6 +149,19 @@ template<typename T, typename Alloc>
                                   Size n,
                                   iterator result);
 
+    // constructs *result from args
+    template<typename... Args>
+    __host__ __device__
+    void uninitialized_construct(iterator result, Args&&... args);
+
+    // relocates [first,last) in two steps: constructs the range at result,
+    // then destroy_relocated releases the sources
+    __host__ __device__
+    iterator uninitialized_relocate(iterator first, iterator last, iterator result);
+
+    __host__ __device__
+    void destroy_relocated(iterator first, iterator last);
+
     __host__ __device__
     void destroy(iterator first, iterator last);
 
@@ -215,6 +231,15 @@ template<typename T, typename Alloc>
     void destroy_on_allocator_mismatch_dispatch(false_type, const contiguous_storage &other,
         iterator first, iterator last);
 
+    // the first overload constructs in place in memory the host can access
+    template<typename... Args>
+    __host__ __device__
+    void uninitialized_construct_dispatch(true_type, iterator result, Args&&... args);
+
+    template<typename... Args>
+    __host__ __device__
+    void uninitialized_construct_dispatch(false_type, iterator result, Args&&... args);
+
     __host__ __device__
     void propagate_allocator_dispatch(true_type, const contiguous_storage &other);
 
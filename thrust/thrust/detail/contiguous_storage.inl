@@ -30,6 +30,10 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/detail/allocator/default_construct_range.h>
 #include <thrust/detail/allocator/destroy_range.h>
 #include <thrust/detail/allocator/fill_construct_range.h>
+#include <thrust/detail/allocator/relocate_range.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/type_deduction.h>
+#include <thrust/iterator/detail/host_system_tag.h>
 
 #include <nv/target>
 
@@ -262,6 +266,14 @@ __host__ __device__
   default_construct_range(m_allocator, first.base(), n);
 } // end contiguous_storage::default_construct_n()
 
+template<typename T, typename Alloc>
+__host__ __device__
+  void contiguous_storage<T,Alloc>
+    ::default_initialize_n(iterator first, size_type n)
+{
+  default_initialize_range(m_allocator, first.base(), n);
+} // end contiguous_storage::default_initialize_n()
+
 template<typename T, typename Alloc>
 __host__ __device__
   void contiguous_storage<T,Alloc>
@@ -316,6 +328,39 @@ template<typename T, typename Alloc>
   return iterator(copy_construct_range_n(from_system, m_allocator, first, n, result.base()));
 } // end contiguous_storage::uninitialized_copy_n()
 
+template<typename T, typename Alloc>
+  template<typename... Args>
+  __host__ __device__
+    void contiguous_storage<T,Alloc>
+      ::uninitialized_construct(iterator result, Args&&... args)
+{
+  typedef typename allocator_system<Alloc>::type system_type;
+
+  integral_constant<
+    bool,
+    is_convertible<system_type, thrust::host_system_tag>::value
+  > c;
+
+  uninitialized_construct_dispatch(c, result, THRUST_FWD(args)...);
+} // end contiguous_storage::uninitialized_construct()
+
+template<typename T, typename Alloc>
+__host__ __device__
+  typename contiguous_storage<T,Alloc>::iterator
+    contiguous_storage<T,Alloc>
+      ::uninitialized_relocate(iterator first, iterator last, iterator result)
+{
+  return iterator(relocate_construct_range(m_allocator, first.base(), last - first, result.base()));
+} // end contiguous_storage::uninitialized_relocate()
+
+template<typename T, typename Alloc>
+__host__ __device__
+  void contiguous_storage<T,Alloc>
+    ::destroy_relocated(iterator first, iterator last)
+{
+  relocate_destroy_range(m_allocator, first.base(), last - first);
+} // end contiguous_storage::destroy_relocated()
+
 template<typename T, typename Alloc>
 __host__ __device__
   void contiguous_storage<T,Alloc>
@@ -453,6 +498,27 @@ __host__ __device__
   thrust::swap(m_allocator, other);
 } // end contiguous_storage::swap_allocators()
 
+template<typename T, typename Alloc>
+  template<typename... Args>
+  __host__ __device__
+    void contiguous_storage<T,Alloc>
+      ::uninitialized_construct_dispatch(true_type, iterator result, Args&&... args)
+{
+  allocator_traits<Alloc>::construct(m_allocator, thrust::raw_pointer_cast(result.base()), THRUST_FWD(args)...);
+} // end contiguous_storage::uninitialized_construct_dispatch()
+
+template<typename T, typename Alloc>
+  template<typename... Args>
+  __host__ __device__
+    void contiguous_storage<T,Alloc>
+      ::uninitialized_construct_dispatch(false_type, iterator result, Args&&... args)
+{
+  // build the element here and copy it into memory the host can't access
+  value_type x(THRUST_FWD(args)...);
+
+  uninitialized_fill_n(result, 1, x);
+} // end contiguous_storage::uninitialized_construct_dispatch()
+
 template<typename T, typename Alloc>
 __host__ __device__
   bool contiguous_storage<T,Alloc>
@@ -31,6 +31,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/shuffle.h>
 #include <thrust/system/detail/generic/select_system.h>
 #include <thrust/system/detail/generic/shuffle.h>
+#include <thrust/system/detail/adl/shuffle.h>
 
 THRUST_NAMESPACE_BEGIN
 
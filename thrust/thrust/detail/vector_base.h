@@ -41,9 +41,50 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 
 THRUST_NAMESPACE_BEGIN
 
+/*! \addtogroup container_classes Container Classes
+ *  \{
+ */
+
+/*! \p default_init_t is the type of \p default_init, which requests that
+ *  the elements a vector constructor or \p resize creates are default
+ *  initialized rather than value initialized: elements with a trivial
+ *  default constructor, such as numbers, are left uninitialized instead of
+ *  being set to zero.
+ */
+struct default_init_t {};
+
+/*! \p default_init requests default initialization of the elements created
+ *  by a vector constructor or \p resize.
+ *
+ *  \code
+ *  thrust::host_vector<float> v(n, thrust::default_init); // not zeroed
+ *  thrust::transform(input.begin(), input.end(), v.begin(), op);
+ *  \endcode
+ */
+THRUST_INLINE_CONSTANT default_init_t default_init{};
+
+/*! \p no_init_t is the type of \p no_init, which requests that the
+ *  elements a vector constructor or \p resize creates are left
+ *  uninitialized. It's only accepted for element types with a trivial
+ *  default constructor, for which it means the same as \p default_init.
+ */
+struct no_init_t {};
+
+/*! \p no_init requests that the elements created by a vector constructor or
+ *  \p resize are left uninitialized; they must be written before they are
+ *  read.
+ */
+THRUST_INLINE_CONSTANT no_init_t no_init{};
+
+/*! \}
+ */
+
 namespace detail
 {
 
+// requests value initialization of new elements, which is what vector_base does by default
+struct value_init_t {};
+
 template<typename T, typename Alloc>
   class vector_base
 {
@@ -89,6 +130,34 @@ template<typename T, typename Alloc>
      */
     explicit vector_base(size_type n, const Alloc &alloc);
 
+    /*! This constructor creates a vector_base with default-initialized
+     *  elements, which are left uninitialized if they have a trivial
+     *  default constructor.
+     *  \param n The number of elements to create.
+     */
+    vector_base(size_type n, default_init_t);
+
+    /*! This constructor creates a vector_base with default-initialized
+     *  elements, which are left uninitialized if they have a trivial
+     *  default constructor.
+     *  \param n The number of elements to create.
+     *  \param alloc The allocator to use by this vector_base.
+     */
+    vector_base(size_type n, default_init_t, const Alloc &alloc);
+
+    /*! This constructor creates a vector_base with uninitialized elements.
+     *  The element type must have a trivial default constructor.
+     *  \param n The number of elements to create.
+     */
+    vector_base(size_type n, no_init_t);
+
+    /*! This constructor creates a vector_base with uninitialized elements.
+     *  The element type must have a trivial default constructor.
+     *  \param n The number of elements to create.
+     *  \param alloc The allocator to use by this vector_base.
+     */
+    vector_base(size_type n, no_init_t, const Alloc &alloc);
+
     /*! This constructor creates a vector_base with copies
      *  of an exemplar element.
      *  \param n The number of elements to initially create.
@@ -227,6 +296,30 @@ template<typename T, typename Alloc>
      */
     void resize(size_type new_size, const value_type &x);
 
+    /*! \brief Resizes this vector_base to the specified number of elements.
+     *  \param new_size Number of elements this vector_base should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector_base to the specified number of
+     *  elements. If the number is smaller than this vector_base's current
+     *  size this vector_base is truncated, otherwise this vector_base is
+     *  extended and new elements are default initialized: they are left
+     *  uninitialized if they have a trivial default constructor.
+     */
+    void resize(size_type new_size, default_init_t);
+
+    /*! \brief Resizes this vector_base to the specified number of elements.
+     *  \param new_size Number of elements this vector_base should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector_base to the specified number of
+     *  elements. If the number is smaller than this vector_base's current
+     *  size this vector_base is truncated, otherwise this vector_base is
+     *  extended and new elements are left uninitialized. The element type
+     *  must have a trivial default constructor.
+     */
+    void resize(size_type new_size, no_init_t);
+
     /*! Returns the number of elements in this vector_base.
      */
     __host__ __device__
@@ -421,6 +514,13 @@ template<typename T, typename Alloc>
      */
     void push_back(const value_type &x);
 
+    /*! This method appends an element constructed in place from the given
+     *  arguments to the end of this vector_base.
+     *  \param args The arguments to forward to the constructor of the new element.
+     */
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
     /*! This method erases the last element of this vector_base, invalidating
      *  all iterators and references to it.
      */
@@ -454,6 +554,15 @@ template<typename T, typename Alloc>
      */
     iterator insert(iterator position, const T &x);
 
+    /*! This method inserts an element constructed from the given arguments
+     *  at the specified position in this vector_base.
+     *  \param position The insertion position.
+     *  \param args The arguments to forward to the constructor of the new element.
+     *  \return An iterator pointing to the newly inserted element.
+     */
+    template<typename... Args>
+    iterator emplace(iterator position, Args&&... args);
+
     /*! This method inserts a copy of an exemplar value to a range at the
      *  specified position in this vector_base.
      *  \param position The insertion position
@@ -519,7 +628,8 @@ template<typename T, typename Alloc>
     template<typename ForwardIterator>
       void range_init(ForwardIterator first, ForwardIterator last, thrust::random_access_traversal_tag);
 
-    void default_init(size_type n);
+    template<typename Init>
+      void default_init(size_type n, Init init);
 
     void fill_init(size_type n, const T &x);
 
@@ -531,8 +641,14 @@ template<typename T, typename Alloc>
     template<typename InputIteratorOrIntegralType>
       void insert_dispatch(iterator position, InputIteratorOrIntegralType n, InputIteratorOrIntegralType x, true_type);
 
-    // this method appends n default-constructed elements at the end
-    void append(size_type n);
+    // this method appends n value-initialized or default-initialized elements at the end
+    template<typename Init>
+      void append(size_type n, Init init);
+
+    // these methods value-initialize or default-initialize n elements of some storage
+    static void construct_n(storage_type &storage, iterator first, size_type n, value_init_t);
+
+    static void construct_n(storage_type &storage, iterator first, size_type n, default_init_t);
 
     // this method performs insertion from a fill value
     void fill_insert(iterator position, size_type n, const T &x);
@@ -33,6 +33,8 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/detail/minmax.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_deduction.h>
+#include <thrust/detail/static_assert.h>
 
 #include <stdexcept>
 
@@ -65,7 +67,7 @@ template<typename T, typename Alloc>
       :m_storage(),
        m_size(0)
 {
-  default_init(n);
+  default_init(n, value_init_t());
 } // end vector_base::vector_base()
 
 template<typename T, typename Alloc>
@@ -74,7 +76,49 @@ template<typename T, typename Alloc>
       :m_storage(alloc),
        m_size(0)
 {
-  default_init(n);
+  default_init(n, value_init_t());
+} // end vector_base::vector_base()
+
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(size_type n, default_init_t)
+      :m_storage(),
+       m_size(0)
+{
+  default_init(n, default_init_t());
+} // end vector_base::vector_base()
+
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(size_type n, default_init_t, const Alloc &alloc)
+      :m_storage(alloc),
+       m_size(0)
+{
+  default_init(n, default_init_t());
+} // end vector_base::vector_base()
+
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(size_type n, no_init_t)
+      :m_storage(),
+       m_size(0)
+{
+  THRUST_STATIC_ASSERT_MSG(thrust::detail::has_trivial_constructor<T>::value,
+                           "thrust::no_init requires an element type with a trivial default constructor");
+
+  default_init(n, default_init_t());
+} // end vector_base::vector_base()
+
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(size_type n, no_init_t, const Alloc &alloc)
+      :m_storage(alloc),
+       m_size(0)
+{
+  THRUST_STATIC_ASSERT_MSG(thrust::detail::has_trivial_constructor<T>::value,
+                           "thrust::no_init requires an element type with a trivial default constructor");
+
+  default_init(n, default_init_t());
 } // end vector_base::vector_base()
 
 template<typename T, typename Alloc>
@@ -240,15 +284,16 @@ template<typename T, typename Alloc>
 } // end vector_base::init_dispatch()
 
 template<typename T, typename Alloc>
-  void vector_base<T,Alloc>
-    ::default_init(size_type n)
+  template<typename Init>
+    void vector_base<T,Alloc>
+      ::default_init(size_type n, Init init)
 {
   if(n > 0)
   {
     m_storage.allocate(n);
     m_size = n;
 
-    m_storage.default_construct_n(begin(), size());
+    construct_n(m_storage, begin(), size(), init);
   } // end if
 } // end vector_base::default_init()
 
@@ -352,10 +397,36 @@ template<typename T, typename Alloc>
   } // end if
   else
   {
-    append(new_size - size());
+    append(new_size - size(), value_init_t());
   } // end else
 } // end vector_base::resize()
 
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::resize(size_type new_size, default_init_t)
+{
+  if(new_size < size())
+  {
+    iterator new_end = begin();
+    thrust::advance(new_end, new_size);
+    erase(new_end, end());
+  } // end if
+  else
+  {
+    append(new_size - size(), default_init_t());
+  } // end else
+} // end vector_base::resize()
+
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::resize(size_type new_size, no_init_t)
+{
+  THRUST_STATIC_ASSERT_MSG(thrust::detail::has_trivial_constructor<T>::value,
+                           "thrust::no_init requires an element type with a trivial default constructor");
+
+  resize(new_size, default_init_t());
+} // end vector_base::resize()
+
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::resize(size_type new_size, const value_type &x)
@@ -410,8 +481,8 @@ template<typename T, typename Alloc>
 
     try
     {
-      // construct copy all elements into the newly allocated storage
-      new_end = m_storage.uninitialized_copy(begin(), end(), new_storage.begin());
+      // relocate all elements into the newly allocated storage
+      new_end = m_storage.uninitialized_relocate(begin(), end(), new_storage.begin());
     } // end try
     catch(...)
     {
@@ -423,8 +494,8 @@ template<typename T, typename Alloc>
       throw;
     } // end catch
 
-    // call destructors on the elements in the old storage
-    m_storage.destroy(begin(), end());
+    // release the elements in the old storage
+    m_storage.destroy_relocated(begin(), end());
 
     // record the vector's new state
     m_storage.swap(new_storage);
@@ -667,6 +738,71 @@ template<typename T, typename Alloc>
   insert(end(), x);
 } // end vector_base::push_back()
 
+template<typename T, typename Alloc>
+  template<typename... Args>
+    void vector_base<T,Alloc>
+      ::emplace_back(Args&&... args)
+{
+  if(size() < capacity())
+  {
+    // we've got room for it
+    m_storage.uninitialized_construct(end(), THRUST_FWD(args)...);
+    ++m_size;
+  } // end if
+  else
+  {
+    const size_type old_size = size();
+
+    // compute the new capacity after the allocation
+    size_type new_capacity = old_size + thrust::max THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(old_size, 1);
+
+    // allocate exponentially larger new storage
+    new_capacity = thrust::max THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(new_capacity, 2 * capacity());
+
+    // do not exceed maximum storage
+    new_capacity = thrust::min THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(new_capacity, max_size());
+
+    if(old_size == new_capacity)
+    {
+      throw std::length_error("emplace_back(): insertion exceeds max_size().");
+    } // end if
+
+    storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
+
+    // record which constructors we invoke in the try block below
+    iterator new_first = new_storage.begin() + old_size;
+    iterator new_end   = new_first;
+
+    try
+    {
+      // construct the new element first, while any of the old elements which
+      // args refer to are still in place
+      m_storage.uninitialized_construct(new_end, THRUST_FWD(args)...);
+      ++new_end;
+
+      // relocate the old elements in front of it
+      m_storage.uninitialized_relocate(begin(), end(), new_storage.begin());
+      new_first = new_storage.begin();
+    } // end try
+    catch(...)
+    {
+      // something went wrong, so destroy & deallocate the new storage
+      new_storage.destroy(new_first, new_end);
+      new_storage.deallocate();
+
+      // rethrow
+      throw;
+    } // end catch
+
+    // release the elements in the old storage
+    m_storage.destroy_relocated(begin(), end());
+
+    // record the vector's new state
+    m_storage.swap(new_storage);
+    m_size = old_size + 1;
+  } // end else
+} // end vector_base::emplace_back()
+
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::pop_back(void)
@@ -758,6 +894,34 @@ template<typename T, typename Alloc>
   return result;
 } // end vector_base::insert()
 
+template<typename T, typename Alloc>
+  template<typename... Args>
+    typename vector_base<T,Alloc>::iterator
+      vector_base<T,Alloc>
+        ::emplace(iterator position, Args&&... args)
+{
+  // find the index of the insertion
+  size_type index = thrust::distance(begin(), position);
+
+  if(position == end())
+  {
+    emplace_back(THRUST_FWD(args)...);
+  } // end if
+  else
+  {
+    // the elements after position have to shift, so build the new one
+    // before any of those which args may refer to move
+    value_type x(THRUST_FWD(args)...);
+
+    insert(position, 1, x);
+  } // end else
+
+  // return an iterator pointing back to position
+  iterator result = begin();
+  thrust::advance(result, index);
+  return result;
+} // end vector_base::emplace()
+
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::insert(iterator position, size_type n, const T &x)
@@ -885,34 +1049,37 @@ template<typename T, typename Alloc>
 
       storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
 
-      // record how many constructors we invoke in the try block below
-      iterator new_end = new_storage.begin();
+      // record which constructors we invoke in the try block below
+      iterator new_first = new_storage.begin() + (position - begin());
+      iterator new_end   = new_first;
 
       try
       {
-        // construct copy elements before the insertion to the beginning of the newly
-        // allocated storage
-        new_end = m_storage.uninitialized_copy(begin(), position, new_storage.begin());
-
-        // construct copy elements to insert
+        // construct copy elements to insert first, while any of the old elements
+        // they come from are still in place
         new_end = m_storage.uninitialized_copy(first, last, new_end);
 
-        // construct copy displaced elements from the old storage to the new storage
+        // relocate displaced elements from the old storage to the new storage
         // remember [position, end()) refers to the old storage
-        new_end = m_storage.uninitialized_copy(position, end(), new_end);
+        new_end = m_storage.uninitialized_relocate(position, end(), new_end);
+
+        // relocate elements before the insertion to the beginning of the newly
+        // allocated storage
+        m_storage.uninitialized_relocate(begin(), position, new_storage.begin());
+        new_first = new_storage.begin();
       } // end try
       catch(...)
       {
         // something went wrong, so destroy & deallocate the new storage
-        m_storage.destroy(new_storage.begin(), new_end);
+        m_storage.destroy(new_first, new_end);
         new_storage.deallocate();
 
         // rethrow
         throw;
       } // end catch
 
-      // call destructors on the elements in the old storage
-      m_storage.destroy(begin(), end());
+      // release the elements in the old storage
+      m_storage.destroy_relocated(begin(), end());
 
       // record the vector's new state
       m_storage.swap(new_storage);
@@ -923,7 +1090,22 @@ template<typename T, typename Alloc>
 
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
-    ::append(size_type n)
+    ::construct_n(storage_type &storage, iterator first, size_type n, value_init_t)
+{
+  storage.default_construct_n(first, n);
+} // end vector_base::construct_n()
+
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::construct_n(storage_type &storage, iterator first, size_type n, default_init_t)
+{
+  storage.default_initialize_n(first, n);
+} // end vector_base::construct_n()
+
+template<typename T, typename Alloc>
+  template<typename Init>
+    void vector_base<T,Alloc>
+      ::append(size_type n, Init init)
 {
   if(n != 0)
   {
@@ -931,8 +1113,8 @@ template<typename T, typename Alloc>
     {
       // we've got room for all of them
 
-      // default construct new elements at the end of the vector
-      m_storage.default_construct_n(end(), n);
+      // initialize new elements at the end of the vector
+      construct_n(m_storage, end(), n, init);
 
       // extend the size
       m_size += n;
@@ -953,30 +1135,32 @@ template<typename T, typename Alloc>
       // create new storage
       storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
 
-      // record how many constructors we invoke in the try block below
-      iterator new_end = new_storage.begin();
+      // record which constructors we invoke in the try block below
+      iterator new_first = new_storage.begin() + old_size;
+      iterator new_end   = new_first;
 
       try
       {
-        // construct copy all elements into the newly allocated storage
-        new_end = m_storage.uninitialized_copy(begin(), end(), new_storage.begin());
-
         // construct new elements to insert
-        new_storage.default_construct_n(new_end, n);
+        construct_n(new_storage, new_end, n, init);
         new_end += n;
+
+        // relocate all elements in front of them
+        m_storage.uninitialized_relocate(begin(), end(), new_storage.begin());
+        new_first = new_storage.begin();
       } // end try
       catch(...)
       {
         // something went wrong, so destroy & deallocate the new storage
-        new_storage.destroy(new_storage.begin(), new_end);
+        new_storage.destroy(new_first, new_end);
         new_storage.deallocate();
 
         // rethrow
         throw;
       } // end catch
 
-      // call destructors on the elements in the old storage
-      m_storage.destroy(begin(), end());
+      // release the elements in the old storage
+      m_storage.destroy_relocated(begin(), end());
 
       // record the vector's new state
       m_storage.swap(new_storage);
@@ -1053,35 +1237,38 @@ template<typename T, typename Alloc>
 
       storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
 
-      // record how many constructors we invoke in the try block below
-      iterator new_end = new_storage.begin();
+      // record which constructors we invoke in the try block below
+      iterator new_first = new_storage.begin() + (position - begin());
+      iterator new_end   = new_first;
 
       try
       {
-        // construct copy elements before the insertion to the beginning of the newly
-        // allocated storage
-        new_end = m_storage.uninitialized_copy(begin(), position, new_storage.begin());
-
-        // construct new elements to insert
+        // construct new elements to insert first, while x is still in place
+        // should it refer to an old element
         m_storage.uninitialized_fill_n(new_end, n, x);
         new_end += n;
 
-        // construct copy displaced elements from the old storage to the new storage
+        // relocate displaced elements from the old storage to the new storage
         // remember [position, end()) refers to the old storage
-        new_end = m_storage.uninitialized_copy(position, end(), new_end);
+        new_end = m_storage.uninitialized_relocate(position, end(), new_end);
+
+        // relocate elements before the insertion to the beginning of the newly
+        // allocated storage
+        m_storage.uninitialized_relocate(begin(), position, new_storage.begin());
+        new_first = new_storage.begin();
       } // end try
       catch(...)
       {
         // something went wrong, so destroy & deallocate the new storage
-        m_storage.destroy(new_storage.begin(), new_end);
+        m_storage.destroy(new_first, new_end);
         new_storage.deallocate();
 
         // rethrow
         throw;
       } // end catch
 
-      // call destructors on the elements in the old storage
-      m_storage.destroy(begin(), end());
+      // release the elements in the old storage
+      m_storage.destroy_relocated(begin(), end());
 
       // record the vector's new state
       m_storage.swap(new_storage);
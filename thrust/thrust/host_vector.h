@@ -107,6 +107,44 @@ template<typename T, typename Alloc = std::allocator<T> >
     explicit host_vector(size_type n, const Alloc &alloc)
       :Parent(n,alloc) {}
 
+    /*! This constructor creates a \p host_vector with the given size and
+     *  default-initialized elements: elements with a trivial default
+     *  constructor are left uninitialized instead of being set to zero.
+     *  \param n The number of elements to initially create.
+     */
+    __host__
+    host_vector(size_type n, default_init_t)
+      :Parent(n,default_init_t()) {}
+
+    /*! This constructor creates a \p host_vector with the given size and
+     *  default-initialized elements: elements with a trivial default
+     *  constructor are left uninitialized instead of being set to zero.
+     *  \param n The number of elements to initially create.
+     *  \param alloc The allocator to use by this host_vector.
+     */
+    __host__
+    host_vector(size_type n, default_init_t, const Alloc &alloc)
+      :Parent(n,default_init_t(),alloc) {}
+
+    /*! This constructor creates a \p host_vector with the given size and
+     *  uninitialized elements. The element type must have a trivial default
+     *  constructor.
+     *  \param n The number of elements to initially create.
+     */
+    __host__
+    host_vector(size_type n, no_init_t)
+      :Parent(n,no_init_t()) {}
+
+    /*! This constructor creates a \p host_vector with the given size and
+     *  uninitialized elements. The element type must have a trivial default
+     *  constructor.
+     *  \param n The number of elements to initially create.
+     *  \param alloc The allocator to use by this host_vector.
+     */
+    __host__
+    host_vector(size_type n, no_init_t, const Alloc &alloc)
+      :Parent(n,no_init_t(),alloc) {}
+
     /*! This constructor creates a \p host_vector with copies
      *  of an exemplar element.
      *  \param n The number of elements to initially create.
@@ -278,6 +316,30 @@ template<typename T, typename Alloc = std::allocator<T> >
      */
     void resize(size_type new_size, const value_type &x = value_type());
 
+    /*! \brief Resizes this vector to the specified number of elements.
+     *  \param new_size Number of elements this vector should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector to the specified number of
+     *  elements.  If the number is smaller than this vector's current
+     *  size this vector is truncated, otherwise this vector is
+     *  extended and new elements are default initialized: elements with a
+     *  trivial default constructor are left uninitialized.
+     */
+    void resize(size_type new_size, default_init_t);
+
+    /*! \brief Resizes this vector to the specified number of elements.
+     *  \param new_size Number of elements this vector should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector to the specified number of
+     *  elements.  If the number is smaller than this vector's current
+     *  size this vector is truncated, otherwise this vector is
+     *  extended and new elements are left uninitialized. The element type
+     *  must have a trivial default constructor.
+     */
+    void resize(size_type new_size, no_init_t);
+
     /*! Returns the number of elements in this vector.
      */
     size_type size(void) const;
@@ -448,6 +510,13 @@ template<typename T, typename Alloc = std::allocator<T> >
      */
     void push_back(const value_type &x);
 
+    /*! This method appends an element constructed in place from the given
+     *  arguments to the end of this vector.
+     *  \param args The arguments to forward to the constructor of the new element.
+     */
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
     /*! This method erases the last element of this vector, invalidating
      *  all iterators and references to it.
      */
@@ -481,6 +550,15 @@ template<typename T, typename Alloc = std::allocator<T> >
      */
     iterator insert(iterator position, const T &x);
 
+    /*! This method inserts an element constructed from the given arguments
+     *  at the specified position in this vector.
+     *  \param position The insertion position.
+     *  \param args The arguments to forward to the constructor of the new element.
+     *  \return An iterator pointing to the newly inserted element.
+     */
+    template<typename... Args>
+    iterator emplace(iterator position, Args&&... args);
+
     /*! This method inserts a copy of an exemplar value to a range at the
      *  specified position in this vector.
      *  \param position The insertion position
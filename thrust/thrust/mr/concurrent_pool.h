@@ -0,0 +1,566 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A pool resource with per-thread caches and lock-free shared free lists.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <thrust/mr/pool.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+// hands out small, dense indices to the threads using concurrent pools; the index of a thread that has
+// exited is reused by the next thread that asks for one, so that the per-thread state of the pools is
+// bounded by the number of live threads rather than by the number of threads ever created (and so that
+// the blocks cached for an exited thread are picked up again instead of being stranded)
+class concurrent_pool_thread_registry
+{
+public:
+    static std::size_t acquire()
+    {
+        registry & r = instance();
+        std::lock_guard<std::mutex> lock(r.mtx);
+
+        if (r.free_indices.empty())
+        {
+            return r.next++;
+        }
+
+        std::size_t ret = r.free_indices.back();
+        r.free_indices.pop_back();
+        return ret;
+    }
+
+    static void release(std::size_t index)
+    {
+        registry & r = instance();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        r.free_indices.push_back(index);
+    }
+
+private:
+    struct registry
+    {
+        registry() : next(0)
+        {
+        }
+
+        std::mutex mtx;
+        std::vector<std::size_t> free_indices;
+        std::size_t next;
+    };
+
+    static registry & instance()
+    {
+        static registry r;
+        return r;
+    }
+};
+
+inline std::size_t concurrent_pool_thread_index()
+{
+    struct thread_index
+    {
+        thread_index() : value(concurrent_pool_thread_registry::acquire())
+        {
+        }
+
+        ~thread_index()
+        {
+            concurrent_pool_thread_registry::release(value);
+        }
+
+        std::size_t value;
+    };
+
+    static thread_local thread_index index;
+    return index.value;
+}
+
+// a table growing in segments of doubling size; elements never move, so lookups of already existing
+// elements don't need to synchronize with growth. growing itself must be externally synchronized.
+template<typename T>
+class concurrent_segment_table
+{
+    static const std::size_t first_segment_size = 16;
+    static const std::size_t max_segments = 48;
+
+public:
+    explicit concurrent_segment_table(std::size_t stride = 1) : m_stride(stride)
+    {
+        for (std::size_t i = 0; i < max_segments; ++i)
+        {
+            m_segments[i].store(NULL, std::memory_order_relaxed);
+        }
+    }
+
+    ~concurrent_segment_table()
+    {
+        for (std::size_t i = 0; i < max_segments; ++i)
+        {
+            delete[] m_segments[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // returns NULL if the element hasn't been created by grow() yet
+    T * find(std::size_t index) const
+    {
+        std::size_t segment, offset;
+        locate(index, segment, offset);
+
+        T * ptr = m_segments[segment].load(std::memory_order_acquire);
+        return ptr ? ptr + offset * m_stride : NULL;
+    }
+
+    T * grow(std::size_t index)
+    {
+        std::size_t segment, offset;
+        locate(index, segment, offset);
+
+        T * ptr = m_segments[segment].load(std::memory_order_relaxed);
+        if (!ptr)
+        {
+            ptr = new T[segment_size(segment) * m_stride]();
+            m_segments[segment].store(ptr, std::memory_order_release);
+        }
+
+        return ptr + offset * m_stride;
+    }
+
+    std::size_t segment_count() const
+    {
+        return max_segments;
+    }
+
+    // the elements of the given segment, or NULL if it hasn't been allocated
+    T * segment(std::size_t i) const
+    {
+        return m_segments[i].load(std::memory_order_acquire);
+    }
+
+    std::size_t segment_size(std::size_t i) const
+    {
+        return first_segment_size << i;
+    }
+
+private:
+    static void locate(std::size_t index, std::size_t & segment, std::size_t & offset)
+    {
+        segment = thrust::detail::log2(index / first_segment_size + 1);
+        offset = index - first_segment_size * ((static_cast<std::size_t>(1) << segment) - 1);
+    }
+
+    std::size_t m_stride;
+    std::atomic<T *> m_segments[max_segments];
+};
+
+} // end detail
+
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A thread-safe version of \p unsynchronized_pool_resource, designed for many threads allocating and deallocating
+ *      concurrently. Unlike \p synchronized_pool_resource, which serializes every request on a single mutex, the common
+ *      paths of this resource take no locks at all.
+ *
+ *  Every thread keeps, for every pool (block size class), two magazines: small arrays of free blocks it can allocate
+ *      from and deallocate to without any synchronization. When both of a thread's magazines run empty (or full), it
+ *      exchanges one of them with the shared depot of the pool, a lock-free stack of full magazines (whose head is tagged
+ *      with a version counter, to avoid the ABA problem). Only when the depot is empty as well, a mutex is taken to carve
+ *      new blocks out of chunks allocated from upstream; oversized and overaligned allocations also take the mutex.
+ *
+ *  Chunking of upstream allocations, the handling of oversized and overaligned requests and their caching follow
+ *      \p pool_options exactly like \p unsynchronized_pool_resource, which is used internally to implement those slow
+ *      paths. As a consequence of per-thread caching, a block deallocated by one thread is not immediately available to
+ *      other threads, and a bounded number of blocks per pool is held in each thread's magazines.
+ *
+ *  \p release and the destructor must not be called concurrently with any other operation on the resource.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory blocks
+ */
+template<typename Upstream>
+class concurrent_pool_resource final : public memory_resource<typename Upstream::pointer>
+{
+    typedef unsynchronized_pool_resource<Upstream> unsync_pool;
+    typedef std::lock_guard<std::mutex> lock_t;
+
+    typedef typename Upstream::pointer void_ptr;
+
+    static const std::size_t max_magazine_rounds = 32;
+    static const std::size_t max_magazine_bytes = static_cast<std::size_t>(1) << 16;
+
+    // magazines are referred to by handles, their index in m_magazines plus one, so that a handle and a version
+    // counter fit together in the single word that is the head of a lock-free stack
+    typedef std::uint32_t magazine_handle;
+
+    struct magazine
+    {
+        std::atomic<magazine_handle> next;
+        std::size_t count;
+        void_ptr rounds[max_magazine_rounds];
+    };
+
+    struct thread_cache
+    {
+        magazine_handle loaded;
+        magazine_handle previous;
+    };
+
+public:
+    /*! Get the default options for a pool. These are meant to be a sensible set of values for many use cases,
+     *      and as such, may be tuned in the future. This function is exposed so that creating a set of options that are
+     *      just a slight departure from the defaults is easy.
+     */
+    static pool_options get_default_options()
+    {
+        return unsync_pool::get_default_options();
+    }
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param options pool options to use
+     */
+    concurrent_pool_resource(Upstream * upstream, pool_options options = get_default_options())
+        : m_options(options),
+        m_smallest_block_log2(thrust::detail::log2_ri(m_options.smallest_block_size)),
+        m_pool_count(thrust::detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1),
+        m_pool(upstream, options),
+        m_full(new std::atomic<std::uint64_t>[m_pool_count]),
+        m_empty(0),
+        m_magazine_count(0),
+        m_thread_caches(m_pool_count)
+    {
+        for (std::size_t i = 0; i < m_pool_count; ++i)
+        {
+            m_full[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param options pool options to use
+     */
+    concurrent_pool_resource(pool_options options = get_default_options())
+        : concurrent_pool_resource(get_global_resource<Upstream>(), options)
+    {
+    }
+
+    /*! Destructor. Releases all held memory to upstream.
+     */
+    ~concurrent_pool_resource()
+    {
+        delete[] m_full;
+    }
+
+    /*! Releases all held memory to upstream. Blocks cached by any thread are discarded.
+     */
+    void release()
+    {
+        lock_t lock(m_mtx);
+
+        for (std::size_t i = 0; i < m_pool_count; ++i)
+        {
+            m_full[i].store(0, std::memory_order_relaxed);
+        }
+
+        // every magazine becomes empty; the ones not loaded by any thread go back to the stack of empty ones
+        m_empty.store(0, std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < m_magazine_count; ++i)
+        {
+            m_magazines.find(i)->count = 0;
+        }
+
+        std::vector<bool> loaded(m_magazine_count, false);
+        for (std::size_t s = 0; s < m_thread_caches.segment_count(); ++s)
+        {
+            thread_cache * caches = m_thread_caches.segment(s);
+            if (!caches)
+            {
+                continue;
+            }
+
+            for (std::size_t i = 0; i < m_thread_caches.segment_size(s) * m_pool_count; ++i)
+            {
+                if (caches[i].loaded)
+                {
+                    loaded[caches[i].loaded - 1] = true;
+                }
+                if (caches[i].previous)
+                {
+                    loaded[caches[i].previous - 1] = true;
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < m_magazine_count; ++i)
+        {
+            if (!loaded[i])
+            {
+                push(m_empty, static_cast<magazine_handle>(i + 1));
+            }
+        }
+
+        m_pool.release();
+    }
+
+    /*! Returns idle memory to upstream, the least recently used first, until at most \p bytes_to_keep bytes of it are
+     *      left. Blocks cached by threads are not idle memory, and keep the chunks they belong to from being returned.
+     *
+     *  \param bytes_to_keep the number of bytes of idle memory to keep for future allocations
+     */
+    void trim(std::size_t bytes_to_keep = 0)
+    {
+        lock_t lock(m_mtx);
+        m_pool.trim(bytes_to_keep);
+    }
+
+    /*! Returns the number of bytes of idle memory held by the underlying pool. Blocks cached by threads are not counted.
+     */
+    std::size_t cached_bytes() const
+    {
+        lock_t lock(m_mtx);
+        return m_pool.cached_bytes();
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        bytes = (std::max)(bytes, m_options.smallest_block_size);
+        assert(thrust::detail::is_power_of_2(alignment));
+
+        if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
+        {
+            lock_t lock(m_mtx);
+            return m_pool.do_allocate(bytes, alignment);
+        }
+
+        std::size_t bytes_log2 = thrust::detail::log2_ri(bytes);
+        std::size_t pool_idx = bytes_log2 - m_smallest_block_log2;
+        thread_cache & cache = get_thread_cache(pool_idx);
+
+        if (!cache.loaded || get(cache.loaded).count == 0)
+        {
+            refill(cache, pool_idx, bytes_log2);
+        }
+
+        magazine & loaded = get(cache.loaded);
+        return loaded.rounds[--loaded.count];
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        n = (std::max)(n, m_options.smallest_block_size);
+        assert(thrust::detail::is_power_of_2(alignment));
+
+        if (n > m_options.largest_block_size || alignment > m_options.alignment)
+        {
+            lock_t lock(m_mtx);
+            m_pool.do_deallocate(p, n, alignment);
+            return;
+        }
+
+        std::size_t n_log2 = thrust::detail::log2_ri(n);
+        std::size_t pool_idx = n_log2 - m_smallest_block_log2;
+        thread_cache & cache = get_thread_cache(pool_idx);
+
+        if (!cache.loaded)
+        {
+            cache.loaded = get_empty_magazine();
+        }
+        else if (get(cache.loaded).count == magazine_rounds(n_log2))
+        {
+            if (cache.previous && get(cache.previous).count == 0)
+            {
+                std::swap(cache.loaded, cache.previous);
+            }
+            else
+            {
+                // the previous magazine, if any, is full; hand it over to other threads
+                if (cache.previous)
+                {
+                    push(m_full[pool_idx], cache.previous);
+                }
+
+                cache.previous = cache.loaded;
+                cache.loaded = get_empty_magazine();
+            }
+        }
+
+        magazine & loaded = get(cache.loaded);
+        loaded.rounds[loaded.count++] = p;
+    }
+
+private:
+    // smaller magazines for larger blocks, to bound the amount of memory idling in the caches of a thread
+    static std::size_t magazine_rounds(std::size_t bytes_log2)
+    {
+        std::size_t rounds = max_magazine_bytes >> bytes_log2;
+        return (std::min)((std::max)(rounds, static_cast<std::size_t>(1)), static_cast<std::size_t>(max_magazine_rounds));
+    }
+
+    magazine & get(magazine_handle handle) const
+    {
+        return *m_magazines.find(handle - 1);
+    }
+
+    thread_cache & get_thread_cache(std::size_t pool_idx)
+    {
+        std::size_t index = thrust::detail::concurrent_pool_thread_index();
+
+        thread_cache * caches = m_thread_caches.find(index);
+        if (!caches)
+        {
+            lock_t lock(m_mtx);
+            caches = m_thread_caches.grow(index);
+        }
+
+        return caches[pool_idx];
+    }
+
+    // lock-free stack of magazines; the low half of the head is the handle of the top magazine, the high half is
+    // a version counter bumped by every operation
+    void push(std::atomic<std::uint64_t> & head, magazine_handle handle)
+    {
+        magazine & mag = get(handle);
+
+        std::uint64_t old_head = head.load(std::memory_order_relaxed);
+        std::uint64_t new_head;
+        do
+        {
+            mag.next.store(static_cast<magazine_handle>(old_head), std::memory_order_relaxed);
+            new_head = (((old_head >> 32) + 1) << 32) | handle;
+        } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    magazine_handle pop(std::atomic<std::uint64_t> & head)
+    {
+        std::uint64_t old_head = head.load(std::memory_order_acquire);
+        while (static_cast<magazine_handle>(old_head))
+        {
+            // the magazine may be popped and pushed again concurrently, in which case this value is stale; the
+            // version counter makes the exchange below fail in that case
+            magazine_handle next = get(static_cast<magazine_handle>(old_head)).next.load(std::memory_order_relaxed);
+            std::uint64_t new_head = (((old_head >> 32) + 1) << 32) | next;
+
+            if (head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return static_cast<magazine_handle>(old_head);
+            }
+        }
+
+        return 0;
+    }
+
+    magazine_handle get_empty_magazine()
+    {
+        magazine_handle handle = pop(m_empty);
+        if (handle)
+        {
+            return handle;
+        }
+
+        // magazines are only freed in the destructor, so that a handle read by a concurrent pop always refers to
+        // a live magazine
+        lock_t lock(m_mtx);
+        std::size_t index = m_magazine_count++;
+        m_magazines.grow(index)->count = 0;
+        return static_cast<magazine_handle>(index + 1);
+    }
+
+    void refill(thread_cache & cache, std::size_t pool_idx, std::size_t bytes_log2)
+    {
+        if (cache.previous && get(cache.previous).count != 0)
+        {
+            std::swap(cache.loaded, cache.previous);
+            return;
+        }
+
+        magazine_handle full = pop(m_full[pool_idx]);
+        if (full)
+        {
+            if (cache.loaded)
+            {
+                push(m_empty, cache.loaded);
+            }
+            cache.loaded = full;
+            return;
+        }
+
+        // nothing cached anywhere; carve a magazine's worth of blocks out of the underlying pool
+        if (!cache.loaded)
+        {
+            cache.loaded = get_empty_magazine();
+        }
+
+        magazine & loaded = get(cache.loaded);
+        std::size_t rounds = magazine_rounds(bytes_log2);
+
+        lock_t lock(m_mtx);
+        while (loaded.count < rounds)
+        {
+            loaded.rounds[loaded.count++] = m_pool.do_allocate(static_cast<std::size_t>(1) << bytes_log2, m_options.alignment);
+        }
+    }
+
+    pool_options m_options;
+    std::size_t m_smallest_block_log2;
+    std::size_t m_pool_count;
+
+    mutable std::mutex m_mtx;
+    unsync_pool m_pool;
+
+    std::atomic<std::uint64_t> * m_full;
+    std::atomic<std::uint64_t> m_empty;
+
+    std::size_t m_magazine_count;
+    thrust::detail::concurrent_segment_table<magazine> m_magazines;
+    thrust::detail::concurrent_segment_table<thread_cache> m_thread_caches;
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
@@ -31,9 +31,11 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 
 #include <thrust/detail/algorithm_wrapper.h>
 #include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
 
 #include <thrust/host_vector.h>
 #include <thrust/binary_search.h>
+#include <thrust/remove.h>
 #include <thrust/detail/seq.h>
 
 #include <thrust/mr/memory_resource.h>
@@ -104,6 +106,8 @@ public:
         ret.cached_size_cutoff_factor = 16;
         ret.cached_alignment_cutoff_factor = 16;
 
+        ret.max_cached_bytes = ~static_cast<std::size_t>(0);
+
         return ret;
     }
 
@@ -122,7 +126,10 @@ public:
         m_pools(m_bookkeeper),
         m_allocated(m_bookkeeper),
         m_cached_oversized(m_bookkeeper),
-        m_oversized(m_bookkeeper)
+        m_oversized(m_bookkeeper),
+        m_oversized_index(m_bookkeeper),
+        m_cached_bytes(0),
+        m_clock(0)
     {
         assert(m_options.validate());
 
@@ -145,7 +152,10 @@ public:
         m_pools(m_bookkeeper),
         m_allocated(m_bookkeeper),
         m_cached_oversized(m_bookkeeper),
-        m_oversized(m_bookkeeper)
+        m_oversized(m_bookkeeper),
+        m_oversized_index(m_bookkeeper),
+        m_cached_bytes(0),
+        m_clock(0)
     {
         assert(m_options.validate());
 
@@ -165,10 +175,14 @@ private:
     typedef typename Upstream::pointer void_ptr;
     typedef typename thrust::detail::pointer_traits<void_ptr>::template rebind<char>::other char_ptr;
 
+    // a chunk is idle when all of its blocks are free; last_used records when it last became idle
     struct chunk_descriptor
     {
         std::size_t size;
         void_ptr pointer;
+        std::size_t bucket;
+        std::size_t free_count;
+        std::size_t last_used;
     };
 
     typedef thrust::host_vector<
@@ -176,11 +190,13 @@ private:
         allocator<chunk_descriptor, Bookkeeper>
     > chunk_vector;
 
+    // last_used is only meaningful in m_cached_oversized, where it records when the block was cached
     struct oversized_block_descriptor
     {
         std::size_t size;
         std::size_t alignment;
         void_ptr pointer;
+        std::size_t last_used;
 
         __host__ __device__
         bool operator==(const oversized_block_descriptor & other) const
@@ -195,40 +211,76 @@ private:
         }
     };
 
-    struct equal_pointers
+    struct matching_alignment
     {
     public:
         __host__ __device__
-        equal_pointers(void_ptr p) : p(p)
+        matching_alignment(std::size_t requested) : requested(requested)
         {
         }
 
         __host__ __device__
         bool operator()(const oversized_block_descriptor & desc) const
         {
-            return desc.pointer == p;
+            return desc.alignment >= requested;
         }
 
     private:
-        void_ptr p;
+        std::size_t requested;
     };
 
-    struct matching_alignment
+    // an idle chunk, or a cached oversized block, that trim may return to upstream
+    struct idle_descriptor
     {
-    public:
+        std::size_t last_used;
+        std::size_t position;
+        bool is_chunk;
+
         __host__ __device__
-        matching_alignment(std::size_t requested) : requested(requested)
+        bool operator<(const idle_descriptor & other) const
         {
+            return last_used < other.last_used;
         }
+    };
 
-        __host__ __device__
-        bool operator()(const oversized_block_descriptor & desc) const
+    // whether a free block belongs to one of the chunks trim is about to return to upstream
+    struct in_evicted_chunk
+    {
+    public:
+        __host__
+        in_evicted_chunk(const disjoint_unsynchronized_pool_resource * resource)
+            : resource(resource), hint(0)
         {
-            return desc.alignment >= requested;
+        }
+
+        __host__
+        bool operator()(const void_ptr & p) const
+        {
+            return resource->m_allocated[resource->find_chunk(p, hint)].last_used == evicted;
         }
 
     private:
-        std::size_t requested;
+        const disjoint_unsynchronized_pool_resource * resource;
+        // consecutive free blocks mostly belong to the same chunk
+        mutable std::size_t hint;
+    };
+
+    struct evicted_chunk
+    {
+        __host__
+        bool operator()(const chunk_descriptor & chunk) const
+        {
+            return chunk.last_used == evicted;
+        }
+    };
+
+    struct evicted_oversized
+    {
+        __host__
+        bool operator()(const oversized_block_descriptor & oversized) const
+        {
+            return oversized.last_used == evicted;
+        }
     };
 
     typedef thrust::host_vector<
@@ -241,19 +293,31 @@ private:
         allocator<void_ptr, Bookkeeper>
     > pointer_vector;
 
+    typedef thrust::host_vector<
+        std::size_t,
+        allocator<std::size_t, Bookkeeper>
+    > index_vector;
+
+    typedef thrust::host_vector<
+        idle_descriptor,
+        allocator<idle_descriptor, Bookkeeper>
+    > idle_vector;
+
     struct pool
     {
         __host__
         pool(const pointer_vector & free)
             : free_blocks(free),
-            previous_allocated_count(0)
+            previous_allocated_count(0),
+            chunk_hint(0)
         {
         }
 
         __host__
         pool(const pool & other)
             : free_blocks(other.free_blocks),
-            previous_allocated_count(other.previous_allocated_count)
+            previous_allocated_count(other.previous_allocated_count),
+            chunk_hint(other.chunk_hint)
         {
         }
 
@@ -266,6 +330,7 @@ private:
 
         pointer_vector free_blocks;
         std::size_t previous_allocated_count;
+        std::size_t chunk_hint;
     };
 
     typedef thrust::host_vector<
@@ -281,12 +346,178 @@ private:
 
     // buckets containing free lists for each pooled size
     pool_vector m_pools;
-    // list of all allocations from upstream for the above
+    // list of all allocations from upstream for the above, sorted by address, so that the chunk of a block can be found
+    // with a binary search
     chunk_vector m_allocated;
     // list of all cached oversized/overaligned blocks that have been returned to the pool to cache
     oversized_block_vector m_cached_oversized;
     // list of all oversized/overaligned allocations from upstream
     oversized_block_vector m_oversized;
+    // open addressing hash table with linear probing, holding the position in m_oversized of each block, so that
+    // deallocation finds a block's descriptor in constant time; its size is zero or a power of two at least twice
+    // the number of blocks, and unused slots hold empty_slot
+    index_vector m_oversized_index;
+
+    // the number of bytes held by idle chunks and cached oversized blocks
+    std::size_t m_cached_bytes;
+    std::size_t m_clock;
+
+    static const std::size_t empty_slot = ~static_cast<std::size_t>(0);
+    // the last_used of the chunks and cached blocks that trim is returning to upstream
+    static const std::size_t evicted = ~static_cast<std::size_t>(0);
+
+    static detail::intmax_t address_of(void_ptr p)
+    {
+        return reinterpret_cast<detail::intmax_t>(detail::pointer_traits<void_ptr>::get(p));
+    }
+
+    // the number of chunks starting at or before address; the search is written without branches on the comparison,
+    // whose outcome is unpredictable
+    std::size_t chunks_up_to(detail::intmax_t address) const
+    {
+        const chunk_descriptor * chunks = thrust::raw_pointer_cast(m_allocated.data());
+        std::size_t first = 0;
+        std::size_t count = m_allocated.size();
+
+        while (count > 0)
+        {
+            std::size_t half = count / 2;
+            bool after = address_of(chunks[first + half].pointer) <= address;
+            first += after ? half + 1 : 0;
+            count = after ? count - half - 1 : half;
+        }
+
+        return first;
+    }
+
+    // the position in m_allocated of the chunk containing the block at p; hint is the position of the chunk last found
+    // for the same bucket, which is checked first, and may be out of date after chunks were added or removed
+    std::size_t find_chunk(void_ptr p, std::size_t & hint) const
+    {
+        detail::intmax_t address = address_of(p);
+
+        if (hint < m_allocated.size())
+        {
+            const chunk_descriptor & chunk = thrust::raw_pointer_cast(m_allocated.data())[hint];
+            detail::intmax_t first = address_of(chunk.pointer);
+            if (first <= address && address < first + static_cast<detail::intmax_t>(chunk.size))
+            {
+                return hint;
+            }
+        }
+
+        std::size_t position = chunks_up_to(address);
+        assert(position > 0);
+        hint = position - 1;
+        return hint;
+    }
+
+    std::size_t chunk_block_count(const chunk_descriptor & chunk) const
+    {
+        return chunk.size >> (chunk.bucket + m_smallest_block_log2);
+    }
+
+    // returns idle memory to upstream once there is more of it than the limit, down to three quarters of the limit, so
+    // that a trim, which goes through all the chunks and cached blocks, happens at most once per quarter of the limit
+    // worth of memory becoming idle
+    void enforce_cache_limit()
+    {
+        if (m_cached_bytes > m_options.max_cached_bytes)
+        {
+            trim(m_options.max_cached_bytes - m_options.max_cached_bytes / 4);
+        }
+    }
+
+    // the home slot of p; Fibonacci hashing spreads the addresses of blocks, whose low bits are mostly zero
+    std::size_t oversized_home(void_ptr p) const
+    {
+        thrust::detail::uint64_t address = static_cast<thrust::detail::uint64_t>(address_of(p));
+
+        return static_cast<std::size_t>(
+            (address * 0x9E3779B97F4A7C15ull) >> (64 - thrust::detail::log2(m_oversized_index.size())));
+    }
+
+    // the slot holding the position of the block at p, which must be in m_oversized
+    std::size_t find_oversized_slot(void_ptr p) const
+    {
+        std::size_t mask = m_oversized_index.size() - 1;
+
+        for (std::size_t slot = oversized_home(p); ; slot = (slot + 1) & mask)
+        {
+            assert(m_oversized_index[slot] != empty_slot);
+
+            if (m_oversized[m_oversized_index[slot]].pointer == p)
+            {
+                return slot;
+            }
+        }
+    }
+
+    void place_oversized(std::size_t position)
+    {
+        std::size_t mask = m_oversized_index.size() - 1;
+
+        std::size_t slot = oversized_home(m_oversized[position].pointer);
+        while (m_oversized_index[slot] != empty_slot)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        m_oversized_index[slot] = position;
+    }
+
+    // makes room for one more block in m_oversized and in the index, before it's allocated; the larger index is
+    // built aside and swapped in, so nothing is lost nor needs to be given back upstream if this throws
+    void reserve_oversized()
+    {
+        if (m_oversized_index.size() < 2 * (m_oversized.size() + 1))
+        {
+            std::size_t size = static_cast<std::size_t>(1) << thrust::detail::log2_ri(4 * (m_oversized.size() + 1));
+
+            index_vector index(m_oversized_index.get_allocator());
+            index.resize((std::max)(static_cast<std::size_t>(16), size), empty_slot);
+
+            m_oversized_index.swap(index);
+            for (std::size_t i = 0; i < m_oversized.size(); ++i)
+            {
+                place_oversized(i);
+            }
+        }
+
+        if (m_oversized.size() == m_oversized.capacity())
+        {
+            m_oversized.reserve((std::max)(static_cast<std::size_t>(16), 2 * m_oversized.capacity()));
+        }
+    }
+
+    // removes the block whose position is held in slot from m_oversized and from the index
+    void erase_oversized(std::size_t slot)
+    {
+        std::size_t mask = m_oversized_index.size() - 1;
+        std::size_t position = m_oversized_index[slot];
+
+        // shift back the following entries of the probe sequence which may no longer be reachable past the hole
+        std::size_t hole = slot;
+        for (std::size_t next = (hole + 1) & mask; m_oversized_index[next] != empty_slot; next = (next + 1) & mask)
+        {
+            std::size_t home = oversized_home(m_oversized[m_oversized_index[next]].pointer);
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                m_oversized_index[hole] = m_oversized_index[next];
+                hole = next;
+            }
+        }
+        m_oversized_index[hole] = empty_slot;
+
+        // fill the position with the last block
+        std::size_t last = m_oversized.size() - 1;
+        if (position != last)
+        {
+            m_oversized_index[find_oversized_slot(m_oversized[last].pointer)] = position;
+            m_oversized[position] = m_oversized[last];
+        }
+        m_oversized.pop_back();
+    }
 
 public:
     /*! Releases all held memory to upstream.
@@ -320,7 +551,125 @@ public:
 
         m_allocated.clear();
         m_oversized.clear();
+
+        // the index is rebuilt at the next oversized allocation
+        index_vector empty_index(m_oversized_index.get_allocator());
+        m_oversized_index.swap(empty_index);
         m_cached_oversized.clear();
+        m_cached_bytes = 0;
+    }
+
+    /*! Returns idle memory to upstream, the least recently used first, until at most \p bytes_to_keep bytes of it are
+     *      left. Idle memory consists of the chunks none of whose blocks are allocated, and of the cached oversized and
+     *      overaligned blocks; memory that is allocated to the user is never affected.
+     *
+     *  \param bytes_to_keep the number of bytes of idle memory to keep for future allocations
+     */
+    void trim(std::size_t bytes_to_keep = 0)
+    {
+        if (m_cached_bytes <= bytes_to_keep)
+        {
+            return;
+        }
+
+        // order the idle chunks and cached blocks by the time they became idle
+        idle_vector idle(m_bookkeeper);
+        for (std::size_t i = 0; i < m_allocated.size(); ++i)
+        {
+            if (m_allocated[i].free_count == chunk_block_count(m_allocated[i]))
+            {
+                idle_descriptor desc = { m_allocated[i].last_used, i, true };
+                idle.push_back(desc);
+            }
+        }
+        for (std::size_t i = 0; i < m_cached_oversized.size(); ++i)
+        {
+            idle_descriptor desc = { m_cached_oversized[i].last_used, i, false };
+            idle.push_back(desc);
+        }
+
+        idle_descriptor * idle_first = thrust::raw_pointer_cast(idle.data());
+        std::sort(idle_first, idle_first + idle.size());
+
+        // mark the least recently used ones, and the buckets whose free lists hold blocks of marked chunks
+        index_vector buckets(m_bookkeeper);
+        buckets.reserve(idle.size());
+
+        bool chunks_evicted = false;
+        bool oversized_evicted = false;
+        for (std::size_t i = 0; m_cached_bytes > bytes_to_keep; ++i)
+        {
+            assert(i < idle.size());
+
+            if (idle_first[i].is_chunk)
+            {
+                chunk_descriptor & chunk = m_allocated[idle_first[i].position];
+                chunk.last_used = evicted;
+                m_cached_bytes -= chunk.size;
+                buckets.push_back(chunk.bucket);
+                chunks_evicted = true;
+            }
+            else
+            {
+                oversized_block_descriptor & oversized = m_cached_oversized[idle_first[i].position];
+                oversized.last_used = evicted;
+                m_cached_bytes -= oversized.size;
+                oversized_evicted = true;
+            }
+        }
+
+        // then take them out in a single pass over each of the affected lists
+        if (chunks_evicted)
+        {
+            std::size_t * buckets_first = thrust::raw_pointer_cast(buckets.data());
+            std::sort(buckets_first, buckets_first + buckets.size());
+            std::size_t * buckets_last = std::unique(buckets_first, buckets_first + buckets.size());
+
+            for (std::size_t * bucket = buckets_first; bucket != buckets_last; ++bucket)
+            {
+                pointer_vector & free_blocks = m_pools[*bucket].free_blocks;
+                free_blocks.erase(
+                    thrust::remove_if(thrust::seq, free_blocks.begin(), free_blocks.end(), in_evicted_chunk(this)),
+                    free_blocks.end());
+            }
+
+            for (std::size_t i = 0; i < m_allocated.size(); ++i)
+            {
+                if (m_allocated[i].last_used == evicted)
+                {
+                    m_upstream->do_deallocate(m_allocated[i].pointer, m_allocated[i].size, m_options.alignment);
+                }
+            }
+
+            m_allocated.erase(
+                thrust::remove_if(thrust::seq, m_allocated.begin(), m_allocated.end(), evicted_chunk()),
+                m_allocated.end());
+        }
+
+        if (oversized_evicted)
+        {
+            for (std::size_t i = 0; i < m_cached_oversized.size(); ++i)
+            {
+                oversized_block_descriptor oversized = m_cached_oversized[i];
+                if (oversized.last_used == evicted)
+                {
+                    erase_oversized(find_oversized_slot(oversized.pointer));
+                    m_upstream->do_deallocate(oversized.pointer, oversized.size, oversized.alignment);
+                }
+            }
+
+            m_cached_oversized.erase(
+                thrust::remove_if(thrust::seq, m_cached_oversized.begin(), m_cached_oversized.end(), evicted_oversized()),
+                m_cached_oversized.end());
+        }
+    }
+
+    /*! Returns the number of bytes of idle memory held by the pool, i.e. the number of bytes that \p trim(0) would return
+     *      to upstream.
+     */
+    std::size_t cached_bytes() const
+    {
+        return m_cached_bytes;
     }
 
     THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
@@ -375,14 +724,18 @@ public:
                 if (it != m_cached_oversized.end())
                 {
                     oversized.pointer = (*it).pointer;
+                    m_cached_bytes -= (*it).size;
                     m_cached_oversized.erase(it);
                     return oversized.pointer;
                 }
             }
 
             // no fitting cached block found; allocate a new one that's just up to the specs
+            reserve_oversized();
             oversized.pointer = m_upstream->do_allocate(bytes, alignment);
+            oversized.last_used = 0;
             m_oversized.push_back(oversized);
+            place_oversized(m_oversized.size() - 1);
 
             return oversized.pointer;
         }
@@ -431,9 +784,15 @@ public:
             chunk_descriptor allocated;
             allocated.size = bytes;
             allocated.pointer = m_upstream->do_allocate(bytes, m_options.alignment);
-            m_allocated.push_back(allocated);
+            allocated.bucket = bucket_idx;
+            allocated.free_count = n;
+            allocated.last_used = 0;
+            m_allocated.insert(m_allocated.begin() + chunks_up_to(address_of(allocated.pointer)), allocated);
             bucket.previous_allocated_count = n;
 
+            // all the blocks of the new chunk are free, so it starts out idle
+            m_cached_bytes += bytes;
+
             for (std::size_t i = 0; i < n; ++i)
             {
                 bucket.free_blocks.push_back(
@@ -447,6 +806,14 @@ public:
         // allocate a block from the front of the bucket's free list
         void_ptr ret = bucket.free_blocks.back();
         bucket.free_blocks.pop_back();
+
+        chunk_descriptor & chunk = m_allocated[find_chunk(ret, bucket.chunk_hint)];
+        if (chunk.free_count == chunk_block_count(chunk))
+        {
+            m_cached_bytes -= chunk.size;
+        }
+        --chunk.free_count;
+
         return ret;
     }
 
@@ -461,19 +828,22 @@ public:
         // the deallocated block is oversized and/or overaligned
         if (n > m_options.largest_block_size || alignment > m_options.alignment)
         {
-            typename oversized_block_vector::iterator it = find_if(m_oversized.begin(), m_oversized.end(), equal_pointers(p));
-            assert(it != m_oversized.end());
+            std::size_t slot = find_oversized_slot(p);
 
-            oversized_block_descriptor oversized = *it;
+            oversized_block_descriptor oversized = m_oversized[m_oversized_index[slot]];
 
             if (m_options.cache_oversized)
             {
+                oversized.last_used = ++m_clock;
                 typename oversized_block_vector::iterator position = lower_bound(m_cached_oversized.begin(), m_cached_oversized.end(), oversized);
                 m_cached_oversized.insert(position, oversized);
+                m_cached_bytes += oversized.size;
+
+                enforce_cache_limit();
                 return;
             }
 
-            m_oversized.erase(it);
+            erase_oversized(slot);
 
             m_upstream->do_deallocate(p, oversized.size, oversized.alignment);
 
@@ -486,9 +856,24 @@ public:
         pool & bucket = m_pools[bucket_idx];
 
         bucket.free_blocks.push_back(p);
+
+        chunk_descriptor & chunk = m_allocated[find_chunk(p, bucket.chunk_hint)];
+        if (++chunk.free_count == chunk_block_count(chunk))
+        {
+            chunk.last_used = ++m_clock;
+            m_cached_bytes += chunk.size;
+
+            enforce_cache_limit();
+        }
     }
 };
 
+template<typename Upstream, typename Bookkeeper>
+const std::size_t disjoint_unsynchronized_pool_resource<Upstream, Bookkeeper>::empty_slot;
+
+template<typename Upstream, typename Bookkeeper>
+const std::size_t disjoint_unsynchronized_pool_resource<Upstream, Bookkeeper>::evicted;
+
 /*! \} // memory_resource
  */
 
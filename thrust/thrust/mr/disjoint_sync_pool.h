@@ -96,6 +96,25 @@ public:
         upstream_pool.release();
     }
 
+    /*! Returns idle memory to upstream, the least recently used first, until at most \p bytes_to_keep bytes of it are
+     *      left.
+     *
+     *  \param bytes_to_keep the number of bytes of idle memory to keep for future allocations
+     */
+    void trim(std::size_t bytes_to_keep = 0)
+    {
+        lock_t lock(mtx);
+        upstream_pool.trim(bytes_to_keep);
+    }
+
+    /*! Returns the number of bytes of idle memory held by the pool.
+     */
+    std::size_t cached_bytes() const
+    {
+        lock_t lock(mtx);
+        return upstream_pool.cached_bytes();
+    }
+
     THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
     {
         lock_t lock(mtx);
@@ -109,7 +128,7 @@ public:
     }
 
 private:
-    std::mutex mtx;
+    mutable std::mutex mtx;
     unsync_pool upstream_pool;
 };
 
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief Control of the cache of temporary storage used by algorithms on the host systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/allocator/host_temporary_cache.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! Enables or disables caching of the temporary storage that algorithms allocate when invoked with the execution
+ *      policies and tags of the \p cpp, \p omp and \p tbb systems (including \p thrust::host and \p thrust::device when
+ *      they refer to those systems). When enabled, every thread keeps the temporary storage it releases in a cache, and
+ *      reuses it for later requests of a similar size, instead of allocating and freeing it with \p std::malloc and
+ *      \p std::free every time.
+ *
+ *  The cache is disabled by default, unless \p THRUST_HOST_TEMPORARY_CACHE is defined to 1. The memory cached by a
+ *      single thread is bounded by \p THRUST_HOST_TEMPORARY_CACHE_MAX_BYTES, 256 MiB by default. Policies with an
+ *      allocator attached (<tt>thrust::omp::par(alloc)</tt>) and user-defined systems never use the cache.
+ *
+ *  This function may be called while algorithms are running. Temporary storage they allocated before the call is
+ *      still released correctly, but only kept in the cache if caching is enabled by the time it's released.
+ *
+ *  \param enable whether to cache temporary storage
+ */
+inline void enable_host_temporary_cache(bool enable = true)
+{
+    thrust::detail::host_temporary_cache::set_enabled(enable);
+}
+
+/*! Returns whether temporary storage of the host systems is cached.
+ */
+inline bool host_temporary_cache_enabled()
+{
+    return thrust::detail::host_temporary_cache::enabled();
+}
+
+/*! Returns all the temporary storage cached by the calling thread to the system. The storage cached by a thread is
+ *      also returned when the thread exits.
+ */
+inline void release_host_temporary_cache()
+{
+    thrust::detail::host_temporary_cache::thread_instance().release();
+}
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
@@ -99,6 +99,8 @@ public:
         ret.cached_size_cutoff_factor = 16;
         ret.cached_alignment_cutoff_factor = 16;
 
+        ret.max_cached_bytes = ~static_cast<std::size_t>(0);
+
         return ret;
     }
 
@@ -114,7 +116,14 @@ public:
         m_pools(upstream),
         m_allocated(),
         m_oversized(),
-        m_cached_oversized()
+        m_cached_oversized(),
+        m_cached_oversized_bins(0),
+        m_idle_chunks(),
+        m_idle_chunks_tail(),
+        m_idle_oversized(),
+        m_idle_oversized_tail(),
+        m_cached_bytes(0),
+        m_clock(0)
     {
         assert(m_options.validate());
 
@@ -135,7 +144,14 @@ public:
         m_pools(get_global_resource<Upstream>()),
         m_allocated(),
         m_oversized(),
-        m_cached_oversized()
+        m_cached_oversized(),
+        m_cached_oversized_bins(0),
+        m_idle_chunks(),
+        m_idle_chunks_tail(),
+        m_idle_oversized(),
+        m_idle_oversized_tail(),
+        m_cached_bytes(0),
+        m_clock(0)
     {
         assert(m_options.validate());
 
@@ -162,21 +178,36 @@ private:
     typedef typename thrust::detail::pointer_traits<void_ptr>::template rebind<chunk_descriptor>::other chunk_descriptor_ptr;
     typedef typename thrust::detail::pointer_traits<void_ptr>::template rebind<oversized_block_descriptor>::other oversized_block_descriptor_ptr;
 
+    // the free lists are doubly linked, so that the blocks of an idle chunk can be taken out of them when the chunk is
+    // returned to upstream; chunk is set when the chunk is split into blocks, and stays intact while the block is
+    // allocated, because the descriptor follows the memory handed out to the user
     struct block_descriptor
     {
+        block_descriptor_ptr prev;
         block_descriptor_ptr next;
+        chunk_descriptor_ptr chunk;
     };
 
+    // a chunk is idle when all of its blocks are free; idle chunks are kept in a list ordered by the time they became
+    // idle, which is recorded in last_used
     struct chunk_descriptor
     {
         std::size_t size;
+        std::size_t bucket;
+        std::size_t block_count;
+        std::size_t free_count;
+        std::size_t last_used;
+        chunk_descriptor_ptr prev;
         chunk_descriptor_ptr next;
+        chunk_descriptor_ptr idle_prev;
+        chunk_descriptor_ptr idle_next;
     };
 
     // this was originally a forward list, but I made it a doubly linked list
     // because that way deallocation when not caching is faster and doesn't require
-    // traversal of a linked list (it's still a forward list for the cached list,
-    // because allocation from that list already traverses)
+    // traversal of a linked list; the cached lists are doubly linked too (prev_cached
+    // and next_cached), so that trim can take a cached block out of the middle of its
+    // list when it returns the block to upstream
     //
     // TODO: investigate whether it's better to have this be a doubly-linked list
     // with fast do_deallocate when !m_options.cache_oversized, or to have this be
@@ -185,15 +216,32 @@ private:
     // I assume that it is better this way, but the additional pointer could
     // potentially hurt? these are supposed to be oversized and/or overaligned,
     // so they are kinda memory intensive already
+    //
+    // the descriptor directly follows the memory handed out to the user, so that
+    // do_deallocate can find it; when a cached block is reused for a smaller
+    // request, the descriptor is moved to the end of that request, and moved back
+    // to the end of the block when it's cached again. size is the size of the
+    // whole block, user_size the offset of the descriptor from its beginning.
+    //
+    // cached blocks are also linked into a list ordered by the time they were
+    // cached, which is recorded in last_used, so that the least recently used
+    // ones can be returned to upstream first
     struct oversized_block_descriptor
     {
         std::size_t size;
+        std::size_t user_size;
         std::size_t alignment;
+        std::size_t last_used;
         oversized_block_descriptor_ptr prev;
         oversized_block_descriptor_ptr next;
+        oversized_block_descriptor_ptr prev_cached;
         oversized_block_descriptor_ptr next_cached;
+        oversized_block_descriptor_ptr idle_prev;
+        oversized_block_descriptor_ptr idle_next;
     };
 
+    static const std::size_t oversized_bin_count = sizeof(std::size_t) * 8;
+
     struct pool
     {
         block_descriptor_ptr free_list;
@@ -213,7 +261,20 @@ private:
     pool_vector m_pools;
     chunk_descriptor_ptr m_allocated;
     oversized_block_descriptor_ptr m_oversized;
-    oversized_block_descriptor_ptr m_cached_oversized;
+    // cached oversized blocks, binned by the floor of the log2 of their size, with a bit set in
+    // m_cached_oversized_bins for every non-empty bin, so that finding a fitting block only looks at
+    // the few bins that can contain one instead of at every cached block
+    oversized_block_descriptor_ptr m_cached_oversized[oversized_bin_count];
+    std::size_t m_cached_oversized_bins;
+
+    // idle chunks and cached oversized blocks, least recently used first
+    chunk_descriptor_ptr m_idle_chunks;
+    chunk_descriptor_ptr m_idle_chunks_tail;
+    oversized_block_descriptor_ptr m_idle_oversized;
+    oversized_block_descriptor_ptr m_idle_oversized_tail;
+    // the number of bytes of upstream allocations held by the above
+    std::size_t m_cached_bytes;
+    std::size_t m_clock;
 
 public:
     /*! Releases all held memory to upstream.
@@ -250,12 +311,58 @@ public:
             void_ptr p = static_cast<void_ptr>(
                 static_cast<char_ptr>(
                     static_cast<void_ptr>(alloc)
-                ) - thrust::raw_reference_cast(*alloc).size
+                ) - thrust::raw_reference_cast(*alloc).user_size
             );
             m_upstream->do_deallocate(p, thrust::raw_reference_cast(*alloc).size + sizeof(oversized_block_descriptor), thrust::raw_reference_cast(*alloc).alignment);
         }
 
-        m_cached_oversized = oversized_block_descriptor_ptr();
+        for (std::size_t i = 0; i < oversized_bin_count; ++i)
+        {
+            m_cached_oversized[i] = oversized_block_descriptor_ptr();
+        }
+        m_cached_oversized_bins = 0;
+
+        m_idle_chunks = chunk_descriptor_ptr();
+        m_idle_chunks_tail = chunk_descriptor_ptr();
+        m_idle_oversized = oversized_block_descriptor_ptr();
+        m_idle_oversized_tail = oversized_block_descriptor_ptr();
+        m_cached_bytes = 0;
+    }
+
+    /*! Returns idle memory to upstream, the least recently used first, until at most \p bytes_to_keep bytes of it are
+     *      left. Idle memory consists of the chunks none of whose blocks are allocated, and of the cached oversized and
+     *      overaligned blocks; memory that is allocated to the user is never affected.
+     *
+     *  \param bytes_to_keep the number of bytes of idle memory to keep for future allocations
+     */
+    void trim(std::size_t bytes_to_keep = 0)
+    {
+        while (m_cached_bytes > bytes_to_keep)
+        {
+            bool evict_chunk = detail::pointer_traits<chunk_descriptor_ptr>::get(m_idle_chunks);
+            if (evict_chunk && detail::pointer_traits<oversized_block_descriptor_ptr>::get(m_idle_oversized))
+            {
+                evict_chunk = thrust::raw_reference_cast(*m_idle_chunks).last_used
+                    < thrust::raw_reference_cast(*m_idle_oversized).last_used;
+            }
+
+            if (evict_chunk)
+            {
+                evict_idle_chunk(m_idle_chunks);
+            }
+            else
+            {
+                evict_cached_oversized(m_idle_oversized);
+            }
+        }
+    }
+
+    /*! Returns the number of bytes of idle memory held by the pool, i.e. the number of bytes that \p trim(0) would return
+     *      to upstream.
+     */
+    std::size_t cached_bytes() const
+    {
+        return m_cached_bytes;
     }
 
     THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
@@ -266,64 +373,72 @@ public:
         // an oversized and/or overaligned allocation requested; needs to be allocated separately
         if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
         {
-            if (m_options.cache_oversized)
+            if (m_options.cache_oversized && m_cached_oversized_bins)
             {
-                oversized_block_descriptor_ptr ptr = m_cached_oversized;
-                oversized_block_descriptor_ptr * previous = &m_cached_oversized;
-                while (detail::pointer_traits<oversized_block_descriptor_ptr>::get(ptr))
+                // blocks in the bin of the requested size may be too small, blocks in any higher bin are big enough,
+                // and blocks in bins above last_bin are all too big by at least the size cutoff factor
+                std::size_t first_bin = thrust::detail::log2(bytes);
+                std::size_t last_bin = (std::min)(
+                    first_bin + thrust::detail::log2_ri((std::max)(m_options.cached_size_cutoff_factor, static_cast<std::size_t>(1))),
+                    oversized_bin_count - 1);
+
+                std::size_t bins = m_cached_oversized_bins >> first_bin << first_bin;
+                if (last_bin < oversized_bin_count - 1)
                 {
-                    oversized_block_descriptor desc = *ptr;
-                    bool is_good = desc.size >= bytes && desc.alignment >= alignment;
+                    bins &= (static_cast<std::size_t>(1) << (last_bin + 1)) - 1;
+                }
 
-                    // if the size is bigger than the requested size by a factor
-                    // bigger than or equal to the specified cutoff for size,
-                    // allocate a new block
-                    if (is_good)
-                    {
-                        std::size_t size_factor = desc.size / bytes;
-                        if (size_factor >= m_options.cached_size_cutoff_factor)
-                        {
-                            is_good = false;
-                        }
-                    }
+                while (bins)
+                {
+                    std::size_t bin = thrust::detail::log2(bins & (~bins + 1));
+                    bins &= bins - 1;
 
-                    // if the alignment is bigger than the requested one by a factor
-                    // bigger than or equal to the specified cutoff for alignment,
-                    // allocate a new block
-                    if (is_good)
+                    oversized_block_descriptor_ptr ptr = m_cached_oversized[bin];
+                    while (detail::pointer_traits<oversized_block_descriptor_ptr>::get(ptr))
                     {
-                        std::size_t alignment_factor = desc.alignment / alignment;
-                        if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
+                        oversized_block_descriptor desc = *ptr;
+                        bool is_good = desc.size >= bytes && desc.alignment >= alignment;
+
+                        // if the size is bigger than the requested size by a factor
+                        // bigger than or equal to the specified cutoff for size,
+                        // allocate a new block
+                        if (is_good)
                         {
-                            is_good = false;
+                            std::size_t size_factor = desc.size / bytes;
+                            if (size_factor >= m_options.cached_size_cutoff_factor)
+                            {
+                                is_good = false;
+                            }
                         }
-                    }
 
-                    if (is_good)
-                    {
-                        if (previous != &m_cached_oversized)
+                        // if the alignment is bigger than the requested one by a factor
+                        // bigger than or equal to the specified cutoff for alignment,
+                        // allocate a new block
+                        if (is_good)
                         {
-                            oversized_block_descriptor previous_desc = **previous;
-                            previous_desc.next_cached = desc.next_cached;
-                            **previous = previous_desc;
+                            std::size_t alignment_factor = desc.alignment / alignment;
+                            if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
+                            {
+                                is_good = false;
+                            }
                         }
-                        else
+
+                        if (is_good)
                         {
-                            m_cached_oversized = desc.next_cached;
-                        }
+                            uncache_oversized(ptr);
 
-                        desc.next_cached = oversized_block_descriptor_ptr();
-                        *ptr = desc;
+                            void_ptr allocated = static_cast<void_ptr>(
+                                static_cast<char_ptr>(
+                                    static_cast<void_ptr>(ptr)
+                                ) - desc.size
+                            );
+                            relocate_oversized_descriptor(ptr, bytes);
 
-                        return static_cast<void_ptr>(
-                            static_cast<char_ptr>(
-                                static_cast<void_ptr>(ptr)
-                            ) - desc.size
-                        );
-                    }
+                            return allocated;
+                        }
 
-                    previous = &thrust::raw_reference_cast(*ptr).next_cached;
-                    ptr = *previous;
+                        ptr = desc.next_cached;
+                    }
                 }
             }
 
@@ -337,10 +452,15 @@ public:
 
             oversized_block_descriptor desc;
             desc.size = bytes;
+            desc.user_size = bytes;
             desc.alignment = alignment;
+            desc.last_used = 0;
             desc.prev = oversized_block_descriptor_ptr();
             desc.next = m_oversized;
+            desc.prev_cached = oversized_block_descriptor_ptr();
             desc.next_cached = oversized_block_descriptor_ptr();
+            desc.idle_prev = oversized_block_descriptor_ptr();
+            desc.idle_next = oversized_block_descriptor_ptr();
             *block = desc;
             m_oversized = block;
 
@@ -388,9 +508,7 @@ public:
                 }
             }
 
-            std::size_t descriptor_size = (std::max)(sizeof(block_descriptor), m_options.alignment);
-            std::size_t block_size = bytes + descriptor_size;
-            block_size += m_options.alignment - block_size % m_options.alignment;
+            std::size_t block_size = pooled_block_size(bytes);
             std::size_t chunk_size = block_size * n;
 
             void_ptr allocated = m_upstream->do_allocate(chunk_size + sizeof(chunk_descriptor), m_options.alignment);
@@ -402,10 +520,26 @@ public:
 
             chunk_descriptor chunk_desc;
             chunk_desc.size = chunk_size;
+            chunk_desc.bucket = bucket_idx;
+            chunk_desc.block_count = n;
+            chunk_desc.free_count = n;
+            chunk_desc.last_used = 0;
+            chunk_desc.prev = chunk_descriptor_ptr();
             chunk_desc.next = m_allocated;
+            chunk_desc.idle_prev = chunk_descriptor_ptr();
+            chunk_desc.idle_next = chunk_descriptor_ptr();
             *chunk = chunk_desc;
             m_allocated = chunk;
 
+            if (detail::pointer_traits<chunk_descriptor_ptr>::get(chunk_desc.next))
+            {
+                thrust::raw_reference_cast(*chunk_desc.next).prev = chunk;
+            }
+
+            // all the blocks of the new chunk are free, so it starts out idle
+            link_idle(m_idle_chunks, m_idle_chunks_tail, chunk);
+            m_cached_bytes += chunk_size + sizeof(chunk_descriptor);
+
             for (std::size_t i = 0; i < n; ++i)
             {
                 block_descriptor_ptr block = static_cast<block_descriptor_ptr>(
@@ -415,15 +549,26 @@ public:
                 );
 
                 block_descriptor block_desc;
-                block_desc.next = bucket.free_list;
+                block_desc.prev = block_descriptor_ptr();
+                block_desc.next = block_descriptor_ptr();
+                block_desc.chunk = chunk;
                 *block = block_desc;
-                bucket.free_list = block;
+                push_free_block(bucket, block);
             }
         }
 
         // allocate a block from the front of the bucket's free list
         block_descriptor_ptr block = bucket.free_list;
-        bucket.free_list = thrust::raw_reference_cast(*block).next;
+        unlink_free_block(bucket, block);
+
+        chunk_descriptor & chunk = thrust::raw_reference_cast(*thrust::raw_reference_cast(*block).chunk);
+        if (chunk.free_count == chunk.block_count)
+        {
+            unlink_idle(m_idle_chunks, m_idle_chunks_tail, thrust::raw_reference_cast(*block).chunk);
+            m_cached_bytes -= chunk.size + sizeof(chunk_descriptor);
+        }
+        --chunk.free_count;
+
         return static_cast<void_ptr>(
             static_cast<char_ptr>(
                 static_cast<void_ptr>(block)
@@ -449,37 +594,35 @@ public:
             );
 
             oversized_block_descriptor desc = *block;
+            assert(desc.user_size == n);
 
             if (m_options.cache_oversized)
             {
-                desc.next_cached = m_cached_oversized;
+                block = relocate_oversized_descriptor(block, desc.size);
+                desc = *block;
+
+                std::size_t bin = thrust::detail::log2(desc.size);
+                desc.prev_cached = oversized_block_descriptor_ptr();
+                desc.next_cached = m_cached_oversized[bin];
                 *block = desc;
-                m_cached_oversized = block;
+                m_cached_oversized[bin] = block;
+                m_cached_oversized_bins |= static_cast<std::size_t>(1) << bin;
 
-                return;
-            }
+                if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next_cached))
+                {
+                    thrust::raw_reference_cast(*desc.next_cached).prev_cached = block;
+                }
 
-            if (!detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.prev))
-            {
-                assert(m_oversized == block);
-                m_oversized = desc.next;
-            }
-            else
-            {
-                oversized_block_descriptor prev = *desc.prev;
-                assert(prev.next == block);
-                prev.next = desc.next;
-                *desc.prev = prev;
-            }
+                link_idle(m_idle_oversized, m_idle_oversized_tail, block);
+                m_cached_bytes += desc.size + sizeof(oversized_block_descriptor);
 
-            if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next))
-            {
-                oversized_block_descriptor next = *desc.next;
-                assert(next.prev == block);
-                next.prev = desc.prev;
-                *desc.next = next;
+                trim(m_options.max_cached_bytes);
+
+                return;
             }
 
+            unlink_oversized(block);
+
             m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
 
             return;
@@ -498,11 +641,265 @@ public:
             )
         );
 
-        block_descriptor desc;
+        push_free_block(bucket, block);
+
+        chunk_descriptor_ptr chunk_ptr = thrust::raw_reference_cast(*block).chunk;
+        chunk_descriptor & chunk = thrust::raw_reference_cast(*chunk_ptr);
+        if (++chunk.free_count == chunk.block_count)
+        {
+            link_idle(m_idle_chunks, m_idle_chunks_tail, chunk_ptr);
+            m_cached_bytes += chunk.size + sizeof(chunk_descriptor);
+
+            trim(m_options.max_cached_bytes);
+        }
+    }
+
+private:
+    // the distance between the beginnings of consecutive blocks of the given size in a chunk
+    std::size_t pooled_block_size(std::size_t bytes) const
+    {
+        std::size_t descriptor_size = (std::max)(sizeof(block_descriptor), m_options.alignment);
+        std::size_t block_size = bytes + descriptor_size;
+        block_size += m_options.alignment - block_size % m_options.alignment;
+        return block_size;
+    }
+
+    void push_free_block(pool & bucket, block_descriptor_ptr block)
+    {
+        block_descriptor & desc = thrust::raw_reference_cast(*block);
+        desc.prev = block_descriptor_ptr();
         desc.next = bucket.free_list;
-        *block = desc;
+
+        if (detail::pointer_traits<block_descriptor_ptr>::get(desc.next))
+        {
+            thrust::raw_reference_cast(*desc.next).prev = block;
+        }
         bucket.free_list = block;
     }
+
+    void unlink_free_block(pool & bucket, block_descriptor_ptr block)
+    {
+        const block_descriptor & desc = thrust::raw_reference_cast(*block);
+
+        if (detail::pointer_traits<block_descriptor_ptr>::get(desc.prev))
+        {
+            thrust::raw_reference_cast(*desc.prev).next = desc.next;
+        }
+        else
+        {
+            assert(bucket.free_list == block);
+            bucket.free_list = desc.next;
+        }
+
+        if (detail::pointer_traits<block_descriptor_ptr>::get(desc.next))
+        {
+            thrust::raw_reference_cast(*desc.next).prev = desc.prev;
+        }
+    }
+
+    // appends a chunk or an oversized block to the back of its list of idle memory, as the most recently used
+    template<typename Pointer>
+    void link_idle(Pointer & head, Pointer & tail, Pointer ptr)
+    {
+        thrust::raw_reference_cast(*ptr).last_used = ++m_clock;
+        thrust::raw_reference_cast(*ptr).idle_prev = tail;
+        thrust::raw_reference_cast(*ptr).idle_next = Pointer();
+
+        if (detail::pointer_traits<Pointer>::get(tail))
+        {
+            thrust::raw_reference_cast(*tail).idle_next = ptr;
+        }
+        else
+        {
+            head = ptr;
+        }
+        tail = ptr;
+    }
+
+    template<typename Pointer>
+    void unlink_idle(Pointer & head, Pointer & tail, Pointer ptr)
+    {
+        Pointer prev = thrust::raw_reference_cast(*ptr).idle_prev;
+        Pointer next = thrust::raw_reference_cast(*ptr).idle_next;
+
+        if (detail::pointer_traits<Pointer>::get(prev))
+        {
+            thrust::raw_reference_cast(*prev).idle_next = next;
+        }
+        else
+        {
+            head = next;
+        }
+
+        if (detail::pointer_traits<Pointer>::get(next))
+        {
+            thrust::raw_reference_cast(*next).idle_prev = prev;
+        }
+        else
+        {
+            tail = prev;
+        }
+    }
+
+    // takes the blocks of an idle chunk out of the free list of its bucket and returns the chunk to upstream
+    void evict_idle_chunk(chunk_descriptor_ptr chunk)
+    {
+        chunk_descriptor desc = *chunk;
+        assert(desc.free_count == desc.block_count);
+
+        pool & bucket = thrust::raw_reference_cast(m_pools[desc.bucket]);
+        std::size_t bytes = static_cast<std::size_t>(1) << (desc.bucket + m_smallest_block_log2);
+        std::size_t block_size = pooled_block_size(bytes);
+
+        void_ptr allocated = static_cast<void_ptr>(
+            static_cast<char_ptr>(
+                static_cast<void_ptr>(chunk)
+            ) - desc.size
+        );
+
+        for (std::size_t i = 0; i < desc.block_count; ++i)
+        {
+            unlink_free_block(bucket, static_cast<block_descriptor_ptr>(
+                static_cast<void_ptr>(
+                    static_cast<char_ptr>(allocated) + block_size * i + bytes
+                )
+            ));
+        }
+
+        unlink_idle(m_idle_chunks, m_idle_chunks_tail, chunk);
+        m_cached_bytes -= desc.size + sizeof(chunk_descriptor);
+
+        if (detail::pointer_traits<chunk_descriptor_ptr>::get(desc.prev))
+        {
+            thrust::raw_reference_cast(*desc.prev).next = desc.next;
+        }
+        else
+        {
+            m_allocated = desc.next;
+        }
+
+        if (detail::pointer_traits<chunk_descriptor_ptr>::get(desc.next))
+        {
+            thrust::raw_reference_cast(*desc.next).prev = desc.prev;
+        }
+
+        m_upstream->do_deallocate(allocated, desc.size + sizeof(chunk_descriptor), m_options.alignment);
+    }
+
+    // takes a cached oversized block out of its bin and of the list of idle memory
+    void uncache_oversized(oversized_block_descriptor_ptr block)
+    {
+        oversized_block_descriptor desc = *block;
+        std::size_t bin = thrust::detail::log2(desc.size);
+
+        if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.prev_cached))
+        {
+            thrust::raw_reference_cast(*desc.prev_cached).next_cached = desc.next_cached;
+        }
+        else
+        {
+            m_cached_oversized[bin] = desc.next_cached;
+            if (!detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next_cached))
+            {
+                m_cached_oversized_bins &= ~(static_cast<std::size_t>(1) << bin);
+            }
+        }
+
+        if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next_cached))
+        {
+            thrust::raw_reference_cast(*desc.next_cached).prev_cached = desc.prev_cached;
+        }
+
+        desc.prev_cached = oversized_block_descriptor_ptr();
+        desc.next_cached = oversized_block_descriptor_ptr();
+        *block = desc;
+
+        unlink_idle(m_idle_oversized, m_idle_oversized_tail, block);
+        m_cached_bytes -= desc.size + sizeof(oversized_block_descriptor);
+    }
+
+    void evict_cached_oversized(oversized_block_descriptor_ptr block)
+    {
+        uncache_oversized(block);
+        unlink_oversized(block);
+
+        oversized_block_descriptor desc = *block;
+        void_ptr p = static_cast<void_ptr>(
+            static_cast<char_ptr>(
+                static_cast<void_ptr>(block)
+            ) - desc.user_size
+        );
+        m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
+    }
+
+    // removes an oversized block from the list of all oversized blocks
+    void unlink_oversized(oversized_block_descriptor_ptr block)
+    {
+        oversized_block_descriptor desc = *block;
+
+        if (!detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.prev))
+        {
+            assert(m_oversized == block);
+            m_oversized = desc.next;
+        }
+        else
+        {
+            oversized_block_descriptor prev = *desc.prev;
+            assert(prev.next == block);
+            prev.next = desc.next;
+            *desc.prev = prev;
+        }
+
+        if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next))
+        {
+            oversized_block_descriptor next = *desc.next;
+            assert(next.prev == block);
+            next.prev = desc.prev;
+            *desc.next = next;
+        }
+    }
+
+    // moves the descriptor of an oversized block to directly follow the first user_size bytes of the block,
+    // and updates the links to it in the list of oversized blocks
+    oversized_block_descriptor_ptr relocate_oversized_descriptor(oversized_block_descriptor_ptr block, std::size_t user_size)
+    {
+        oversized_block_descriptor desc = *block;
+        if (desc.user_size == user_size)
+        {
+            return block;
+        }
+
+        oversized_block_descriptor_ptr moved = static_cast<oversized_block_descriptor_ptr>(
+            static_cast<void_ptr>(
+                static_cast<char_ptr>(
+                    static_cast<void_ptr>(block)
+                ) - desc.user_size + user_size
+            )
+        );
+
+        desc.user_size = user_size;
+        *moved = desc;
+
+        if (!detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.prev))
+        {
+            m_oversized = moved;
+        }
+        else
+        {
+            oversized_block_descriptor prev = *desc.prev;
+            prev.next = moved;
+            *desc.prev = prev;
+        }
+
+        if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next))
+        {
+            oversized_block_descriptor next = *desc.next;
+            next.prev = moved;
+            *desc.next = next;
+        }
+
+        return moved;
+    }
 };
 
 /*! \} // memory_resources
@@ -96,6 +96,15 @@ struct pool_options
      */
     std::size_t cached_alignment_cutoff_factor;
 
+    /*! The maximal number of bytes of idle memory the pool resource holds on to. Idle memory consists of the chunks none of
+     *      whose blocks are currently allocated, and of the cached oversized and overaligned blocks. When a deallocation makes
+     *      the idle memory exceed this limit, the least recently used idle chunks and cached blocks are returned to the
+     *      upstream resource until it fits again; \p disjoint_unsynchronized_pool_resource returns them until three quarters
+     *      of the limit are left, so that it searches for them less often. The largest value of \p std::size_t, the
+     *      default, means there is no limit; idle memory is then only returned in \p trim and \p release.
+     */
+    std::size_t max_cached_bytes = ~static_cast<std::size_t>(0);
+
     /*! Checks if the options are self-consistent.
      *
      *  /returns true if the options are self-consitent, false otherwise.
@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A memory resource adaptor collecting allocation statistics.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/integer_math.h>
+
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/pool_options.h>
+#include <thrust/mr/validator.h>
+
+#include <ostream>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! Counters collected by a \p statistics_resource. Requests are grouped into size classes: size class \p i holds
+ *      requests of more than <tt>2^(i-1)</tt> and at most <tt>2^i</tt> bytes, which are the sizes served by a single
+ *      pool of the pool resources.
+ */
+struct allocation_statistics
+{
+    /*! The number of size classes. */
+    static const std::size_t size_class_count = sizeof(std::size_t) * 8 + 1;
+
+    /*! The number of calls to \p do_allocate. */
+    std::size_t allocations;
+    /*! The number of calls to \p do_deallocate. */
+    std::size_t deallocations;
+
+    /*! The number of bytes currently allocated and not yet deallocated. */
+    std::size_t bytes_in_use;
+    /*! The highest value \p bytes_in_use has reached. */
+    std::size_t peak_bytes_in_use;
+
+    /*! The number of allocation requests in each size class; a histogram of allocation sizes. */
+    std::size_t requests[size_class_count];
+    /*! The number of allocations in each size class served without allocating from the observed upstream statistics,
+     *      i.e. from memory cached by the adapted resource. Only counted when upstream statistics are attached.
+     */
+    std::size_t hits[size_class_count];
+    /*! The number of allocations in each size class that required allocating from the observed upstream statistics.
+     *      Only counted when upstream statistics are attached.
+     */
+    std::size_t misses[size_class_count];
+
+    /*! The number of hits for oversized or overaligned requests, i.e. served from the cache of oversized blocks of a
+     *      pool. Only counted when pool options are attached along with upstream statistics.
+     */
+    std::size_t oversized_hits;
+    /*! The number of misses for oversized or overaligned requests. Only counted when pool options are attached along
+     *      with upstream statistics.
+     */
+    std::size_t oversized_misses;
+
+    /*! Returns the size class of a request for \p bytes bytes.
+     */
+    static std::size_t size_class(std::size_t bytes)
+    {
+        return bytes <= 1 ? 0 : thrust::detail::log2_ri(bytes);
+    }
+};
+
+/*! A memory resource adaptor collecting statistics about the requests made to it, which are forwarded to \p Upstream.
+ *      It can be used on top of a pooling resource, to learn about the requests made by the user, or as the upstream
+ *      resource of one, to learn about what it allocates.
+ *
+ *  When both positions are used, the statistics of the inner adaptor can be attached to the outer one with
+ *      \p attach_upstream_statistics. Every allocation through the outer adaptor is then classified as a hit (served
+ *      by the pool from cached memory) or a miss (that required the pool to allocate from upstream), and
+ *      \p fragmentation can tell how much of the memory held by the pool isn't in use by the user.
+ *
+ *  \code
+ *  typedef thrust::mr::statistics_resource<thrust::mr::new_delete_resource> upstream_stats_t;
+ *  typedef thrust::mr::unsynchronized_pool_resource<upstream_stats_t> pool_t;
+ *
+ *  upstream_stats_t upstream;
+ *  pool_t pool(&upstream, options);
+ *  thrust::mr::statistics_resource<pool_t> stats(&pool);
+ *  stats.attach_upstream_statistics(upstream.statistics(), options);
+ *
+ *  // ... use stats as the memory resource ...
+ *
+ *  stats.dump(std::cout);
+ *  \endcode
+ *
+ *  Like the unsynchronized pools, this adaptor is not synchronized; guard it with a mutex to share it between threads.
+ *
+ *  \tparam Upstream the type of memory resources requests are forwarded to
+ */
+template<typename Upstream>
+class statistics_resource : public memory_resource<typename Upstream::pointer>, private validator<Upstream>
+{
+    typedef typename Upstream::pointer void_ptr;
+
+public:
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     */
+    statistics_resource()
+        : m_upstream(get_global_resource<Upstream>()), m_statistics(), m_upstream_statistics(NULL), m_options(), m_has_options(false)
+    {
+    }
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource requests are forwarded to
+     */
+    statistics_resource(Upstream * upstream)
+        : m_upstream(upstream), m_statistics(), m_upstream_statistics(NULL), m_options(), m_has_options(false)
+    {
+    }
+
+    /*! Attaches the statistics of the upstream of the resource this adaptor is wrapping, to classify allocations as hits
+     *      or misses.
+     *
+     *  \param upstream_statistics the statistics of an adaptor used as the upstream of the wrapped resource; must outlive
+     *      this adaptor, or be detached by passing another value
+     */
+    void attach_upstream_statistics(const allocation_statistics & upstream_statistics)
+    {
+        m_upstream_statistics = &upstream_statistics;
+        m_has_options = false;
+    }
+
+    /*! Attaches the statistics of the upstream of the wrapped pool resource, to classify allocations as hits or misses,
+     *      and the options of that pool, to also classify them as oversized or not.
+     *
+     *  \param upstream_statistics the statistics of an adaptor used as the upstream of the wrapped pool; must outlive
+     *      this adaptor, or be detached by passing another value
+     *  \param options the options the wrapped pool was constructed with
+     */
+    void attach_upstream_statistics(const allocation_statistics & upstream_statistics, const pool_options & options)
+    {
+        m_upstream_statistics = &upstream_statistics;
+        m_options = options;
+        m_has_options = true;
+    }
+
+    /*! Returns the statistics collected so far.
+     */
+    const allocation_statistics & statistics() const
+    {
+        return m_statistics;
+    }
+
+    /*! Resets all counters, except for \p bytes_in_use, which continues to reflect the memory not yet deallocated;
+     *      \p peak_bytes_in_use starts over from it.
+     */
+    void reset_statistics()
+    {
+        std::size_t bytes_in_use = m_statistics.bytes_in_use;
+
+        m_statistics = allocation_statistics();
+        m_statistics.bytes_in_use = bytes_in_use;
+        m_statistics.peak_bytes_in_use = bytes_in_use;
+    }
+
+    /*! Returns the fraction of memory allocated from the attached upstream statistics that is not currently allocated
+     *      by the users of this adaptor: memory that a pool holds in its caches, or loses to padding and bookkeeping.
+     *      Returns 0 when no upstream statistics are attached, or nothing is allocated from upstream.
+     */
+    double fragmentation() const
+    {
+        if (!m_upstream_statistics || m_upstream_statistics->bytes_in_use == 0
+            || m_upstream_statistics->bytes_in_use < m_statistics.bytes_in_use)
+        {
+            return 0;
+        }
+
+        return static_cast<double>(m_upstream_statistics->bytes_in_use - m_statistics.bytes_in_use)
+            / m_upstream_statistics->bytes_in_use;
+    }
+
+    /*! Calls <tt>visitor(size, requests, hits, misses)</tt> for every size class that has seen any requests, in
+     *      the order of increasing size. \p size is the largest request size of the size class.
+     *
+     *  \param visitor the function object to call
+     */
+    template<typename Visitor>
+    void visit_size_classes(Visitor visitor) const
+    {
+        for (std::size_t i = 0; i < allocation_statistics::size_class_count; ++i)
+        {
+            if (m_statistics.requests[i] == 0)
+            {
+                continue;
+            }
+
+            std::size_t size = i < sizeof(std::size_t) * 8 ? static_cast<std::size_t>(1) << i : ~static_cast<std::size_t>(0);
+            visitor(size, m_statistics.requests[i], m_statistics.hits[i], m_statistics.misses[i]);
+        }
+    }
+
+    /*! Writes a human readable summary of the statistics, including the histogram of allocation sizes, to a stream.
+     *
+     *  \param os the stream to write to
+     */
+    void dump(std::ostream & os) const
+    {
+        os << "allocations: " << m_statistics.allocations
+            << ", deallocations: " << m_statistics.deallocations << '\n';
+        os << "bytes in use: " << m_statistics.bytes_in_use
+            << ", peak: " << m_statistics.peak_bytes_in_use << '\n';
+
+        if (m_upstream_statistics)
+        {
+            os << "upstream allocations: " << m_upstream_statistics->allocations
+                << ", deallocations: " << m_upstream_statistics->deallocations
+                << ", bytes in use: " << m_upstream_statistics->bytes_in_use
+                << ", fragmentation: " << fragmentation() << '\n';
+        }
+        if (m_has_options)
+        {
+            os << "oversized hits: " << m_statistics.oversized_hits
+                << ", misses: " << m_statistics.oversized_misses << '\n';
+        }
+
+        os << "size <=\trequests\thits\tmisses\n";
+        visit_size_classes(dump_visitor(os));
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        std::size_t upstream_allocations = m_upstream_statistics ? m_upstream_statistics->allocations : 0;
+
+        void_ptr ret = m_upstream->do_allocate(bytes, alignment);
+
+        std::size_t size_class = allocation_statistics::size_class(bytes);
+
+        ++m_statistics.allocations;
+        ++m_statistics.requests[size_class];
+
+        m_statistics.bytes_in_use += bytes;
+        if (m_statistics.bytes_in_use > m_statistics.peak_bytes_in_use)
+        {
+            m_statistics.peak_bytes_in_use = m_statistics.bytes_in_use;
+        }
+
+        if (m_upstream_statistics)
+        {
+            bool miss = m_upstream_statistics->allocations != upstream_allocations;
+            bool oversized = m_has_options && is_oversized(bytes, alignment);
+
+            if (miss)
+            {
+                ++m_statistics.misses[size_class];
+                m_statistics.oversized_misses += oversized;
+            }
+            else
+            {
+                ++m_statistics.hits[size_class];
+                m_statistics.oversized_hits += oversized;
+            }
+        }
+
+        return ret;
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        m_upstream->do_deallocate(p, bytes, alignment);
+
+        ++m_statistics.deallocations;
+        m_statistics.bytes_in_use -= (std::min)(bytes, m_statistics.bytes_in_use);
+    }
+
+private:
+    struct dump_visitor
+    {
+        std::ostream & os;
+
+        dump_visitor(std::ostream & os) : os(os)
+        {
+        }
+
+        void operator()(std::size_t size, std::size_t requests, std::size_t hits, std::size_t misses) const
+        {
+            os << size << '\t' << requests << '\t' << hits << '\t' << misses << '\n';
+        }
+    };
+
+    bool is_oversized(std::size_t bytes, std::size_t alignment) const
+    {
+        return (std::max)(bytes, m_options.smallest_block_size) > m_options.largest_block_size
+            || alignment > m_options.alignment;
+    }
+
+    Upstream * m_upstream;
+
+    allocation_statistics m_statistics;
+
+    const allocation_statistics * m_upstream_statistics;
+    pool_options m_options;
+    bool m_has_options;
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
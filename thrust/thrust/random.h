@@ -33,6 +33,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/random/discard_block_engine.h>
 #include <thrust/random/linear_congruential_engine.h>
 #include <thrust/random/linear_feedback_shift_engine.h>
+#include <thrust/random/philox_engine.h>
 #include <thrust/random/subtract_with_carry_engine.h>
 #include <thrust/random/xor_combine_engine.h>
 
@@ -0,0 +1,365 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/random/normal_distribution.h>
+#include <thrust/random/philox_engine.h>
+#include <thrust/random/uniform_int_distribution.h>
+#include <thrust/random/uniform_real_distribution.h>
+#include <cmath>
+#include <cstddef> // for size_t
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+// the number of consecutive results drawn from one stream of philox4x32_10
+const size_t bulk_block_size = 128;
+
+
+template<typename Engine>
+  struct philox_round_of;
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  struct philox_round_of<philox_engine<UIntType,w,n,r,consts...> >
+{
+  typedef philox_round<UIntType,w,n,r,consts...> type;
+};
+
+
+// draws words from the stream of philox4x32_10(seed, stream) which starts
+// slice * 2^34 values in. Words are produced bulk_block_size at a time, from
+// bulk_block_size / 4 counters encrypted together
+class bulk_engine
+{
+  public:
+    typedef thrust::detail::uint32_t result_type;
+
+    static const result_type min = 0;
+    static const result_type max = 0xFFFFFFFFu;
+
+    __host__ __device__
+    bulk_engine(result_type seed, result_type stream, result_type slice)
+      : m_group(0), m_stream(stream), m_slice(slice), m_index(bulk_block_size)
+    {
+      m_key[0] = seed;
+      m_key[1] = 0;
+    }
+
+    // writes the next bulk_block_size words of the stream
+    __host__ __device__
+    void generate(result_type (&words)[bulk_block_size])
+    {
+      result_type x0[num_lanes], x1[num_lanes], x2[num_lanes], x3[num_lanes];
+
+      for(size_t j = 0; j < num_lanes; ++j)
+      {
+        const thrust::detail::uint64_t group = m_group + j;
+
+        x0[j] = static_cast<result_type>(group);
+        x1[j] = static_cast<result_type>(group >> 32);
+        x2[j] = m_slice;
+        x3[j] = m_stream;
+      }
+
+      round_type::apply(x0, x1, x2, x3, m_key);
+
+      for(size_t j = 0; j < num_lanes; ++j)
+      {
+        words[4 * j + 0] = x0[j];
+        words[4 * j + 1] = x1[j];
+        words[4 * j + 2] = x2[j];
+        words[4 * j + 3] = x3[j];
+      }
+
+      m_group += num_lanes;
+    }
+
+    // returns one word, buffering a block of them
+    __host__ __device__
+    result_type operator()(void)
+    {
+      if(m_index == bulk_block_size)
+      {
+        generate(m_words);
+        m_index = 0;
+      }
+
+      return m_words[m_index++];
+    }
+
+  private:
+    static const size_t num_lanes = bulk_block_size / 4;
+
+    typedef philox_round_of<philox4x32_10>::type round_type;
+
+    thrust::detail::uint64_t m_group;
+    result_type              m_stream, m_slice;
+    result_type              m_key[2];
+    result_type              m_words[bulk_block_size];
+    size_t                   m_index;
+}; // end bulk_engine
+
+
+// fills bulk_block_size uniforms in [0,1), with every bit of the mantissa random
+__host__ __device__
+inline void bulk_unit_intervals(bulk_engine &rng, float (&result)[bulk_block_size])
+{
+  bulk_engine::result_type words[bulk_block_size];
+  rng.generate(words);
+
+  for(size_t i = 0; i < bulk_block_size; ++i)
+  {
+    result[i] = static_cast<float>(words[i] >> 8) * (1.0f / 16777216.0f);
+  }
+}
+
+__host__ __device__
+inline void bulk_unit_intervals(bulk_engine &rng, double (&result)[bulk_block_size])
+{
+  typedef thrust::detail::uint64_t uint64_t;
+
+  bulk_engine::result_type words[bulk_block_size];
+
+  for(size_t half = 0; half < 2; ++half)
+  {
+    rng.generate(words);
+
+    for(size_t i = 0; i < bulk_block_size / 2; ++i)
+    {
+      const uint64_t bits = (uint64_t(words[2 * i]) << 32) | words[2 * i + 1];
+      result[half * (bulk_block_size / 2) + i] = static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+    }
+  }
+}
+
+
+// fills [result, result + count) with samples of a distribution; count is at
+// most bulk_block_size. The primary template samples one value at a time
+template<typename Distribution, typename Enable = void>
+  struct bulk_generator
+{
+  Distribution dist;
+
+  __host__ __device__
+  bulk_generator(const Distribution &dist)
+    : dist(dist)
+  {}
+
+  template<typename OutputIterator>
+  __host__ __device__
+  void operator()(bulk_engine &rng, OutputIterator result, size_t count) const
+  {
+    // distributions may cache state between calls, so sample from a copy
+    Distribution d = dist;
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      result[i] = d(rng);
+    }
+  }
+}; // end bulk_generator
+
+
+template<typename RealType>
+  struct bulk_generator<
+    uniform_real_distribution<RealType>,
+    typename thrust::detail::enable_if<
+      thrust::detail::or_<
+        thrust::detail::is_same<RealType,float>,
+        thrust::detail::is_same<RealType,double>
+      >::value
+    >::type
+  >
+{
+  RealType a, width;
+
+  __host__ __device__
+  bulk_generator(const uniform_real_distribution<RealType> &dist)
+    : a(dist.a()), width(dist.b() - dist.a())
+  {}
+
+  template<typename OutputIterator>
+  __host__ __device__
+  void operator()(bulk_engine &rng, OutputIterator result, size_t count) const
+  {
+    RealType u[bulk_block_size];
+    bulk_unit_intervals(rng, u);
+
+    for(size_t i = 0; i < bulk_block_size; ++i)
+    {
+      u[i] = a + width * u[i];
+    }
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      result[i] = u[i];
+    }
+  }
+}; // end bulk_generator
+
+
+// Lemire's multiply-shift: the high word of x * range is uniform in [0, range)
+// once the few products whose low word falls below 2^32 mod range are rejected
+template<typename IntType>
+  struct bulk_generator<uniform_int_distribution<IntType> >
+{
+  typedef thrust::detail::uint32_t uint32_t;
+  typedef thrust::detail::uint64_t uint64_t;
+  typedef typename thrust::detail::make_unsigned<IntType>::type unsigned_type;
+
+  uniform_int_distribution<IntType> dist;
+
+  // the number of values in [a, b], minus one
+  uint64_t span;
+
+  __host__ __device__
+  bulk_generator(const uniform_int_distribution<IntType> &dist)
+    : dist(dist),
+      span(static_cast<uint64_t>(static_cast<unsigned_type>(static_cast<unsigned_type>(dist.b()) -
+                                                            static_cast<unsigned_type>(dist.a()))))
+  {}
+
+  template<typename OutputIterator>
+  __host__ __device__
+  void operator()(bulk_engine &rng, OutputIterator result, size_t count) const
+  {
+    if(span > 0xFFFFFFFFu)
+    {
+      // wider than one word of the engine
+      uniform_int_distribution<IntType> d = dist;
+      for(size_t i = 0; i < count; ++i)
+      {
+        result[i] = d(rng);
+      }
+
+      return;
+    }
+
+    // a range of 2^32 wraps to zero; then every word is its own offset
+    const uint32_t range     = static_cast<uint32_t>(span + 1);
+    const uint64_t factor    = range ? uint64_t(range) : (uint64_t(1) << 32);
+    const uint32_t threshold = range ? static_cast<uint32_t>(0u - range) % range : 0u;
+
+    uint32_t words[bulk_block_size];
+    uint32_t offsets[bulk_block_size];
+    rng.generate(words);
+
+    bool any_rejected = false;
+    for(size_t i = 0; i < bulk_block_size; ++i)
+    {
+      const uint64_t product = uint64_t(words[i]) * factor;
+
+      offsets[i]    = static_cast<uint32_t>(product >> 32);
+      any_rejected |= static_cast<uint32_t>(product) < threshold;
+    }
+
+    if(any_rejected)
+    {
+      // replace the rejected offsets with draws from the words after the block
+      for(size_t i = 0; i < bulk_block_size; ++i)
+      {
+        uint64_t product = uint64_t(words[i]) * factor;
+
+        while(static_cast<uint32_t>(product) < threshold)
+        {
+          product = uint64_t(rng()) * factor;
+        }
+
+        offsets[i] = static_cast<uint32_t>(product >> 32);
+      }
+    }
+
+    const unsigned_type a = static_cast<unsigned_type>(dist.a());
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      result[i] = static_cast<IntType>(static_cast<unsigned_type>(a + offsets[i]));
+    }
+  }
+}; // end bulk_generator
+
+
+// the Box-Muller transform on pairs of uniforms. The uniforms of a block are
+// drawn first so that the transcendental functions run in a loop of their own
+template<typename RealType>
+  struct bulk_generator<
+    normal_distribution<RealType>,
+    typename thrust::detail::enable_if<
+      thrust::detail::or_<
+        thrust::detail::is_same<RealType,float>,
+        thrust::detail::is_same<RealType,double>
+      >::value
+    >::type
+  >
+{
+  RealType mean, stddev;
+
+  __host__ __device__
+  bulk_generator(const normal_distribution<RealType> &dist)
+    : mean(dist.mean()), stddev(dist.stddev())
+  {}
+
+  template<typename OutputIterator>
+  __host__ __device__
+  void operator()(bulk_engine &rng, OutputIterator result, size_t count) const
+  {
+    // allow for Koenig lookup
+    using std::sqrt; using std::log; using std::sin; using std::cos;
+
+    RealType u[bulk_block_size];
+    bulk_unit_intervals(rng, u);
+
+    const RealType two_pi = RealType(6.28318530717958647692);
+
+    for(size_t i = 0; i < bulk_block_size / 2; ++i)
+    {
+      // 1 - u lies in (0,1] so that its logarithm is finite
+      const RealType radius = stddev * sqrt(RealType(-2) * log(RealType(1) - u[2 * i]));
+      const RealType theta  = two_pi * u[2 * i + 1];
+
+      u[2 * i]     = mean + radius * cos(theta);
+      u[2 * i + 1] = mean + radius * sin(theta);
+    }
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      result[i] = u[i];
+    }
+  }
+}; // end bulk_generator
+
+
+} // end detail
+
+} // end random
+
+THRUST_NAMESPACE_END
+
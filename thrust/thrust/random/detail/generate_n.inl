@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/random/generate_n.h>
+#include <thrust/random/detail/bulk_generator.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// fills one block of bulk_block_size results from its own stream
+template<typename Generator, typename RandomAccessIterator, typename Size>
+  struct generate_block
+{
+  Generator            gen;
+  thrust::detail::uint32_t seed;
+  RandomAccessIterator result;
+  Size                 n;
+
+  __host__ __device__
+  generate_block(const Generator &gen, thrust::detail::uint32_t seed, RandomAccessIterator result, Size n)
+    : gen(gen), seed(seed), result(result), n(n)
+  {}
+
+  __host__ __device__
+  void operator()(Size block) const
+  {
+    const unsigned long long b = static_cast<unsigned long long>(block);
+
+    // the low word of the block index selects a stream of philox4x32_10, and
+    // the high word one of the 2^32 slices of 2^32 groups which partition it
+    bulk_engine rng(seed,
+                    static_cast<bulk_engine::result_type>(b),
+                    static_cast<bulk_engine::result_type>(b >> 32));
+
+    const Size first     = block * Size(bulk_block_size);
+    const Size remaining = n - first;
+    const Size count     = remaining < Size(bulk_block_size) ? remaining : Size(bulk_block_size);
+
+    gen(rng, result + first, static_cast<size_t>(count));
+  }
+}; // end generate_block
+
+
+} // end detail
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename Distribution,
+         typename RandomAccessIterator,
+         typename Size>
+__host__ __device__
+  RandomAccessIterator generate_n(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  const Distribution &dist,
+                                  thrust::detail::uint32_t seed,
+                                  RandomAccessIterator result,
+                                  Size n)
+{
+  if(n <= Size(0))
+  {
+    return result;
+  }
+
+  typedef detail::bulk_generator<Distribution> generator_type;
+
+  const Size num_blocks = (n + Size(detail::bulk_block_size) - 1) / Size(detail::bulk_block_size);
+
+  thrust::for_each_n(exec,
+                     thrust::counting_iterator<Size>(0),
+                     num_blocks,
+                     detail::generate_block<generator_type,RandomAccessIterator,Size>(generator_type(dist), seed, result, n));
+
+  return result + n;
+} // end generate_n()
+
+
+template<typename Distribution,
+         typename RandomAccessIterator,
+         typename Size>
+  RandomAccessIterator generate_n(const Distribution &dist,
+                                  thrust::detail::uint32_t seed,
+                                  RandomAccessIterator result,
+                                  Size n)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  return thrust::random::generate_n(select_system(system), dist, seed, result, n);
+} // end generate_n()
+
+
+} // end random
+
+THRUST_NAMESPACE_END
+
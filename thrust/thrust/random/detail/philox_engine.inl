@@ -0,0 +1,310 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+
+#include <thrust/random/philox_engine.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  philox_engine<UIntType,w,n,r,consts...>
+    ::philox_engine(result_type value)
+{
+  seed(value);
+} // end philox_engine::philox_engine()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  philox_engine<UIntType,w,n,r,consts...>
+    ::philox_engine(result_type value, result_type stream)
+{
+  seed(value, stream);
+} // end philox_engine::philox_engine()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  void philox_engine<UIntType,w,n,r,consts...>
+    ::seed(result_type value)
+{
+  for(size_t i = 0; i < n; ++i)
+  {
+    m_counter[i] = 0;
+    m_results[i] = 0;
+  }
+
+  m_key[0] = value & max;
+  for(size_t i = 1; i < n / 2; ++i)
+  {
+    m_key[i] = 0;
+  }
+
+  // no results are buffered
+  m_index = n;
+} // end philox_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  void philox_engine<UIntType,w,n,r,consts...>
+    ::seed(result_type value, result_type stream)
+{
+  seed(value);
+
+  // streams partition the counter space by its most significant word
+  m_counter[n - 1] = stream & max;
+} // end philox_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  typename philox_engine<UIntType,w,n,r,consts...>::result_type
+    philox_engine<UIntType,w,n,r,consts...>
+      ::operator()(void)
+{
+  if(m_index == n)
+  {
+    generate();
+  }
+
+  return m_results[m_index++];
+} // end philox_engine::operator()()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  void philox_engine<UIntType,w,n,r,consts...>
+    ::discard(unsigned long long z)
+{
+  // first use up the buffered results
+  const unsigned long long buffered = n - m_index;
+  if(z <= buffered)
+  {
+    m_index += static_cast<size_t>(z);
+    return;
+  }
+  z -= buffered;
+
+  // skip whole groups by moving the counter, then generate the group
+  // containing the next result
+  advance_counter(z / n);
+  m_index = n;
+
+  const size_t remainder = static_cast<size_t>(z % n);
+  if(remainder > 0)
+  {
+    generate();
+    m_index = remainder;
+  }
+} // end philox_engine::discard()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  void philox_engine<UIntType,w,n,r,consts...>
+    ::advance_counter(unsigned long long z)
+{
+  // add z to the counter, a little-endian n-word integer
+  result_type carry = 0;
+  for(size_t i = 0; i < n && (z > 0 || carry > 0); ++i)
+  {
+    const result_type addend = static_cast<result_type>(z & max);
+
+    // shifting by the full width of z is undefined, so shift in two steps
+    z = (z >> (w - 1)) >> 1;
+
+    const result_type sum = (m_counter[i] + addend) & max;
+    const result_type next_carry = (sum < addend) ? 1 : 0;
+
+    m_counter[i] = (sum + carry) & max;
+    carry = next_carry | ((carry > 0 && m_counter[i] == 0) ? 1 : 0);
+  }
+} // end philox_engine::advance_counter()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  void philox_engine<UIntType,w,n,r,consts...>
+    ::generate(void)
+{
+  round_type::apply(m_counter, m_key, m_results);
+  advance_counter(1);
+  m_index = 0;
+} // end philox_engine::generate()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& philox_engine<UIntType,w,n,r,consts...>
+      ::stream_out(std::basic_ostream<CharT,Traits> &os) const
+{
+  typedef std::basic_ostream<CharT,Traits> ostream_type;
+  typedef typename ostream_type::ios_base  ios_base;
+
+  // save old flags & fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill = os.fill();
+
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  // output the key, the counter, and the position in the current group
+  for(size_t i = 0; i < n / 2; ++i)
+  {
+    os << m_key[i] << space;
+  }
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    os << m_counter[i] << space;
+  }
+
+  os << m_index;
+
+  // restore flags & fill character
+  os.flags(flags);
+  os.fill(fill);
+
+  return os;
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& philox_engine<UIntType,w,n,r,consts...>
+      ::stream_in(std::basic_istream<CharT,Traits> &is)
+{
+  typedef std::basic_istream<CharT,Traits> istream_type;
+  typedef typename istream_type::ios_base     ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+
+  is.flags(ios_base::dec | ios_base::skipws);
+
+  // input the key, the counter, and the position in the current group
+  for(size_t i = 0; i < n / 2; ++i)
+  {
+    is >> m_key[i];
+  }
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    is >> m_counter[i];
+  }
+
+  is >> m_index;
+
+  // regenerate the current group, whose counter precedes m_counter
+  if(m_index < n)
+  {
+    result_type counter[n];
+    bool borrow = true;
+    for(size_t i = 0; i < n; ++i)
+    {
+      counter[i] = borrow ? ((m_counter[i] - 1) & max) : m_counter[i];
+      borrow     = borrow && m_counter[i] == 0;
+    }
+
+    round_type::apply(counter, m_key, m_results);
+  }
+
+  // restore flags
+  is.flags(flags);
+
+  return is;
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  __host__ __device__
+  bool philox_engine<UIntType,w,n,r,consts...>
+    ::equal(const philox_engine<UIntType,w,n,r,consts...> &rhs) const
+{
+  // the buffered results are a function of the key and counter
+  bool result = (m_index == rhs.m_index);
+
+  for(size_t i = 0; i < n / 2; ++i)
+  {
+    result = result && (m_key[i] == rhs.m_key[i]);
+  }
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    result = result && (m_counter[i] == rhs.m_counter[i]);
+  }
+
+  return result;
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+__host__ __device__
+bool operator==(const philox_engine<UIntType,w,n,r,consts...> &lhs,
+                const philox_engine<UIntType,w,n,r,consts...> &rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs,rhs);
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+__host__ __device__
+bool operator!=(const philox_engine<UIntType,w,n,r,consts...> &lhs,
+                const philox_engine<UIntType,w,n,r,consts...> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+template<typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const philox_engine<UIntType_,w_,n_,r_,consts_...> &e)
+{
+  return thrust::random::detail::random_core_access::stream_out(os,e);
+}
+
+
+template<typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           philox_engine<UIntType_,w_,n_,r_,consts_...> &e)
+{
+  return thrust::random::detail::random_core_access::stream_in(is,e);
+}
+
+
+} // end random
+
+THRUST_NAMESPACE_END
+
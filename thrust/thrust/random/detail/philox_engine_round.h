@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <cstddef> // for size_t
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+// the low w bits set
+template<typename T, size_t w>
+  struct philox_wordmask
+{
+  static const T value = static_cast<T>(((T(1u) << (w - 1)) << 1) - 1u);
+}; // end philox_wordmask
+
+
+// the i-th element of consts
+template<size_t i, typename T, T... consts>
+  struct philox_constant;
+
+template<typename T, T c, T... consts>
+  struct philox_constant<0, T, c, consts...>
+{
+  static const T value = c;
+};
+
+template<size_t i, typename T, T c, T... consts>
+  struct philox_constant<i, T, c, consts...>
+{
+  static const T value = philox_constant<i - 1, T, consts...>::value;
+};
+
+
+// the high and low w bits of the 2w-bit product a * b
+template<typename T, size_t w, bool narrow = (w <= 32)>
+  struct philox_mulhilo
+{
+  __host__ __device__
+  static void apply(T a, T b, T &hi, T &lo)
+  {
+    const thrust::detail::uint64_t p = thrust::detail::uint64_t(a) * thrust::detail::uint64_t(b);
+    hi = static_cast<T>(p >> w);
+    lo = static_cast<T>(p & philox_wordmask<thrust::detail::uint64_t,w>::value);
+  }
+}; // end philox_mulhilo
+
+template<typename T, size_t w>
+  struct philox_mulhilo<T,w,false>
+{
+  THRUST_STATIC_ASSERT(w == 64);
+
+  __host__ __device__
+  static void apply(T a, T b, T &hi, T &lo)
+  {
+    typedef thrust::detail::uint64_t uint64_t;
+
+    const uint64_t mask32 = 0xFFFFFFFFu;
+
+    const uint64_t a_lo = uint64_t(a) & mask32, a_hi = uint64_t(a) >> 32;
+    const uint64_t b_lo = uint64_t(b) & mask32, b_hi = uint64_t(b) >> 32;
+
+    const uint64_t ll = a_lo * b_lo;
+    const uint64_t lh = a_lo * b_hi;
+    const uint64_t hl = a_hi * b_lo;
+    const uint64_t hh = a_hi * b_hi;
+
+    const uint64_t mid = (ll >> 32) + (lh & mask32) + (hl & mask32);
+
+    hi = static_cast<T>(hh + (lh >> 32) + (hl >> 32) + (mid >> 32));
+    lo = static_cast<T>((mid << 32) | (ll & mask32));
+  }
+}; // end philox_mulhilo
+
+
+// encrypts an n-word counter under an n/2-word key with r rounds
+template<typename T, size_t w, size_t n, size_t r, T... consts>
+  struct philox_round;
+
+template<typename T, size_t w, size_t r, T... consts>
+  struct philox_round<T,w,2,r,consts...>
+{
+  __host__ __device__
+  static void apply(const T (&counter)[2], const T (&key)[1], T (&result)[2])
+  {
+    const T mask = philox_wordmask<T,w>::value;
+    const T m0   = philox_constant<0,T,consts...>::value;
+    const T c0   = philox_constant<1,T,consts...>::value;
+
+    T x0 = counter[0], x1 = counter[1];
+    T k0 = key[0];
+
+    for(size_t i = 0; i < r; ++i)
+    {
+      T hi, lo;
+      philox_mulhilo<T,w>::apply(m0, x0, hi, lo);
+
+      x0 = hi ^ k0 ^ x1;
+      x1 = lo;
+
+      k0 = (k0 + c0) & mask;
+    }
+
+    result[0] = x0;
+    result[1] = x1;
+  }
+}; // end philox_round
+
+template<typename T, size_t w, size_t r, T... consts>
+  struct philox_round<T,w,4,r,consts...>
+{
+  __host__ __device__
+  static void apply(const T (&counter)[4], const T (&key)[2], T (&result)[4])
+  {
+    const T mask = philox_wordmask<T,w>::value;
+    const T m0   = philox_constant<0,T,consts...>::value;
+    const T c0   = philox_constant<1,T,consts...>::value;
+    const T m1   = philox_constant<2,T,consts...>::value;
+    const T c1   = philox_constant<3,T,consts...>::value;
+
+    T x0 = counter[0], x1 = counter[1], x2 = counter[2], x3 = counter[3];
+    T k0 = key[0], k1 = key[1];
+
+    for(size_t i = 0; i < r; ++i)
+    {
+      T hi0, lo0, hi1, lo1;
+      philox_mulhilo<T,w>::apply(m0, x2, hi0, lo0);
+      philox_mulhilo<T,w>::apply(m1, x0, hi1, lo1);
+
+      x0 = hi0 ^ k0 ^ x1;
+      x1 = lo0;
+      x2 = hi1 ^ k1 ^ x3;
+      x3 = lo1;
+
+      k0 = (k0 + c0) & mask;
+      k1 = (k1 + c1) & mask;
+    }
+
+    result[0] = x0;
+    result[1] = x1;
+    result[2] = x2;
+    result[3] = x3;
+  }
+
+  // encrypts L counters in place, word i of counter j in x_i[j]. The rounds of
+  // independent counters interleave, which hides the latency of the multiplies
+  template<size_t L>
+  __host__ __device__
+  static void apply(T (&x0)[L], T (&x1)[L], T (&x2)[L], T (&x3)[L], const T (&key)[2])
+  {
+    const T mask = philox_wordmask<T,w>::value;
+    const T m0   = philox_constant<0,T,consts...>::value;
+    const T c0   = philox_constant<1,T,consts...>::value;
+    const T m1   = philox_constant<2,T,consts...>::value;
+    const T c1   = philox_constant<3,T,consts...>::value;
+
+    T k0 = key[0], k1 = key[1];
+
+    for(size_t i = 0; i < r; ++i)
+    {
+      for(size_t j = 0; j < L; ++j)
+      {
+        T hi0, lo0, hi1, lo1;
+        philox_mulhilo<T,w>::apply(m0, x2[j], hi0, lo0);
+        philox_mulhilo<T,w>::apply(m1, x0[j], hi1, lo1);
+
+        x0[j] = hi0 ^ k0 ^ x1[j];
+        x1[j] = lo0;
+        x2[j] = hi1 ^ k1 ^ x3[j];
+        x3[j] = lo1;
+      }
+
+      k0 = (k0 + c0) & mask;
+      k1 = (k1 + c1) & mask;
+    }
+  }
+}; // end philox_round
+
+} // end detail
+
+} // end random
+
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file generate_n.h
+ *  \brief Fills a range with samples of a random number distribution in parallel.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+/*! \addtogroup random
+ *  \{
+ */
+
+/*! \p generate_n fills the range <tt>[result, result + n)</tt> with samples of a
+ *  random number distribution, in parallel on the system of \p exec.
+ *
+ *  The samples are drawn from \p philox4x32_10 streams keyed by \p seed. The value
+ *  written to <tt>result[i]</tt> depends only on \p dist, \p seed and \c i, so the
+ *  output is the same for any \p exec, number of threads, and \p n.
+ *
+ *  \p uniform_real_distribution and \p normal_distribution of \c float and \c double,
+ *  and \p uniform_int_distribution, have batched implementations which convert
+ *  several samples per loop. \p uniform_int_distribution uses Lemire's
+ *  multiply-shift method, and \p normal_distribution the Box-Muller transform.
+ *  Other distributions are sampled one value at a time, and must be copyable to
+ *  the system of \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param dist The distribution to sample.
+ *  \param seed The seed of the random number engine.
+ *  \param result The beginning of the range to fill.
+ *  \param n The number of samples to generate.
+ *  \return <tt>result + n</tt>
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam Distribution is a random number distribution whose \c result_type is
+ *          convertible to \p RandomAccessIterator's \c value_type.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator is mutable.
+ *  \tparam Size is an integral type.
+ *
+ *  The following code snippet demonstrates how to fill a vector with normally
+ *  distributed noise using the \p thrust::omp::par execution policy:
+ *
+ *  \code
+ *  #include <thrust/random/generate_n.h>
+ *  #include <thrust/random/normal_distribution.h>
+ *  #include <thrust/system/omp/execution_policy.h>
+ *  #include <vector>
+ *  ...
+ *  std::vector<float> noise(1 << 30);
+ *
+ *  thrust::random::generate_n(thrust::omp::par,
+ *                             thrust::random::normal_distribution<float>(0.0f, 0.5f),
+ *                             2024,
+ *                             noise.begin(),
+ *                             noise.size());
+ *  \endcode
+ *
+ *  \see philox_engine
+ */
+template<typename DerivedPolicy,
+         typename Distribution,
+         typename RandomAccessIterator,
+         typename Size>
+__host__ __device__
+  RandomAccessIterator generate_n(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  const Distribution &dist,
+                                  thrust::detail::uint32_t seed,
+                                  RandomAccessIterator result,
+                                  Size n);
+
+
+/*! \p generate_n fills the range <tt>[result, result + n)</tt> with samples of a
+ *  random number distribution, in parallel on the system of \p result.
+ *
+ *  \param dist The distribution to sample.
+ *  \param seed The seed of the random number engine.
+ *  \param result The beginning of the range to fill.
+ *  \param n The number of samples to generate.
+ *  \return <tt>result + n</tt>
+ *
+ *  \tparam Distribution is a random number distribution whose \c result_type is
+ *          convertible to \p RandomAccessIterator's \c value_type.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator is mutable.
+ *  \tparam Size is an integral type.
+ *
+ *  \see philox_engine
+ */
+template<typename Distribution,
+         typename RandomAccessIterator,
+         typename Size>
+  RandomAccessIterator generate_n(const Distribution &dist,
+                                  thrust::detail::uint32_t seed,
+                                  RandomAccessIterator result,
+                                  Size n);
+
+/*! \} // end random
+ */
+
+} // end random
+
+THRUST_NAMESPACE_END
+
+#include <thrust/random/detail/generate_n.inl>
+
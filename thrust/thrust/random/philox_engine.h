@@ -0,0 +1,320 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file philox_engine.h
+ *  \brief A counter-based pseudorandom number generator.
+ */
+
+/*
+ * The Philox algorithm is described in
+ *
+ *   J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw,
+ *   "Parallel Random Numbers: As Easy as 1, 2, 3", SC11, 2011.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/random/detail/philox_engine_round.h>
+#include <thrust/random/detail/random_core_access.h>
+#include <iostream>
+#include <cstddef> // for size_t
+
+THRUST_NAMESPACE_BEGIN
+
+
+namespace random
+{
+
+/*! \addtogroup random_number_engine_templates
+ *  \{
+ */
+
+/*! \class philox_engine
+ *  \brief A \p philox_engine random number engine produces unsigned integer
+ *         random values by encrypting a counter with a key.
+ *
+ *  Unlike the other engines, whose state is advanced by a recurrence, the state
+ *  of a \p philox_engine is an <tt>n</tt>-word counter. Each group of \c n
+ *  results is a bijection of the counter under the key, which is derived from
+ *  the seed. This makes \p discard take constant time, and lets a parallel
+ *  algorithm give every element its own independent stream without any setup:
+ *
+ *  \code
+ *  #include <thrust/random/philox_engine.h>
+ *  #include <thrust/random/uniform_real_distribution.h>
+ *  #include <thrust/iterator/counting_iterator.h>
+ *  #include <thrust/transform.h>
+ *
+ *  struct sample
+ *  {
+ *    __host__ __device__
+ *    float operator()(unsigned int i) const
+ *    {
+ *      // element i draws from its own stream of 2^96 values
+ *      thrust::random::philox4x32_10 rng(2024, i);
+ *      thrust::random::uniform_real_distribution<float> dist;
+ *      return dist(rng);
+ *    }
+ *  };
+ *
+ *  ...
+ *  thrust::transform(thrust::counting_iterator<unsigned int>(0),
+ *                    thrust::counting_iterator<unsigned int>(n),
+ *                    result.begin(),
+ *                    sample());
+ *  \endcode
+ *
+ *  \tparam UIntType The type of unsigned integer to produce.
+ *  \tparam w The word size of the produced values (<tt>w <= 64</tt>).
+ *  \tparam n The number of words in the counter, and the number of values produced
+ *          per encryption. Must be \c 2 or \c 4.
+ *  \tparam r The number of rounds of the encryption.
+ *  \tparam consts The <tt>n / 2</tt> pairs of round multipliers and key increments,
+ *          in the order <tt>M0, C0, M1, C1</tt>.
+ *
+ *  \note The interface and the output sequence of \p philox_engine follow those of
+ *        \c std::philox_engine.
+ *
+ *  \see philox4x32_10
+ *  \see philox4x64_10
+ */
+template<typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+  class philox_engine
+{
+    THRUST_STATIC_ASSERT(n == 2 || n == 4);
+    THRUST_STATIC_ASSERT(sizeof...(consts) == n);
+    THRUST_STATIC_ASSERT(w > 0 && w <= 64 && w <= 8 * sizeof(UIntType));
+    THRUST_STATIC_ASSERT(r > 0);
+
+  public:
+    // types
+
+    /*! \typedef result_type
+     *  \brief The type of the unsigned integer produced by this \p philox_engine.
+     */
+    typedef UIntType result_type;
+
+    // engine characteristics
+
+    /*! The word size of the produced values.
+     */
+    static const size_t word_size = w;
+
+    /*! The number of words in the counter.
+     */
+    static const size_t word_count = n;
+
+    /*! The number of rounds of the encryption.
+     */
+    static const size_t round_count = r;
+
+    /*! The smallest value this \p philox_engine may potentially produce.
+     */
+    static const result_type min = 0;
+
+    /*! The largest value this \p philox_engine may potentially produce.
+     */
+    static const result_type max = detail::philox_wordmask<result_type,w>::value;
+
+    /*! The default seed of this \p philox_engine.
+     */
+    static const result_type default_seed = 20111115u;
+
+    // constructors and seeding functions
+
+    /*! This constructor, which optionally accepts a seed, initializes a new
+     *  \p philox_engine.
+     *
+     *  \param value The seed used to intialize this \p philox_engine's key.
+     */
+    __host__ __device__
+    explicit philox_engine(result_type value = default_seed);
+
+    /*! This constructor initializes a new \p philox_engine positioned at the start
+     *  of one of its streams. Engines with the same seed and different streams produce
+     *  non-overlapping sequences of <tt>n * 2^(w * (n - 1))</tt> values each.
+     *
+     *  \param value The seed used to intialize this \p philox_engine's key.
+     *  \param stream The stream to start at.
+     */
+    __host__ __device__
+    philox_engine(result_type value, result_type stream);
+
+    /*! This method initializes this \p philox_engine's state, and optionally accepts
+     *  a seed value.
+     *
+     *  \param value The seed used to initializes this \p philox_engine's key.
+     */
+    __host__ __device__
+    void seed(result_type value = default_seed);
+
+    /*! This method initializes this \p philox_engine's state at the start of one
+     *  of its streams.
+     *
+     *  \param value The seed used to initializes this \p philox_engine's key.
+     *  \param stream The stream to start at.
+     */
+    __host__ __device__
+    void seed(result_type value, result_type stream);
+
+    // generating functions
+
+    /*! This member function produces a new random value and updates this \p philox_engine's state.
+     *  \return A new random number.
+     */
+    __host__ __device__
+    result_type operator()(void);
+
+    /*! This member function advances this \p philox_engine's state a given number of times
+     *  and discards the results.
+     *
+     *  \param z The number of random values to discard.
+     *  \note This function takes constant time.
+     */
+    __host__ __device__
+    void discard(unsigned long long z);
+
+    /*! \cond
+     */
+  private:
+    typedef detail::philox_round<result_type,w,n,r,consts...> round_type;
+
+    // m_counter is the counter of the next group of results; m_results holds
+    // the current group, of which m_index have been returned
+    result_type m_counter[n];
+    result_type m_key[n / 2];
+    result_type m_results[n];
+    size_t      m_index;
+
+    __host__ __device__
+    void advance_counter(unsigned long long z);
+
+    __host__ __device__
+    void generate(void);
+
+    friend struct thrust::random::detail::random_core_access;
+
+    __host__ __device__
+    bool equal(const philox_engine &rhs) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& stream_out(std::basic_ostream<CharT,Traits> &os) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& stream_in(std::basic_istream<CharT,Traits> &is);
+
+    /*! \endcond
+     */
+}; // end philox_engine
+
+
+/*! This function checks two \p philox_engines for equality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_>
+__host__ __device__
+bool operator==(const philox_engine<UIntType_,w_,n_,r_,consts_...> &lhs,
+                const philox_engine<UIntType_,w_,n_,r_,consts_...> &rhs);
+
+
+/*! This function checks two \p philox_engines for inequality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_>
+__host__ __device__
+bool operator!=(const philox_engine<UIntType_,w_,n_,r_,consts_...> &lhs,
+                const philox_engine<UIntType_,w_,n_,r_,consts_...> &rhs);
+
+
+/*! This function streams a philox_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p philox_engine to stream out.
+ *  \return \p os
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const philox_engine<UIntType_,w_,n_,r_,consts_...> &e);
+
+
+/*! This function streams a philox_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p philox_engine to stream in.
+ *  \return \p is
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           philox_engine<UIntType_,w_,n_,r_,consts_...> &e);
+
+
+/*! \} // end random_number_engine_templates
+ */
+
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef philox4x32_10
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Philox-4x32-10 counter-based generator.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type
+ *        \p philox4x32_10 shall produce the value \c 1955073260 .
+ */
+typedef philox_engine<thrust::detail::uint32_t, 32, 4, 10,
+                      0xCD9E8D57u, 0x9E3779B9u, 0xD2511F53u, 0xBB67AE85u> philox4x32_10;
+
+
+/*! \typedef philox4x64_10
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Philox-4x64-10 counter-based generator.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type
+ *        \p philox4x64_10 shall produce the value \c 3409172418970261260 .
+ */
+typedef philox_engine<thrust::detail::uint64_t, 64, 4, 10,
+                      0xCA5A826395121157ull, 0x9E3779B97F4A7C15ull,
+                      0xD2E7470EE14C6C93ull, 0xBB67AE8584CAA73Bull> philox4x64_10;
+
+/*! \} // predefined_random
+ */
+
+} // end random
+
+// import names into thrust::
+using random::philox_engine;
+using random::philox4x32_10;
+using random::philox4x64_10;
+
+THRUST_NAMESPACE_END
+
+#include <thrust/random/detail/philox_engine.inl>
+
@@ -29,3 +29,64 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 // this system inherits the binary search algorithms
 #include <thrust/system/detail/sequential/binary_search.h>
 
+#include <thrust/system/detail/internal/batched_binary_search.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace cpp
+{
+namespace detail
+{
+
+
+// the vectorized searches are answered in tiles of values, which the systems deriving from cpp, like tbb,
+// search for in parallel
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    // search through the whole batch at once rather than value by value
+    return thrust::system::detail::internal::batched_binary_search(exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::internal::lower_bound_probe());
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    // search through the whole batch at once rather than value by value
+    return thrust::system::detail::internal::batched_binary_search(exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::internal::upper_bound_probe());
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+    // search through the whole batch at once rather than value by value
+    return thrust::system::detail::internal::batched_binary_search(exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::internal::binary_search_probe());
+}
+
+
+} // end detail
+} // end cpp
+} // end system
+THRUST_NAMESPACE_END
+
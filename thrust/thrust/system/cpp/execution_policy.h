@@ -67,6 +67,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/system/cpp/detail/scatter.h>
 #include <thrust/system/cpp/detail/sequence.h>
 #include <thrust/system/cpp/detail/set_operations.h>
+#include <thrust/system/cpp/detail/shuffle.h>
 #include <thrust/system/cpp/detail/sort.h>
 #include <thrust/system/cpp/detail/swap_ranges.h>
 #include <thrust/system/cpp/detail/tabulate.h>
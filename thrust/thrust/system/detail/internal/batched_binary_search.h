@@ -0,0 +1,344 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file batched_binary_search.h
+ *  \brief Vectorized lower_bound, upper_bound and binary_search for the host systems
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/distance.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/for_each.h>
+#include <thrust/detail/function.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+
+#include <utility>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the number of values searched for by a single task; the values of a tile are checked for
+// being sorted, and a sorted tile is answered by a single merge-like pass over the haystack
+const int batched_binary_search_tile_size = 1024;
+
+
+template<typename T>
+inline void batched_binary_search_prefetch(const T *ptr)
+{
+#if (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_GCC) || (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_CLANG)
+  __builtin_prefetch(ptr);
+#else
+  (void) ptr;
+#endif
+}
+
+// only raw pointers are worth prefetching; fancy iterators may not even refer to memory
+template<typename Iterator>
+inline void batched_binary_search_prefetch(Iterator)
+{
+}
+
+
+// The probes decide on which side of a value an element of the haystack lies. All three
+// searches look for the first element which isn't before the value; binary_search then
+// checks whether that element is equivalent to the value.
+struct lower_bound_probe
+{
+  template<typename Reference, typename T, typename StrictWeakOrdering>
+  static bool before(const Reference &x, const T &value, StrictWeakOrdering comp)
+  {
+    return comp(x, value);
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  static Size result(RandomAccessIterator, Size, Size pos, const T &, StrictWeakOrdering)
+  {
+    return pos;
+  }
+};
+
+
+struct upper_bound_probe
+{
+  template<typename Reference, typename T, typename StrictWeakOrdering>
+  static bool before(const Reference &x, const T &value, StrictWeakOrdering comp)
+  {
+    return !comp(value, x);
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  static Size result(RandomAccessIterator, Size, Size pos, const T &, StrictWeakOrdering)
+  {
+    return pos;
+  }
+};
+
+
+struct binary_search_probe
+{
+  template<typename Reference, typename T, typename StrictWeakOrdering>
+  static bool before(const Reference &x, const T &value, StrictWeakOrdering comp)
+  {
+    return comp(x, value);
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  static bool result(RandomAccessIterator first, Size n, Size pos, const T &value, StrictWeakOrdering comp)
+  {
+    return pos != n && !comp(value, first[pos]);
+  }
+};
+
+
+// Returns the index of the first element of [first, first + n) which isn't before value. The
+// loop has a fixed trip count and no data-dependent branches, so it doesn't suffer from branch
+// mispredictions, and the two elements the next iteration may probe are prefetched, so that
+// the cache misses of consecutive iterations overlap.
+template<typename Probe, typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+Size branchless_partition_point(RandomAccessIterator first, Size n, const T &value, StrictWeakOrdering comp)
+{
+  if(n == 0)
+  {
+    return 0;
+  }
+
+  Size base = 0;
+
+  while(n > 1)
+  {
+    Size half = n / 2;
+
+    batched_binary_search_prefetch(first + (base + half / 2));
+    batched_binary_search_prefetch(first + (base + half + half / 2));
+
+    base = Probe::before(first[base + half], value, comp) ? base + half : base;
+    n -= half;
+  }
+
+  return base + Probe::before(first[base], value, comp);
+}
+
+
+// Returns the index of the first element of [first + pos, first + n) which isn't before value,
+// knowing that no element before pos is. The distance from pos is found by doubling the step,
+// so that the cost is logarithmic in the distance rather than in n: searching for sorted values
+// costs about as much as merging them with the haystack when they are dense, and about as much
+// as independent searches when they are sparse.
+template<typename Probe, typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+Size galloping_partition_point(RandomAccessIterator first, Size pos, Size n, const T &value, StrictWeakOrdering comp)
+{
+  Size step = 1;
+
+  while(pos + step < n && Probe::before(first[pos + step], value, comp))
+  {
+    pos += step;
+    step *= 2;
+  }
+
+  Size last = pos + step < n ? pos + step : n;
+
+  return pos + branchless_partition_point<Probe>(first + pos, last - pos, value, comp);
+}
+
+
+// whether comp can compare two of the values searched for; the searches themselves only
+// compare values with elements of the haystack
+template<typename StrictWeakOrdering, typename T, typename = void>
+struct compares_values : thrust::detail::false_type
+{};
+
+template<typename StrictWeakOrdering, typename T>
+struct compares_values<
+  StrictWeakOrdering,
+  T,
+  ::cuda::std::__void_t<decltype(std::declval<StrictWeakOrdering &>()(std::declval<const T &>(), std::declval<const T &>()))>>
+    : thrust::detail::true_type
+{};
+
+
+// Finds the partition points of count values at once. Since the trip count of the branchless
+// search only depends on n, the searches can proceed in lockstep: the probes of the different
+// values are independent of each other, so their cache misses overlap, and the element each
+// search probes next is prefetched as soon as it is known.
+template<typename Probe, typename RandomAccessIterator, typename Size, typename InputIterator, typename StrictWeakOrdering>
+void interleaved_partition_points(RandomAccessIterator first, Size n, InputIterator values, int count, Size *result, StrictWeakOrdering comp)
+{
+  for(int j = 0; j < count; ++j)
+  {
+    result[j] = 0;
+  }
+
+  if(n == 0)
+  {
+    return;
+  }
+
+  while(n > 1)
+  {
+    Size half      = n / 2;
+    Size next_half = (n - half) / 2;
+
+    for(int j = 0; j < count; ++j)
+    {
+      result[j] = Probe::before(first[result[j] + half], values[j], comp) ? result[j] + half : result[j];
+      batched_binary_search_prefetch(first + (result[j] + next_half));
+    }
+
+    n -= half;
+  }
+
+  for(int j = 0; j < count; ++j)
+  {
+    result[j] += Probe::before(first[result[j]], values[j], comp);
+  }
+}
+
+
+template<typename RandomAccessIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering, typename Probe>
+struct batched_binary_search_functor
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type haystack_size;
+  typedef typename thrust::iterator_difference<InputIterator>::type        values_size;
+  typedef typename thrust::iterator_value<InputIterator>::type             value_type;
+
+  // the number of unsorted values searched for in lockstep
+  static const int interleaved_searches = 16;
+
+  RandomAccessIterator first;
+  haystack_size n;
+  InputIterator values;
+  values_size num_values;
+  OutputIterator output;
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> comp;
+
+  batched_binary_search_functor(RandomAccessIterator first,
+                                haystack_size n,
+                                InputIterator values,
+                                values_size num_values,
+                                OutputIterator output,
+                                StrictWeakOrdering comp)
+    : first(first), n(n), values(values), num_values(num_values), output(output), comp(comp)
+  {}
+
+  // without a way to compare the values with each other, every tile is treated as unsorted
+  bool is_sorted(values_size, values_size, thrust::detail::false_type) const
+  {
+    return false;
+  }
+
+  bool is_sorted(values_size begin, values_size end, thrust::detail::true_type) const
+  {
+    bool sorted = true;
+    for(values_size i = begin + 1; sorted && i < end; ++i)
+    {
+      sorted = !comp(values[i], values[i - 1]);
+    }
+
+    return sorted;
+  }
+
+  void operator()(values_size tile) const
+  {
+    values_size begin = tile * batched_binary_search_tile_size;
+    values_size end   = begin + batched_binary_search_tile_size < num_values ? begin + batched_binary_search_tile_size : num_values;
+
+    if(is_sorted(begin, end, compares_values<StrictWeakOrdering, value_type>()))
+    {
+      // the position of each value is at or after the position of the previous one
+      haystack_size pos = 0;
+      for(values_size i = begin; i < end; ++i)
+      {
+        value_type value = values[i];
+        pos = i == begin ? branchless_partition_point<Probe>(first, n, value, comp)
+                         : galloping_partition_point<Probe>(first, pos, n, value, comp);
+        output[i] = Probe::result(first, n, pos, value, comp);
+      }
+    }
+    else
+    {
+      for(values_size i = begin; i < end; i += interleaved_searches)
+      {
+        int count = end - i < interleaved_searches ? static_cast<int>(end - i) : interleaved_searches;
+
+        haystack_size pos[interleaved_searches];
+
+        // the values are read in place, so they need not be default constructible
+        interleaved_partition_points<Probe>(first, n, values + i, count, pos, comp);
+
+        for(int j = 0; j < count; ++j)
+        {
+          output[i + j] = Probe::result(first, n, pos[j], values[i + j], comp);
+        }
+      }
+    }
+  }
+};
+
+
+// Answers a vectorized search by splitting the values into tiles searched for in parallel.
+// Tiles of sorted values are answered by galloping through the haystack from the position of
+// the previous value, and other tiles by branchless binary searches.
+template<typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering, typename Probe>
+OutputIterator batched_binary_search(thrust::execution_policy<DerivedPolicy> &exec,
+                                     ForwardIterator begin,
+                                     ForwardIterator end,
+                                     InputIterator values_begin,
+                                     InputIterator values_end,
+                                     OutputIterator output,
+                                     StrictWeakOrdering comp,
+                                     Probe)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type values_size;
+
+  values_size num_values = thrust::distance(values_begin, values_end);
+  values_size num_tiles  = (num_values + batched_binary_search_tile_size - 1) / batched_binary_search_tile_size;
+
+  // search raw pointers, which can be prefetched, when the haystack is contiguous
+  typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<ForwardIterator> haystack_iterator;
+  haystack_iterator first = thrust::detail::try_unwrap_contiguous_iterator(begin);
+
+  thrust::for_each(exec,
+                   thrust::counting_iterator<values_size>(0),
+                   thrust::counting_iterator<values_size>(num_tiles),
+                   batched_binary_search_functor<haystack_iterator, InputIterator, OutputIterator, StrictWeakOrdering, Probe>(
+                     first, thrust::distance(begin, end), values_begin, num_values, output, comp));
+
+  return output + num_values;
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
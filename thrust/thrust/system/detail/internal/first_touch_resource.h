@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file first_touch_resource.h
+ *  \brief A memory resource placing the pages it allocates by touching them in parallel.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/new.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// Operating systems place a page of memory on the NUMA node of the thread which first writes to
+// it. This resource writes to every page of a large allocation as soon as it is allocated, with
+// the threads of a parallel system splitting the pages the way the algorithms of that system
+// split the elements of a range, so that they later work on node-local memory.
+//
+// PageToucher::touch(ptr, pages, page_size) writes to the first byte of each page in parallel.
+//
+// Only memory the upstream resource gets fresh from the operating system is placed; memory it
+// reuses stays where it was first touched.
+template<typename PageToucher>
+class first_touch_resource final : public thrust::mr::memory_resource<>
+{
+public:
+    // the smallest page size of the supported platforms; touching every 4 KiB also reaches every
+    // page when pages are larger
+    static const std::size_t page_size = 4096;
+
+    // smaller allocations are likely to be served from memory the upstream resource already holds,
+    // and aren't worth a parallel region
+    static const std::size_t min_touched_pages = 64;
+
+    THRUST_NODISCARD void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        void * p = m_upstream.do_allocate(bytes, upstream_alignment(bytes, alignment));
+
+        if (bytes >= min_touched_pages * page_size)
+        {
+            PageToucher::touch(static_cast<char *>(p), (bytes + page_size - 1) / page_size, page_size);
+        }
+
+        return p;
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        m_upstream.do_deallocate(p, bytes, upstream_alignment(bytes, alignment));
+    }
+
+private:
+    // large allocations start at a page boundary, so that the threads split whole pages
+    static std::size_t upstream_alignment(std::size_t bytes, std::size_t alignment)
+    {
+        return bytes >= min_touched_pages * page_size && alignment < page_size ? page_size : alignment;
+    }
+
+    thrust::mr::new_delete_resource m_upstream;
+};
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
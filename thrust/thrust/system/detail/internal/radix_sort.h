@@ -0,0 +1,399 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file radix_sort.h
+ *  \brief Tiled LSD radix sort shared by the parallel host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/system/detail/internal/decompose.h>
+
+#include <cstring>
+#include <limits>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace radix_sort_detail
+{
+
+
+template<int Bytes> struct unsigned_bits;
+template<> struct unsigned_bits<1> { typedef thrust::detail::uint8_t  type; };
+template<> struct unsigned_bits<2> { typedef thrust::detail::uint16_t type; };
+template<> struct unsigned_bits<4> { typedef thrust::detail::uint32_t type; };
+template<> struct unsigned_bits<8> { typedef thrust::detail::uint64_t type; };
+
+
+// maps a key onto an unsigned integer whose ascending order matches the
+// ascending order of the key
+template<typename KeyType,
+         bool IsFloatingPoint = thrust::detail::is_floating_point<KeyType>::value,
+         bool IsSigned        = std::numeric_limits<KeyType>::is_signed>
+struct radix_encoder
+{
+  typedef typename unsigned_bits<sizeof(KeyType)>::type type;
+
+  type operator()(const KeyType &key) const
+  {
+    type bits;
+    std::memcpy(&bits, &key, sizeof(KeyType));
+    return bits;
+  }
+};
+
+template<typename KeyType>
+struct radix_encoder<KeyType, false, true>
+{
+  typedef typename unsigned_bits<sizeof(KeyType)>::type type;
+
+  type operator()(const KeyType &key) const
+  {
+    type bits;
+    std::memcpy(&bits, &key, sizeof(KeyType));
+
+    // flip the sign bit so that negative keys order before positive keys
+    return bits ^ (type(1) << (8 * sizeof(type) - 1));
+  }
+};
+
+template<typename KeyType, bool IsSigned>
+struct radix_encoder<KeyType, true, IsSigned>
+{
+  typedef typename unsigned_bits<sizeof(KeyType)>::type type;
+
+  type operator()(const KeyType &key) const
+  {
+    type bits;
+    std::memcpy(&bits, &key, sizeof(KeyType));
+
+    // negative keys flip every bit, positive keys only flip the sign bit
+    const type sign_bit = type(1) << (8 * sizeof(type) - 1);
+    const type mask     = (bits & sign_bit) ? type(~type(0)) : sign_bit;
+
+    return bits ^ mask;
+  }
+};
+
+
+// the radix sort applies to arithmetic keys ordered by thrust::less or
+// thrust::greater, the same condition the sequential backend uses to select
+// its own radix sort
+template<typename KeyType, typename Compare>
+struct use_radix_sort
+  : thrust::detail::and_<
+      thrust::detail::is_non_bool_arithmetic<KeyType>,
+      thrust::detail::or_<
+        thrust::detail::is_same<Compare, thrust::less<KeyType> >,
+        thrust::detail::is_same<Compare, thrust::greater<KeyType> >
+      >
+    >
+{};
+
+
+template<typename KeyType>
+struct is_descending
+  : thrust::detail::false_type
+{};
+
+template<typename KeyType>
+struct is_descending<thrust::greater<KeyType> >
+  : thrust::detail::true_type
+{};
+
+
+const static int radix_bits = 8;
+const static int radix_size = 1 << radix_bits;
+
+
+template<typename RandomAccessIterator, typename Size, typename Encoder>
+struct histogram_body
+{
+  typedef typename Encoder::type bits_type;
+
+  RandomAccessIterator                first;
+  const uniform_decomposition<Size>  &decomp;
+  Size                               *counts;
+  Encoder                             encode;
+  bits_type                           mask;
+  int                                 shift;
+
+  histogram_body(RandomAccessIterator first,
+                 const uniform_decomposition<Size> &decomp,
+                 Size *counts,
+                 Encoder encode,
+                 bits_type mask,
+                 int shift)
+    : first(first), decomp(decomp), counts(counts), encode(encode), mask(mask), shift(shift)
+  {}
+
+  void operator()(Size tile) const
+  {
+    Size *tile_counts = counts + tile * radix_size;
+
+    for(int d = 0; d < radix_size; d++)
+    {
+      tile_counts[d] = 0;
+    }
+
+    RandomAccessIterator iter = first + decomp[tile].begin();
+    RandomAccessIterator last = first + decomp[tile].end();
+
+    for(; iter != last; ++iter)
+    {
+      tile_counts[((encode(*iter) ^ mask) >> shift) & (radix_size - 1)]++;
+    }
+  }
+};
+
+
+template<bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size,
+         typename Encoder>
+struct scatter_body
+{
+  typedef typename Encoder::type bits_type;
+
+  RandomAccessIterator1               keys_src;
+  RandomAccessIterator2               values_src;
+  RandomAccessIterator3               keys_dst;
+  RandomAccessIterator4               values_dst;
+  const uniform_decomposition<Size>  &decomp;
+  Size                               *offsets;
+  Encoder                             encode;
+  bits_type                           mask;
+  int                                 shift;
+
+  scatter_body(RandomAccessIterator1 keys_src,
+               RandomAccessIterator2 values_src,
+               RandomAccessIterator3 keys_dst,
+               RandomAccessIterator4 values_dst,
+               const uniform_decomposition<Size> &decomp,
+               Size *offsets,
+               Encoder encode,
+               bits_type mask,
+               int shift)
+    : keys_src(keys_src), values_src(values_src),
+      keys_dst(keys_dst), values_dst(values_dst),
+      decomp(decomp), offsets(offsets), encode(encode), mask(mask), shift(shift)
+  {}
+
+  void operator()(Size tile) const
+  {
+    // each tile owns a disjoint, ascending slice of every bucket, so the
+    // scatter is stable and free of synchronization
+    Size *tile_offsets = offsets + tile * radix_size;
+
+    for(Size i = decomp[tile].begin(); i < decomp[tile].end(); i++)
+    {
+      Size pos = tile_offsets[((encode(keys_src[i]) ^ mask) >> shift) & (radix_size - 1)]++;
+
+      keys_dst[pos] = keys_src[i];
+
+      if(HasValues)
+      {
+        values_dst[pos] = values_src[i];
+      }
+    }
+  }
+};
+
+
+template<bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size>
+struct copy_body
+{
+  RandomAccessIterator1               keys_src;
+  RandomAccessIterator2               values_src;
+  RandomAccessIterator3               keys_dst;
+  RandomAccessIterator4               values_dst;
+  const uniform_decomposition<Size>  &decomp;
+
+  copy_body(RandomAccessIterator1 keys_src,
+            RandomAccessIterator2 values_src,
+            RandomAccessIterator3 keys_dst,
+            RandomAccessIterator4 values_dst,
+            const uniform_decomposition<Size> &decomp)
+    : keys_src(keys_src), values_src(values_src),
+      keys_dst(keys_dst), values_dst(values_dst),
+      decomp(decomp)
+  {}
+
+  void operator()(Size tile) const
+  {
+    for(Size i = decomp[tile].begin(); i < decomp[tile].end(); i++)
+    {
+      keys_dst[i] = keys_src[i];
+
+      if(HasValues)
+      {
+        values_dst[i] = values_src[i];
+      }
+    }
+  }
+};
+
+
+// one counting pass followed by one stable scatter pass from src into dst;
+// returns false without moving anything when every key shares this digit
+template<bool HasValues,
+         typename TileLoop,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size,
+         typename Encoder>
+bool radix_sort_pass(TileLoop tile_loop,
+                     RandomAccessIterator1 keys_src,
+                     RandomAccessIterator2 values_src,
+                     RandomAccessIterator3 keys_dst,
+                     RandomAccessIterator4 values_dst,
+                     const uniform_decomposition<Size> &decomp,
+                     Size *counts,
+                     Encoder encode,
+                     typename Encoder::type mask,
+                     int shift)
+{
+  const Size num_tiles = decomp.size();
+  const Size n         = decomp[num_tiles - 1].end();
+
+  tile_loop(num_tiles, histogram_body<RandomAccessIterator1,Size,Encoder>(keys_src, decomp, counts, encode, mask, shift));
+
+  // turn the per-tile counts into per-tile starting offsets, ordered by
+  // digit first and tile second
+  Size sum = 0;
+  for(int d = 0; d < radix_size; d++)
+  {
+    Size digit_count = 0;
+
+    for(Size tile = 0; tile < num_tiles; tile++)
+    {
+      Size count = counts[tile * radix_size + d];
+      counts[tile * radix_size + d] = sum + digit_count;
+      digit_count += count;
+    }
+
+    if(digit_count == n)
+    {
+      return false;
+    }
+
+    sum += digit_count;
+  }
+
+  tile_loop(num_tiles,
+            scatter_body<HasValues,RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,RandomAccessIterator4,Size,Encoder>(
+              keys_src, values_src, keys_dst, values_dst, decomp, counts, encode, mask, shift));
+
+  return true;
+}
+
+
+// sorts [keys_first, keys_first + n) and, if HasValues, permutes the values
+// alongside. tile_loop(num_tiles, body) must invoke body(tile) once for every
+// tile in [0, num_tiles), possibly in parallel.
+template<bool HasValues,
+         typename TileLoop,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+void radix_sort(TileLoop tile_loop,
+                thrust::execution_policy<DerivedPolicy> &exec,
+                RandomAccessIterator1 keys_first,
+                RandomAccessIterator2 values_first,
+                Size n,
+                Size num_tiles,
+                StrictWeakOrdering)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type ValueType;
+  typedef radix_encoder<KeyType>                                       Encoder;
+  typedef typename Encoder::type                                       bits_type;
+
+  // descending order is ascending order of the complemented bits, which
+  // keeps equivalent keys in their original order
+  const bits_type mask = is_descending<StrictWeakOrdering>::value ? bits_type(~bits_type(0)) : bits_type(0);
+
+  uniform_decomposition<Size> decomp(n, 1, num_tiles);
+
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   keys_temp(0, exec, n);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> values_temp(exec, HasValues ? n : 0);
+  thrust::detail::temporary_array<Size,DerivedPolicy>      counts(0, exec, decomp.size() * radix_size);
+
+  KeyType   *keys_ptr   = thrust::raw_pointer_cast(keys_temp.data());
+  ValueType *values_ptr = thrust::raw_pointer_cast(values_temp.data());
+  Size      *counts_ptr = thrust::raw_pointer_cast(counts.data());
+
+  // ping-pong between the input and the temporary buffers
+  bool in_temp = false;
+
+  for(int shift = 0; shift < int(8 * sizeof(bits_type)); shift += radix_bits)
+  {
+    bool moved = in_temp ?
+      radix_sort_pass<HasValues>(tile_loop, keys_ptr, values_ptr, keys_first, values_first, decomp, counts_ptr, Encoder(), mask, shift) :
+      radix_sort_pass<HasValues>(tile_loop, keys_first, values_first, keys_ptr, values_ptr, decomp, counts_ptr, Encoder(), mask, shift);
+
+    if(moved)
+    {
+      in_temp = !in_temp;
+    }
+  }
+
+  if(in_temp)
+  {
+    tile_loop(decomp.size(),
+              copy_body<HasValues,KeyType*,ValueType*,RandomAccessIterator1,RandomAccessIterator2,Size>(
+                keys_ptr, values_ptr, keys_first, values_first, decomp));
+  }
+}
+
+
+} // end namespace radix_sort_detail
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
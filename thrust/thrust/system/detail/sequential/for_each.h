@@ -29,6 +29,7 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/detail/function.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -40,15 +41,19 @@ namespace sequential
 {
 
 
+namespace for_each_detail
+{
+
+
 __thrust_exec_check_disable__
-template<typename DerivedPolicy,
-         typename InputIterator,
+template<typename InputIterator,
+         typename Size,
          typename UnaryFunction>
 __host__ __device__
-InputIterator for_each(sequential::execution_policy<DerivedPolicy> &,
-                       InputIterator first,
-                       InputIterator last,
-                       UnaryFunction f)
+InputIterator for_each_n(InputIterator first,
+                         Size n,
+                         UnaryFunction f,
+                         thrust::detail::false_type)
 {
   // wrap f
   thrust::detail::wrapped_function<
@@ -56,24 +61,43 @@ InputIterator for_each(sequential::execution_policy<DerivedPolicy> &,
     void
   > wrapped_f(f);
 
-  for(; first != last; ++first)
+  for(Size i = 0; i != n; i++)
   {
+    // we can dereference an OutputIterator if f does not
+    // try to use the reference for anything besides assignment
     wrapped_f(*first);
+    ++first;
   }
 
   return first;
-} // end for_each()
+} // end for_each_n()
 
 
-template<typename DerivedPolicy,
-         typename InputIterator,
+// visit raw pointers rather than system references when the range is contiguous
+__thrust_exec_check_disable__
+template<typename ContiguousIterator,
          typename Size,
          typename UnaryFunction>
 __host__ __device__
-InputIterator for_each_n(sequential::execution_policy<DerivedPolicy> &,
-                         InputIterator first,
-                         Size n,
-                         UnaryFunction f)
+ContiguousIterator for_each_n(ContiguousIterator first,
+                              Size n,
+                              UnaryFunction f,
+                              thrust::detail::true_type)
+{
+  for_each_detail::for_each_n(thrust::detail::try_unwrap_contiguous_iterator(first), n, f, thrust::detail::false_type());
+
+  return first + n;
+} // end for_each_n()
+
+
+__thrust_exec_check_disable__
+template<typename InputIterator,
+         typename UnaryFunction>
+__host__ __device__
+InputIterator for_each(InputIterator first,
+                       InputIterator last,
+                       UnaryFunction f,
+                       thrust::detail::false_type)
 {
   // wrap f
   thrust::detail::wrapped_function<
@@ -81,15 +105,59 @@ InputIterator for_each_n(sequential::execution_policy<DerivedPolicy> &,
     void
   > wrapped_f(f);
 
-  for(Size i = 0; i != n; i++)
+  for(; first != last; ++first)
   {
-    // we can dereference an OutputIterator if f does not
-    // try to use the reference for anything besides assignment
     wrapped_f(*first);
-    ++first;
   }
 
   return first;
+} // end for_each()
+
+
+__thrust_exec_check_disable__
+template<typename ContiguousIterator,
+         typename UnaryFunction>
+__host__ __device__
+ContiguousIterator for_each(ContiguousIterator first,
+                            ContiguousIterator last,
+                            UnaryFunction f,
+                            thrust::detail::true_type)
+{
+  for_each_detail::for_each_n(thrust::detail::try_unwrap_contiguous_iterator(first), last - first, f, thrust::detail::false_type());
+
+  return last;
+} // end for_each()
+
+
+} // end for_each_detail
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename UnaryFunction>
+__host__ __device__
+InputIterator for_each(sequential::execution_policy<DerivedPolicy> &,
+                       InputIterator first,
+                       InputIterator last,
+                       UnaryFunction f)
+{
+  return for_each_detail::for_each(first, last, f, thrust::is_contiguous_iterator<InputIterator>());
+} // end for_each()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename UnaryFunction>
+__host__ __device__
+InputIterator for_each_n(sequential::execution_policy<DerivedPolicy> &,
+                         InputIterator first,
+                         Size n,
+                         UnaryFunction f)
+{
+  return for_each_detail::for_each_n(first, n, f, thrust::is_contiguous_iterator<InputIterator>());
 } // end for_each_n()
 
 
@@ -29,6 +29,7 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/detail/function.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -58,13 +59,19 @@ __host__ __device__
     OutputType
   > wrapped_binary_op(binary_op);
 
+  // reduce raw pointers rather than system references when the input is contiguous
+  typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<InputIterator> Iterator;
+
+  Iterator raw_begin = thrust::detail::try_unwrap_contiguous_iterator(begin);
+  Iterator raw_end   = thrust::detail::try_unwrap_contiguous_iterator(end);
+
   // initialize the result
   OutputType result = init;
 
-  while(begin != end)
+  while(raw_begin != raw_end)
   {
-    result = wrapped_binary_op(result, *begin);
-    ++begin;
+    result = wrapped_binary_op(result, *raw_begin);
+    ++raw_begin;
   } // end while
 
   return result;
@@ -25,6 +25,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/omp/detail/execution_policy.h>
 #include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/detail/internal/batched_binary_search.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -71,6 +72,48 @@ bool binary_search(execution_policy<DerivedPolicy> &exec,
 }
 
 
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    // omp prefers searching through the whole batch at once, in parallel tiles, to generic's search value by value
+    return thrust::system::detail::internal::batched_binary_search(exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::internal::lower_bound_probe());
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    // omp prefers searching through the whole batch at once, in parallel tiles, to generic's search value by value
+    return thrust::system::detail::internal::batched_binary_search(exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::internal::upper_bound_probe());
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+    // omp prefers searching through the whole batch at once, in parallel tiles, to generic's search value by value
+    return thrust::system::detail::internal::batched_binary_search(exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::internal::binary_search_probe());
+}
+
+
 } // end detail
 } // end omp
 } // end system
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file compact_intervals.h
+ *  \brief OpenMP building blocks for stream compaction.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// counts[i] receives the number of elements of interval i of decomp
+// whose stencil satisfies pred
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename Size,
+          typename Predicate,
+          typename Decomposition>
+void count_if_intervals(execution_policy<DerivedPolicy> &exec,
+                        InputIterator stencil,
+                        Size *counts,
+                        Predicate pred,
+                        Decomposition decomp);
+
+// copies the elements of interval i of decomp whose stencil satisfies pred
+// to result + offsets[i], preserving their order
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename Size,
+          typename Predicate,
+          typename Decomposition>
+void copy_if_intervals(execution_policy<DerivedPolicy> &exec,
+                       InputIterator1 first,
+                       InputIterator2 stencil,
+                       OutputIterator result,
+                       const Size *offsets,
+                       Predicate pred,
+                       Decomposition decomp);
+
+// moves the offsets[i + 1] - offsets[i] elements starting at first + starts[i]
+// to first + offsets[i] for every interval i of decomp; the elements of the
+// first interval must already be in place
+template <typename DerivedPolicy,
+          typename RandomAccessIterator,
+          typename Size,
+          typename Decomposition>
+void compact_intervals(execution_policy<DerivedPolicy> &exec,
+                       RandomAccessIterator first,
+                       const Size *starts,
+                       const Size *offsets,
+                       Decomposition decomp);
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/omp/detail/compact_intervals.inl>
+
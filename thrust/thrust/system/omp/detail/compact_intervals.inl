@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/compact_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename Size,
+          typename Predicate,
+          typename Decomposition>
+void count_if_intervals(execution_policy<DerivedPolicy> &exec,
+                        InputIterator stencil,
+                        Size *counts,
+                        Predicate pred,
+                        Decomposition decomp)
+{
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    InputIterator begin = stencil + decomp[i].begin();
+    InputIterator end   = stencil + decomp[i].end();
+
+    Size count = 0;
+
+    for(; begin != end; ++begin)
+    {
+      if(wrapped_pred(*begin))
+      {
+        ++count;
+      }
+    }
+
+    counts[i] = count;
+  }
+}
+
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename Size,
+          typename Predicate,
+          typename Decomposition>
+void copy_if_intervals(execution_policy<DerivedPolicy> &exec,
+                       InputIterator1 first,
+                       InputIterator2 stencil,
+                       OutputIterator result,
+                       const Size *offsets,
+                       Predicate pred,
+                       Decomposition decomp)
+{
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    InputIterator1 begin = first   + decomp[i].begin();
+    InputIterator1 end   = first   + decomp[i].end();
+    InputIterator2 s     = stencil + decomp[i].begin();
+    OutputIterator out   = result  + offsets[i];
+
+    for(; begin != end; ++begin, ++s)
+    {
+      if(wrapped_pred(*s))
+      {
+        *out = *begin;
+        ++out;
+      }
+    }
+  }
+}
+
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator,
+          typename Size,
+          typename Decomposition>
+void compact_intervals(execution_policy<DerivedPolicy> &exec,
+                       RandomAccessIterator first,
+                       const Size *starts,
+                       const Size *offsets,
+                       Decomposition decomp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type ValueType;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  // the destination of an interval may overlap the source of an earlier
+  // one, so stage everything past the first interval through a buffer
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> buffer(exec, offsets[n] - offsets[1]);
+
+  ValueType *staged = thrust::raw_pointer_cast(buffer.data());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 1; i < n; i++)
+  {
+    for(Size j = 0; j < offsets[i + 1] - offsets[i]; j++)
+    {
+      staged[offsets[i] - offsets[1] + j] = first[starts[i] + j];
+    }
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 1; i < n; i++)
+  {
+    for(Size j = offsets[i]; j < offsets[i + 1]; j++)
+    {
+      first[j] = staged[j - offsets[1]];
+    }
+  }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
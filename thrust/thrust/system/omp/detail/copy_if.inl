@@ -24,7 +24,11 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/omp/detail/copy_if.h>
-#include <thrust/system/detail/generic/copy_if.h>
+#include <thrust/system/omp/detail/compact_intervals.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -47,8 +51,34 @@ template<typename DerivedPolicy,
                          OutputIterator result,
                          Predicate pred)
 {
-  // omp prefers generic::copy_if to cpp::copy_if
-  return thrust::system::detail::generic::copy_if(exec, first, last, stencil, result, pred);
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return result;
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  // count the survivors of each interval
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, decomp.size() + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  thrust::system::omp::detail::count_if_intervals(exec, stencil, offsets_ptr + 1, pred, decomp);
+
+  // scan the counts serially; there is one per thread
+  offsets_ptr[0] = 0;
+
+  for(difference_type i = 0; i < decomp.size(); ++i)
+  {
+    offsets_ptr[i + 1] += offsets_ptr[i];
+  }
+
+  // each interval writes its survivors at its offset
+  thrust::system::omp::detail::copy_if_intervals(exec, first, stencil, result, offsets_ptr, pred, decomp);
+
+  return result + offsets_ptr[decomp.size()];
 } // end copy_if()
 
 
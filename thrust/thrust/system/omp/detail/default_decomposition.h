@@ -29,6 +29,7 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -38,8 +39,10 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n);
+// one interval per thread of the policy's parallel regions
+template <typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType>
+default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n);
 
 } // end namespace detail
 } // end namespace omp
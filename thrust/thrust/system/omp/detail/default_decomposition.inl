@@ -24,11 +24,7 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/omp/detail/default_decomposition.h>
-
-// don't attempt to #include this file without omp support
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#include <omp.h>
-#endif // omp support
+#include <thrust/system/omp/detail/tuning.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -38,8 +34,9 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n)
+template <typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType>
+default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -53,11 +50,7 @@ thrust::system::detail::internal::uniform_decomposition<IndexType> default_decom
   , "OpenMP compiler support is not enabled"
   );
 
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, omp_get_num_procs());
-#else
-  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, 1);
-#endif
+  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, tuning_of(exec).num_intervals());
 }
 
 } // end namespace detail
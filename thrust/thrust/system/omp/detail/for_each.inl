@@ -28,7 +28,8 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/distance.h>
 #include <thrust/for_each.h>
 #include <thrust/iterator/iterator_traits.h>
-#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/system/omp/detail/tuning.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -37,12 +38,34 @@ namespace omp
 {
 namespace detail
 {
+namespace for_each_detail
+{
+
+template<typename Iterator, typename Function>
+struct body
+{
+  Iterator first;
+  Function f;
+
+  body(Iterator first, Function f)
+    : first(first), f(f)
+  {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    Iterator temp = first + i;
+    f(*temp);
+  }
+};
+
+} // end for_each_detail
 
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
@@ -68,14 +91,12 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type DifferenceType;
   DifferenceType signed_n = n;
 
-  THRUST_PRAGMA_OMP(parallel for)
-  for(DifferenceType i = 0;
-      i < signed_n;
-      ++i)
-  {
-    RandomAccessIterator temp = first + i;
-    wrapped_f(*temp);
-  }
+  // visit raw pointers rather than system references when the range is contiguous
+  typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<RandomAccessIterator> Iterator;
+  Iterator raw_first = thrust::detail::try_unwrap_contiguous_iterator(first);
+
+  for_each_detail::body<Iterator, thrust::detail::wrapped_function<UnaryFunction,void> > body(raw_first, wrapped_f);
+  tuned_parallel_for(tuning_of(exec), signed_n, body);
 
   return first + n;
 } // end for_each_n()
@@ -0,0 +1,196 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/merge.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace merge_detail
+{
+
+
+// returns the number of elements of [first1, first1 + n1) which precede the
+// diag-th element of the stable merge of [first1, first1 + n1) and
+// [first2, first2 + n2); the remaining diag - result elements come from
+// [first2, first2 + n2)
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+Size merge_path(RandomAccessIterator1 first1, Size n1,
+                RandomAccessIterator2 first2, Size n2,
+                Size diag,
+                StrictWeakOrdering comp)
+{
+  Size lo = (diag > n2) ? diag - n2 : Size(0);
+  Size hi = (diag < n1) ? diag      : n1;
+
+  while(lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    // elements of the first range win ties, keeping the merge stable
+    if(comp(first2[diag - 1 - mid], first1[mid]))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+
+} // end namespace merge_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
+                     InputIterator1 first1,
+                     InputIterator1 last1,
+                     InputIterator2 first2,
+                     InputIterator2 last2,
+                     OutputIterator result,
+                     StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  const Size n1 = last1 - first1;
+  const Size n2 = last2 - first2;
+
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp = thrust::system::omp::detail::default_decomposition(exec, n1 + n2);
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // each thread searches for the start and end of its interval along the
+  // merge path and then merges its share of both ranges sequentially
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < num_intervals; i++)
+  {
+    const Size diag_first = decomp[i].begin();
+    const Size diag_last  = decomp[i].end();
+
+    const Size mid1_first = merge_detail::merge_path(first1, n1, first2, n2, diag_first, wrapped_comp);
+    const Size mid1_last  = merge_detail::merge_path(first1, n1, first2, n2, diag_last,  wrapped_comp);
+
+    thrust::merge(thrust::seq,
+                  first1 + mid1_first, first1 + mid1_last,
+                  first2 + (diag_first - mid1_first), first2 + (diag_last - mid1_last),
+                  result + diag_first,
+                  comp);
+  }
+
+  return result + (n1 + n2);
+} // end merge()
+
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InputIterator3,
+          typename InputIterator4,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename StrictWeakOrdering>
+thrust::pair<OutputIterator1,OutputIterator2>
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
+               InputIterator1 keys_first1,
+               InputIterator1 keys_last1,
+               InputIterator2 keys_first2,
+               InputIterator2 keys_last2,
+               InputIterator3 values_first1,
+               InputIterator4 values_first2,
+               OutputIterator1 keys_result,
+               OutputIterator2 values_result,
+               StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  const Size n1 = keys_last1 - keys_first1;
+  const Size n2 = keys_last2 - keys_first2;
+
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp = thrust::system::omp::detail::default_decomposition(exec, n1 + n2);
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < num_intervals; i++)
+  {
+    const Size diag_first = decomp[i].begin();
+    const Size diag_last  = decomp[i].end();
+
+    const Size mid1_first = merge_detail::merge_path(keys_first1, n1, keys_first2, n2, diag_first, wrapped_comp);
+    const Size mid1_last  = merge_detail::merge_path(keys_first1, n1, keys_first2, n2, diag_last,  wrapped_comp);
+
+    const Size mid2_first = diag_first - mid1_first;
+    const Size mid2_last  = diag_last  - mid1_last;
+
+    thrust::merge_by_key(thrust::seq,
+                         keys_first1 + mid1_first, keys_first1 + mid1_last,
+                         keys_first2 + mid2_first, keys_first2 + mid2_last,
+                         values_first1 + mid1_first,
+                         values_first2 + mid2_first,
+                         keys_result + diag_first,
+                         values_result + diag_first,
+                         comp);
+  }
+
+  return thrust::make_pair(keys_result + (n1 + n2), values_result + (n1 + n2));
+} // end merge_by_key()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
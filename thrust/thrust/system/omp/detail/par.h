@@ -25,6 +25,9 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/detail/allocator_aware_execution_policy.h>
 #include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/omp/detail/tuning.h>
+
+#include <utility>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -37,10 +40,16 @@ namespace detail
 
 struct par_t : thrust::system::omp::detail::execution_policy<par_t>,
   thrust::detail::allocator_aware_execution_policy<
-    thrust::system::omp::detail::execution_policy>
+    thrust::system::omp::detail::execute_with_tuning_base>
 {
   __host__ __device__
   constexpr par_t() : thrust::system::omp::detail::execution_policy<par_t>() {}
+
+  template<typename... Args>
+  execute_with_tuning with(Args&&... args) const
+  {
+    return execute_with_tuning().with(std::forward<Args>(args)...);
+  }
 };
 
 
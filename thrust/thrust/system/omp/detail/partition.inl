@@ -30,6 +30,15 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/omp/detail/partition.h>
 #include <thrust/system/detail/generic/partition.h>
+#include <thrust/system/omp/detail/compact_intervals.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/distance.h>
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -81,8 +90,7 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  return thrust::system::omp::detail::stable_partition_copy(exec, first, last, first, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 
@@ -101,8 +109,63 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return thrust::make_pair(out_true, out_false);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_intervals = decomp.size();
+
+  // count the true elements of each interval
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_intervals + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  thrust::system::omp::detail::count_if_intervals(exec, stencil, offsets_ptr + 1, pred, decomp);
+
+  // scan the counts serially; there is one per thread
+  offsets_ptr[0] = 0;
+
+  for(difference_type i = 0; i < num_intervals; ++i)
+  {
+    offsets_ptr[i + 1] += offsets_ptr[i];
+  }
+
+  // the false elements preceding an interval are the elements preceding it
+  // which were not true
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(difference_type i = 0; i < num_intervals; i++)
+  {
+    InputIterator1  begin = first   + decomp[i].begin();
+    InputIterator1  end   = first   + decomp[i].end();
+    InputIterator2  s     = stencil + decomp[i].begin();
+    OutputIterator1 t     = out_true  + offsets_ptr[i];
+    OutputIterator2 f     = out_false + (decomp[i].begin() - offsets_ptr[i]);
+
+    for(; begin != end; ++begin, ++s)
+    {
+      if(wrapped_pred(*s))
+      {
+        *t = *begin;
+        ++t;
+      }
+      else
+      {
+        *f = *begin;
+        ++f;
+      }
+    }
+  }
+
+  const difference_type num_true = offsets_ptr[num_intervals];
+
+  return thrust::make_pair(out_true + num_true, out_false + (n - num_true));
 } // end stable_partition_copy()
 
 
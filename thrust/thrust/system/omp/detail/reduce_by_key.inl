@@ -24,8 +24,17 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/omp/detail/reduce_by_key.h>
-#include <thrust/system/detail/generic/reduce_by_key.h>
-#include <thrust/distance.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/functional.h>
+#include <thrust/pair.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/range/tail_flags.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -34,6 +43,119 @@ namespace omp
 {
 namespace detail
 {
+namespace reduce_by_key_detail
+{
+
+
+// reduces the segments of each interval of decomp in parallel
+//
+// every segment which ends inside interval i is written starting at
+// output_offsets[i], except that the partial sum of a segment which began in
+// an earlier interval is stored to heads[i]; the partial sum of a segment
+// which runs past the end of interval i is stored to carries[i], and the index
+// of its first key to carry_starts[i]
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Size,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+void reduce_by_key_intervals(execution_policy<DerivedPolicy> &exec,
+                             InputIterator1 keys_first,
+                             InputIterator2 values_first,
+                             OutputIterator1 keys_output,
+                             OutputIterator2 values_output,
+                             const Size *output_offsets,
+                             ValueType *heads,
+                             ValueType *carries,
+                             Size *carry_starts,
+                             BinaryPredicate binary_pred,
+                             BinaryFunction binary_op,
+                             Decomposition decomp)
+{
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+
+  thrust::detail::wrapped_function<BinaryPredicate,bool>     wrapped_binary_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+  const Size n = decomp[num_intervals - 1].end();
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < num_intervals; i++)
+  {
+    const Size begin = decomp[i].begin();
+    const Size end   = decomp[i].end();
+
+    OutputIterator1 keys_result   = keys_output   + output_offsets[i];
+    OutputIterator2 values_result = values_output + output_offsets[i];
+
+    // does the first segment of this interval begin in an earlier interval?
+    bool is_continuation = (begin > 0) && wrapped_binary_pred(keys_first[begin - 1], keys_first[begin]);
+
+    Size      segment_start = begin;
+    KeyType   key           = keys_first[begin];
+    ValueType sum           = values_first[begin];
+
+    for(Size j = begin + 1; j <= end; ++j)
+    {
+      bool is_tail = true;
+
+      if(j < n)
+      {
+        KeyType next_key = keys_first[j];
+        is_tail = !wrapped_binary_pred(key, next_key);
+        key = next_key;
+      }
+
+      if(!is_tail)
+      {
+        if(j < end)
+        {
+          sum = wrapped_binary_op(sum, values_first[j]);
+        }
+        else
+        {
+          // the final segment carries into the next interval
+          carries[i]      = sum;
+          carry_starts[i] = segment_start;
+        }
+      }
+      else
+      {
+        if(is_continuation)
+        {
+          heads[i] = sum;
+          is_continuation = false;
+        }
+        else
+        {
+          *keys_result   = keys_first[segment_start];
+          *values_result = sum;
+        }
+
+        ++keys_result;
+        ++values_result;
+
+        if(j < end)
+        {
+          segment_start = j;
+          sum = values_first[j];
+        }
+      }
+    }
+  }
+}
+
+
+} // end namespace reduce_by_key_detail
+
 
 template <typename DerivedPolicy,
           typename InputIterator1,
@@ -52,8 +174,100 @@ template <typename DerivedPolicy,
                   BinaryPredicate binary_pred,
                   BinaryFunction binary_op)
 {
-  // omp prefers generic::reduce_by_key to cpp::reduce_by_key
-  return thrust::system::detail::generic::reduce_by_key(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator2>::type ValueType;
+
+  const difference_type n = keys_last - keys_first;
+
+  if(n == 0) return thrust::make_pair(keys_output, values_output);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_intervals = decomp.size();
+
+  // count the number of segments which end in each interval
+  // add one extra element to store the size of the entire result
+  thrust::detail::temporary_array<difference_type, DerivedPolicy> output_offsets(0, exec, num_intervals + 1);
+
+  thrust::detail::tail_flags<InputIterator1,BinaryPredicate> tail_flags = thrust::detail::make_tail_flags(keys_first, keys_last, binary_pred);
+  thrust::system::omp::detail::reduce_intervals(exec, tail_flags.begin(), output_offsets.begin() + 1, thrust::plus<difference_type>(), decomp);
+
+  // scan the counts serially to get each interval's output offset; there is one per thread
+  difference_type *offsets = thrust::raw_pointer_cast(output_offsets.data());
+
+  offsets[0] = 0;
+
+  for(difference_type i = 0; i < num_intervals; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+
+  // reduce each interval in parallel, setting aside the segments which straddle interval boundaries
+  thrust::detail::temporary_array<ValueType, DerivedPolicy>       heads(exec, num_intervals);
+  thrust::detail::temporary_array<ValueType, DerivedPolicy>       carries(exec, num_intervals);
+  thrust::detail::temporary_array<difference_type, DerivedPolicy> carry_starts(0, exec, num_intervals);
+
+  ValueType       *head_values  = thrust::raw_pointer_cast(heads.data());
+  ValueType       *carry_values = thrust::raw_pointer_cast(carries.data());
+  difference_type *carry_firsts = thrust::raw_pointer_cast(carry_starts.data());
+
+  reduce_by_key_detail::reduce_by_key_intervals(exec, keys_first,
+                                                values_first,
+                                                keys_output,
+                                                values_output,
+                                                offsets,
+                                                head_values,
+                                                carry_values,
+                                                carry_firsts,
+                                                binary_pred,
+                                                binary_op,
+                                                decomp);
+
+  // sequentially fold each straddling segment's carries, in order, into its
+  // head in the interval in which the segment ends
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  bool            has_carry   = false;
+  ValueType       carry       = carry_values[0];
+  difference_type carry_start = 0;
+
+  for(difference_type i = 0; i < num_intervals; ++i)
+  {
+    const bool interval_has_carry = !tail_flags[decomp[i].end() - 1];
+
+    if(has_carry && offsets[i] != offsets[i + 1])
+    {
+      // the first segment ending in this interval began in an earlier interval
+      OutputIterator1 key_result   = keys_output   + offsets[i];
+      OutputIterator2 value_result = values_output + offsets[i];
+
+      *key_result   = keys_first[carry_start];
+      *value_result = wrapped_binary_op(carry, head_values[i]);
+
+      has_carry = false;
+    }
+
+    if(interval_has_carry)
+    {
+      if(has_carry)
+      {
+        // the whole interval belongs to a segment which began earlier
+        carry = wrapped_binary_op(carry, carry_values[i]);
+      }
+      else
+      {
+        carry       = carry_values[i];
+        carry_start = carry_firsts[i];
+        has_carry   = true;
+      }
+    }
+  }
+
+  const difference_type size_of_result = offsets[num_intervals];
+
+  return thrust::make_pair(keys_output + size_of_result, values_output + size_of_result);
 } // end reduce_by_key()
 
 
@@ -61,4 +275,3 @@ template <typename DerivedPolicy,
 } // end omp
 } // end system
 THRUST_NAMESPACE_END
-
@@ -27,6 +27,8 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
 #include <thrust/detail/cstdint.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/system/omp/detail/tuning.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -41,7 +43,7 @@ template <typename DerivedPolicy,
           typename OutputIterator,
           typename BinaryFunction,
           typename Decomposition>
-void reduce_intervals(execution_policy<DerivedPolicy> &,
+void reduce_intervals(execution_policy<DerivedPolicy> &exec,
                       InputIterator input,
                       OutputIterator output,
                       BinaryFunction binary_op,
@@ -69,11 +71,18 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 
   index_type n = static_cast<index_type>(decomp.size());
 
-  THRUST_PRAGMA_OMP(parallel for)
+  // reduce raw pointers rather than system references when the input is contiguous
+  typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<InputIterator>  Iterator1;
+  typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<OutputIterator> Iterator2;
+
+  Iterator1 raw_input  = thrust::detail::try_unwrap_contiguous_iterator(input);
+  Iterator2 raw_output = thrust::detail::try_unwrap_contiguous_iterator(output);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
   for(index_type i = 0; i < n; i++)
   {
-    InputIterator begin = input + decomp[i].begin();
-    InputIterator end   = input + decomp[i].end();
+    Iterator1 begin = raw_input + decomp[i].begin();
+    Iterator1 end   = raw_input + decomp[i].end();
 
     if (begin != end)
     {
@@ -87,7 +96,7 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
         ++begin;
       }
 
-      OutputIterator tmp = output + i;
+      Iterator2 tmp = raw_output + i;
       *tmp = sum;
     }
   }
@@ -25,6 +25,15 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/omp/detail/remove.h>
 #include <thrust/system/detail/generic/remove.h>
+#include <thrust/system/omp/detail/compact_intervals.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/remove.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -33,6 +42,64 @@ namespace omp
 {
 namespace detail
 {
+namespace remove_detail
+{
+
+
+// removes in place within every interval of decomp in parallel, then
+// gathers the survivors of all intervals at the front of the range
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename Predicate,
+         typename Decomposition>
+  ForwardIterator remove_if(execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first,
+                            InputIterator stencil,
+                            Predicate pred,
+                            bool has_stencil,
+                            Decomposition decomp)
+{
+  typedef typename Decomposition::index_type index_type;
+
+  const index_type num_intervals = decomp.size();
+
+  thrust::detail::temporary_array<index_type,DerivedPolicy> starts(0, exec, num_intervals);
+  thrust::detail::temporary_array<index_type,DerivedPolicy> offsets(0, exec, num_intervals + 1);
+
+  index_type *starts_ptr  = thrust::raw_pointer_cast(starts.data());
+  index_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < num_intervals; i++)
+  {
+    ForwardIterator begin = first + decomp[i].begin();
+    ForwardIterator end   = first + decomp[i].end();
+
+    end = has_stencil ?
+      thrust::remove_if(thrust::seq, begin, end, stencil + decomp[i].begin(), pred) :
+      thrust::remove_if(thrust::seq, begin, end, pred);
+
+    starts_ptr[i]      = decomp[i].begin();
+    offsets_ptr[i + 1] = end - begin;
+  }
+
+  // scan the counts serially; there is one per thread
+  offsets_ptr[0] = 0;
+
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    offsets_ptr[i + 1] += offsets_ptr[i];
+  }
+
+  thrust::system::omp::detail::compact_intervals(exec, first, starts_ptr, offsets_ptr, decomp);
+
+  return first + offsets_ptr[num_intervals];
+}
+
+
+} // end namespace remove_detail
+
 
 template<typename DerivedPolicy,
          typename ForwardIterator,
@@ -42,8 +109,14 @@ template<typename DerivedPolicy,
                             ForwardIterator last,
                             Predicate pred)
 {
-  // omp prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, pred);
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return first;
+
+  return remove_detail::remove_if(exec, first, first, pred, false, thrust::system::omp::detail::default_decomposition(exec, n));
 }
 
 
@@ -57,8 +130,14 @@ template<typename DerivedPolicy,
                             InputIterator stencil,
                             Predicate pred)
 {
-  // omp prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, stencil, pred);
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return first;
+
+  return remove_detail::remove_if(exec, first, stencil, pred, true, thrust::system::omp::detail::default_decomposition(exec, n));
 }
 
 
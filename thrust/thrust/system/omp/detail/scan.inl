@@ -0,0 +1,230 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_detail
+{
+
+
+// scans each interval of decomp in parallel, seeding interval i > 0 with
+// carries[i - 1]; the first interval is seeded with its own first element
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction,
+         typename Decomposition>
+void inclusive_scan_intervals(execution_policy<DerivedPolicy> &exec,
+                              InputIterator input,
+                              OutputIterator output,
+                              ValueType *carries,
+                              BinaryFunction binary_op,
+                              Decomposition decomp)
+{
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    InputIterator  begin = input  + decomp[i].begin();
+    InputIterator  end   = input  + decomp[i].end();
+    OutputIterator out   = output + decomp[i].begin();
+
+    if (begin != end)
+    {
+      ValueType sum = (i == 0) ? ValueType(*begin) : wrapped_binary_op(carries[i - 1], *begin);
+
+      *out = sum;
+
+      for(++begin, ++out; begin != end; ++begin, ++out)
+      {
+        *out = sum = wrapped_binary_op(sum, *begin);
+      }
+    }
+  }
+}
+
+
+// scans each interval of decomp in parallel, seeding interval i with carries[i]
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction,
+         typename Decomposition>
+void exclusive_scan_intervals(execution_policy<DerivedPolicy> &exec,
+                              InputIterator input,
+                              OutputIterator output,
+                              ValueType *carries,
+                              BinaryFunction binary_op,
+                              Decomposition decomp)
+{
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    InputIterator  begin = input  + decomp[i].begin();
+    InputIterator  end   = input  + decomp[i].end();
+    OutputIterator out   = output + decomp[i].begin();
+
+    ValueType sum = carries[i];
+
+    for(; begin != end; ++begin, ++out)
+    {
+      // temporary value allows in-situ scan
+      ValueType tmp = *begin;
+      *out = sum;
+      sum = wrapped_binary_op(sum, tmp);
+    }
+  }
+}
+
+
+} // end namespace scan_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction binary_op)
+{
+  // Use the input iterator's value type per https://wg21.link/P0571
+  using ValueType = typename thrust::iterator_value<InputIterator>::type;
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if (n != 0)
+  {
+    thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+    // first pass: reduce each interval to a partial sum
+    thrust::detail::temporary_array<ValueType,DerivedPolicy> partial_sums(exec, decomp.size());
+
+    thrust::system::omp::detail::reduce_intervals(exec, first, partial_sums.begin(), binary_op, decomp);
+
+    // scan the partial sums serially; there is one per thread
+    ValueType *carries = thrust::raw_pointer_cast(partial_sums.data());
+
+    thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+    for(difference_type i = 1; i < decomp.size(); ++i)
+    {
+      carries[i] = wrapped_binary_op(carries[i - 1], carries[i]);
+    }
+
+    // second pass: scan each interval seeded by the carry of its predecessors
+    scan_detail::inclusive_scan_intervals(exec, first, result, carries, binary_op, decomp);
+  }
+
+  return result + n;
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                InitialValueType init,
+                                BinaryFunction binary_op)
+{
+  // Use the initial value type per https://wg21.link/P0571
+  using ValueType = InitialValueType;
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if (n != 0)
+  {
+    thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+    // first pass: reduce each interval to a partial sum, leaving room for init
+    thrust::detail::temporary_array<ValueType,DerivedPolicy> partial_sums(exec, decomp.size() + 1);
+
+    thrust::system::omp::detail::reduce_intervals(exec, first, partial_sums.begin() + 1, binary_op, decomp);
+
+    // exclusive scan the partial sums serially; there is one per thread
+    ValueType *carries = thrust::raw_pointer_cast(partial_sums.data());
+
+    thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+    carries[0] = init;
+
+    for(difference_type i = 1; i < decomp.size(); ++i)
+    {
+      carries[i] = wrapped_binary_op(carries[i - 1], carries[i]);
+    }
+
+    // second pass: scan each interval seeded by its carry
+    scan_detail::exclusive_scan_intervals(exec, first, result, carries, binary_op, decomp);
+  }
+
+  return result + n;
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
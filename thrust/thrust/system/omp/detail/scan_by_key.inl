@@ -0,0 +1,427 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+
+// An interval continues the segment of its predecessor unless its first key
+// begins a new one. The first pass reduces every interval to the partial sum
+// of its last segment, and records whether that sum is complete, i.e.
+// whether the last segment begins inside the interval. The complete sum
+// entering each interval then follows from a serial pass over the partial
+// sums, and the second pass scans each interval seeded with it.
+//
+// Exclusive scans are handled as inclusive scans of the values, with init
+// combined into the first value of each segment.
+
+
+template<typename InputIterator1,
+         typename Size,
+         typename BinaryPredicate,
+         typename Decomposition>
+void find_continued_intervals(InputIterator1 keys,
+                              Size *continues,
+                              BinaryPredicate binary_pred,
+                              Decomposition decomp)
+{
+  thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_binary_pred(binary_pred);
+
+  continues[0] = false;
+
+  for(Size i = 1; i < decomp.size(); ++i)
+  {
+    const Size begin = decomp[i].begin();
+
+    continues[i] = wrapped_binary_pred(keys[begin - 1], keys[begin]);
+  }
+}
+
+
+// for an exclusive scan, init is not null, and each segment is seeded with *init
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename Size,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+void reduce_last_segments(execution_policy<DerivedPolicy> &exec,
+                          InputIterator1 keys,
+                          InputIterator2 values,
+                          const Size *continues,
+                          Size *complete,
+                          ValueType *sums,
+                          const ValueType *init,
+                          BinaryPredicate binary_pred,
+                          BinaryFunction binary_op,
+                          Decomposition decomp)
+{
+  thrust::detail::wrapped_function<BinaryPredicate,bool>      wrapped_binary_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    const Size begin = decomp[i].begin();
+    const Size end   = decomp[i].end();
+
+    bool restarted = !continues[i];
+
+    ValueType sum = (restarted && init) ? wrapped_binary_op(*init, values[begin]) : ValueType(values[begin]);
+
+    for(Size j = begin + 1; j < end; ++j)
+    {
+      if(wrapped_binary_pred(keys[j - 1], keys[j]))
+      {
+        sum = wrapped_binary_op(sum, values[j]);
+      }
+      else
+      {
+        sum = init ? wrapped_binary_op(*init, values[j]) : ValueType(values[j]);
+        restarted = true;
+      }
+    }
+
+    sums[i]     = sum;
+    complete[i] = restarted;
+  }
+}
+
+
+// turns the partial sums into the complete sums entering each interval;
+// carries[i] is meaningful only if interval i continues its predecessor
+template<typename Size,
+         typename ValueType,
+         typename BinaryFunction>
+void scan_carries(const Size *complete,
+                  ValueType *carries,
+                  Size num_intervals,
+                  BinaryFunction binary_op)
+{
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // carries[i] holds the partial sum of interval i on entry; shift them so that
+  // interval i + 1 sees the complete sum of everything before it
+  ValueType carry = carries[0];
+
+  for(Size i = 1; i < num_intervals; ++i)
+  {
+    ValueType partial = carries[i];
+
+    carries[i] = carry;
+
+    carry = complete[i] ? partial : wrapped_binary_op(carry, partial);
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Size,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+void inclusive_scan_by_key_intervals(execution_policy<DerivedPolicy> &exec,
+                                     InputIterator1 keys,
+                                     InputIterator2 values,
+                                     OutputIterator output,
+                                     const Size *continues,
+                                     const ValueType *carries,
+                                     BinaryPredicate binary_pred,
+                                     BinaryFunction binary_op,
+                                     Decomposition decomp)
+{
+  using KeyType = typename thrust::iterator_value<InputIterator1>::type;
+
+  thrust::detail::wrapped_function<BinaryPredicate,bool>      wrapped_binary_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    const Size begin = decomp[i].begin();
+    const Size end   = decomp[i].end();
+
+    KeyType   prev_key = keys[begin];
+    ValueType sum      = continues[i] ? wrapped_binary_op(carries[i], values[begin]) : ValueType(values[begin]);
+
+    output[begin] = sum;
+
+    for(Size j = begin + 1; j < end; ++j)
+    {
+      KeyType key = keys[j];
+
+      if(wrapped_binary_pred(prev_key, key))
+      {
+        sum = wrapped_binary_op(sum, values[j]);
+      }
+      else
+      {
+        sum = values[j];
+      }
+
+      output[j] = sum;
+      prev_key  = key;
+    }
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Size,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+void exclusive_scan_by_key_intervals(execution_policy<DerivedPolicy> &exec,
+                                     InputIterator1 keys,
+                                     InputIterator2 values,
+                                     OutputIterator output,
+                                     const Size *continues,
+                                     const ValueType *carries,
+                                     const ValueType &init,
+                                     BinaryPredicate binary_pred,
+                                     BinaryFunction binary_op,
+                                     Decomposition decomp)
+{
+  using KeyType = typename thrust::iterator_value<InputIterator1>::type;
+
+  thrust::detail::wrapped_function<BinaryPredicate,bool>      wrapped_binary_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    const Size begin = decomp[i].begin();
+    const Size end   = decomp[i].end();
+
+    KeyType   prev_key = keys[begin];
+    ValueType sum      = continues[i] ? carries[i] : init;
+
+    for(Size j = begin; j < end; ++j)
+    {
+      KeyType key = keys[j];
+
+      if(j != begin && !wrapped_binary_pred(prev_key, key))
+      {
+        sum = init;
+      }
+
+      // temporary value allows in-situ scan
+      ValueType tmp = values[j];
+      output[j] = sum;
+      sum = wrapped_binary_op(sum, tmp);
+
+      prev_key = key;
+    }
+  }
+}
+
+
+// scans by key over the intervals of decomp
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+void inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator2 first2,
+                           OutputIterator result,
+                           BinaryPredicate binary_pred,
+                           BinaryFunction binary_op,
+                           Decomposition decomp)
+{
+  using ValueType = typename thrust::iterator_value<InputIterator2>::type;
+
+  typedef typename Decomposition::index_type index_type;
+
+  thrust::detail::temporary_array<index_type,DerivedPolicy> flags(exec, 2 * decomp.size());
+  thrust::detail::temporary_array<ValueType,DerivedPolicy>  partial_sums(exec, decomp.size());
+
+  index_type *continues = thrust::raw_pointer_cast(flags.data());
+  index_type *complete  = continues + decomp.size();
+  ValueType  *carries   = thrust::raw_pointer_cast(partial_sums.data());
+
+  // decide which intervals continue the last segment of their predecessor
+  find_continued_intervals(first1, continues, binary_pred, decomp);
+
+  // first pass: reduce the last segment of each interval
+  reduce_last_segments(exec, first1, first2, continues, complete, carries, static_cast<const ValueType *>(0), binary_pred, binary_op, decomp);
+
+  // combine the partial sums serially; there is one per thread
+  scan_carries(complete, carries, decomp.size(), binary_op);
+
+  // second pass: scan each interval seeded by the carry of its predecessors
+  inclusive_scan_by_key_intervals(exec, first1, first2, result, continues, carries, binary_pred, binary_op, decomp);
+}
+
+
+// scans by key over the intervals of decomp
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+void exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator2 first2,
+                           OutputIterator result,
+                           ValueType init,
+                           BinaryPredicate binary_pred,
+                           BinaryFunction binary_op,
+                           Decomposition decomp)
+{
+  typedef typename Decomposition::index_type index_type;
+
+  thrust::detail::temporary_array<index_type,DerivedPolicy> flags(exec, 2 * decomp.size());
+  thrust::detail::temporary_array<ValueType,DerivedPolicy>  partial_sums(exec, decomp.size());
+
+  index_type *continues = thrust::raw_pointer_cast(flags.data());
+  index_type *complete  = continues + decomp.size();
+  ValueType  *carries   = thrust::raw_pointer_cast(partial_sums.data());
+
+  // decide which intervals continue the last segment of their predecessor
+  find_continued_intervals(first1, continues, binary_pred, decomp);
+
+  // first pass: reduce the last segment of each interval, seeding segments with init
+  reduce_last_segments(exec, first1, first2, continues, complete, carries, &init, binary_pred, binary_op, decomp);
+
+  // combine the partial sums serially; there is one per thread
+  scan_carries(complete, carries, decomp.size(), binary_op);
+
+  // second pass: scan each interval seeded by the carry of its predecessors
+  exclusive_scan_by_key_intervals(exec, first1, first2, result, continues, carries, init, binary_pred, binary_op, decomp);
+}
+
+
+} // end namespace scan_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if (n != 0)
+  {
+    scan_by_key_detail::inclusive_scan_by_key(exec, first1, first2, result, binary_pred, binary_op,
+                                              thrust::system::omp::detail::default_decomposition(exec, n));
+  }
+
+  return result + n;
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if (n != 0)
+  {
+    scan_by_key_detail::exclusive_scan_by_key(exec, first1, first2, result, init, binary_pred, binary_op,
+                                              thrust::system::omp::detail::default_decomposition(exec, n));
+  }
+
+  return result + n;
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,298 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/set_operations.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/set_operations.h>
+#include <thrust/binary_search.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/detail/temporary_array.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+
+struct serial_set_difference
+{
+  template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                            InputIterator2 first2, InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct serial_set_intersection
+{
+  template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                            InputIterator2 first2, InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_intersection(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct serial_set_symmetric_difference
+{
+  template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                            InputIterator2 first2, InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_symmetric_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct serial_set_union
+{
+  template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                            InputIterator2 first2, InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_union(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+// splits both ranges near the diag-th element of their merge such that no
+// equivalence class straddles the split, so each side can be processed on its own
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+thrust::pair<Size,Size>
+  balanced_split(RandomAccessIterator1 first1, Size n1,
+                 RandomAccessIterator2 first2, Size n2,
+                 Size diag,
+                 StrictWeakOrdering comp)
+{
+  Size mid1 = thrust::system::omp::detail::merge_detail::merge_path(first1, n1, first2, n2, diag, comp);
+  Size mid2 = diag - mid1;
+
+  // back up both ranges to the first element equivalent to the element
+  // following the split in merge order
+  if(mid1 < n1 && (mid2 == n2 || !comp(first2[mid2], first1[mid1])))
+  {
+    mid1 = thrust::lower_bound(thrust::seq, first1, first1 + mid1, thrust::raw_reference_cast(first1[mid1]), comp) - first1;
+  }
+  else if(mid2 < n2)
+  {
+    mid1 = thrust::lower_bound(thrust::seq, first1, first1 + mid1, thrust::raw_reference_cast(first2[mid2]), comp) - first1;
+    mid2 = thrust::lower_bound(thrust::seq, first2, first2 + mid2, thrust::raw_reference_cast(first2[mid2]), comp) - first2;
+  }
+
+  return thrust::make_pair(mid1, mid2);
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename SetOperation>
+  OutputIterator set_operation(execution_policy<DerivedPolicy> &exec,
+                               InputIterator1 first1,
+                               InputIterator1 last1,
+                               InputIterator2 first2,
+                               InputIterator2 last2,
+                               OutputIterator result,
+                               StrictWeakOrdering comp,
+                               SetOperation set_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  const Size n1 = last1 - first1;
+  const Size n2 = last2 - first2;
+
+  if(n1 + n2 == 0) return result;
+
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp = thrust::system::omp::detail::default_decomposition(exec, n1 + n2);
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // find the split points of each interval; the ends are fixed
+  thrust::detail::temporary_array<Size, DerivedPolicy> splits(0, exec, 2 * (num_intervals + 1));
+
+  Size *splits1 = thrust::raw_pointer_cast(splits.data());
+  Size *splits2 = splits1 + (num_intervals + 1);
+
+  splits1[0] = 0;
+  splits2[0] = 0;
+  splits1[num_intervals] = n1;
+  splits2[num_intervals] = n2;
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 1; i < num_intervals; i++)
+  {
+    thrust::pair<Size,Size> split = balanced_split(first1, n1, first2, n2, decomp[i].begin(), wrapped_comp);
+
+    splits1[i] = split.first;
+    splits2[i] = split.second;
+  }
+
+  // count the size of each interval's output
+  thrust::detail::temporary_array<Size, DerivedPolicy> output_offsets(0, exec, num_intervals + 1);
+
+  Size *offsets = thrust::raw_pointer_cast(output_offsets.data());
+
+  offsets[0] = 0;
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < num_intervals; i++)
+  {
+    thrust::discard_iterator<> counter;
+
+    offsets[i + 1] = set_op(first1 + splits1[i], first1 + splits1[i + 1],
+                            first2 + splits2[i], first2 + splits2[i + 1],
+                            counter,
+                            comp) - counter;
+  }
+
+  // scan the counts serially to get each interval's output offset; there is one per thread
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+
+  // write each interval's output
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < num_intervals; i++)
+  {
+    set_op(first1 + splits1[i], first1 + splits1[i + 1],
+           first2 + splits2[i], first2 + splits2[i + 1],
+           result + offsets[i],
+           comp);
+  }
+
+  return result + offsets[num_intervals];
+}
+
+
+} // end namespace set_operations_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_difference(execution_policy<DerivedPolicy> &exec,
+                                InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, set_operations_detail::serial_set_difference());
+} // end set_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_intersection(execution_policy<DerivedPolicy> &exec,
+                                  InputIterator1 first1,
+                                  InputIterator1 last1,
+                                  InputIterator2 first2,
+                                  InputIterator2 last2,
+                                  OutputIterator result,
+                                  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, set_operations_detail::serial_set_intersection());
+} // end set_intersection()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_symmetric_difference(execution_policy<DerivedPolicy> &exec,
+                                          InputIterator1 first1,
+                                          InputIterator1 last1,
+                                          InputIterator2 first2,
+                                          InputIterator2 last2,
+                                          OutputIterator result,
+                                          StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, set_operations_detail::serial_set_symmetric_difference());
+} // end set_symmetric_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_union(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           InputIterator2 last2,
+                           OutputIterator result,
+                           StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, set_operations_detail::serial_set_union());
+} // end set_union()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
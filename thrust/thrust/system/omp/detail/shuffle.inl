@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/shuffle.h>
+#include <thrust/shuffle.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/system/detail/generic/shuffle.h>
+#include <thrust/distance.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace shuffle_detail
+{
+
+
+// counts the indices of each interval but the last which the bijection maps into [0, m); the
+// count of the last interval isn't needed to know where the intervals write
+template <typename DerivedPolicy, typename Decomposition>
+void count_keys_intervals(execution_policy<DerivedPolicy> &exec,
+                          const thrust::system::detail::generic::feistel_bijection &bijection,
+                          std::uint64_t m,
+                          std::uint64_t *counts,
+                          Decomposition decomp)
+{
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size()) - 1;
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    std::uint64_t count = 0;
+
+    for(std::uint64_t idx = decomp[i].begin(); idx != decomp[i].end(); ++idx)
+    {
+      count += bijection(idx) < m;
+    }
+
+    counts[i] = count;
+  }
+}
+
+
+// each interval gathers the elements its indices are mapped to, and writes them at its offset
+template <typename DerivedPolicy,
+          typename RandomIterator,
+          typename OutputIterator,
+          typename Decomposition>
+void gather_keys_intervals(execution_policy<DerivedPolicy> &exec,
+                           RandomIterator first,
+                           OutputIterator result,
+                           const thrust::system::detail::generic::feistel_bijection &bijection,
+                           std::uint64_t m,
+                           const std::uint64_t *offsets,
+                           Decomposition decomp)
+{
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(index_type i = 0; i < n; i++)
+  {
+    OutputIterator out = result + offsets[i];
+
+    for(std::uint64_t idx = decomp[i].begin(); idx != decomp[i].end(); ++idx)
+    {
+      std::uint64_t key = bijection(idx);
+
+      if(key < m)
+      {
+        *out = first[key];
+        ++out;
+      }
+    }
+  }
+}
+
+
+} // end shuffle_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename OutputIterator,
+         typename URBG>
+  void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                    RandomIterator first,
+                    RandomIterator last,
+                    OutputIterator result,
+                    URBG &&g)
+{
+  // the same permutation as the generic implementation: the bijection permutes [0, n), where n is
+  // the power of two above m, and the indices it maps into [0, m) are kept in order. Every index
+  // is mapped independently, so only the positions where the intervals write need a scan.
+  std::uint64_t m = thrust::distance(first, last);
+  thrust::system::detail::generic::feistel_bijection bijection(m, g);
+  std::uint64_t n = bijection.nearest_power_of_two();
+
+  thrust::system::detail::internal::uniform_decomposition<std::uint64_t> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  // count the kept indices of each interval
+  thrust::detail::temporary_array<std::uint64_t,DerivedPolicy> offsets(0, exec, decomp.size());
+
+  std::uint64_t *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  shuffle_detail::count_keys_intervals(exec, bijection, m, offsets_ptr + 1, decomp);
+
+  // scan the counts serially; there is one per thread
+  offsets_ptr[0] = 0;
+
+  for(std::uint64_t i = 1; i < decomp.size(); ++i)
+  {
+    offsets_ptr[i] += offsets_ptr[i - 1];
+  }
+
+  // each interval recomputes its keys, and gathers its elements at its offset
+  shuffle_detail::gather_keys_intervals(exec, first, result, bijection, m, offsets_ptr, decomp);
+} // end shuffle_copy()
+
+
+} // end detail
+} // end omp
+} // end system
+THRUST_NAMESPACE_END
+
@@ -24,17 +24,17 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 
-// don't attempt to #include this file without omp support
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#include <omp.h>
-#endif // omp support
-
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/system/detail/internal/radix_sort.h>
 #include <thrust/system/detail/generic/select_system.h>
 #include <thrust/sort.h>
-#include <thrust/merge.h>
+#include <thrust/binary_search.h>
 #include <thrust/detail/seq.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/raw_reference_cast.h>
 #include <thrust/detail/temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -48,21 +48,440 @@ namespace sort_detail
 {
 
 
+// below this size the sequential radix sort of a single thread wins
+const static int radix_sort_threshold = 1 << 16;
+
+
+using thrust::system::detail::internal::radix_sort_detail::use_radix_sort;
+
+
+struct tile_loop
+{
+  int team_size;
+
+  explicit tile_loop(int team_size)
+    : team_size(team_size)
+  {}
+
+  template<typename Size, typename Body>
+  void operator()(Size num_tiles, Body body) const
+  {
+    THRUST_PRAGMA_OMP(parallel for num_threads(team_size))
+    for(Size i = 0; i < num_tiles; i++)
+    {
+      body(i);
+    }
+  }
+};
+
+
+// returns the position of the element first[decomp[run].begin() + pos] in the
+// stable merge of every sorted interval of decomp, where equivalent elements
+// of earlier intervals come first
+template<typename RandomAccessIterator,
+         typename Decomposition,
+         typename Size,
+         typename StrictWeakOrdering>
+Size merge_rank(RandomAccessIterator first,
+                const Decomposition &decomp,
+                Size run,
+                Size pos,
+                StrictWeakOrdering comp)
+{
+  const Size num_runs = decomp.size();
+
+  RandomAccessIterator value = first + (decomp[run].begin() + pos);
+
+  Size rank = pos;
+
+  for(Size k = 0; k < num_runs; ++k)
+  {
+    RandomAccessIterator run_first = first + decomp[k].begin();
+    RandomAccessIterator run_last  = first + decomp[k].end();
+
+    if(k < run)
+    {
+      rank += thrust::upper_bound(thrust::seq, run_first, run_last, thrust::raw_reference_cast(*value), comp) - run_first;
+    }
+    else if(k > run)
+    {
+      rank += thrust::lower_bound(thrust::seq, run_first, run_last, thrust::raw_reference_cast(*value), comp) - run_first;
+    }
+  }
+
+  return rank;
+}
+
+
+// for each sorted interval k of decomp, finds the number of its elements,
+// splits[k], which are among the first diag elements of their stable merge
+template<typename RandomAccessIterator,
+         typename Decomposition,
+         typename Size,
+         typename StrictWeakOrdering>
+void multiway_merge_path(RandomAccessIterator first,
+                         const Decomposition &decomp,
+                         Size diag,
+                         Size *splits,
+                         StrictWeakOrdering comp)
+{
+  const Size num_runs = decomp.size();
+
+  for(Size k = 0; k < num_runs; ++k)
+  {
+    // the rank of each element increases along its run
+    Size lo = 0;
+    Size hi = decomp[k].size();
+
+    while(lo < hi)
+    {
+      Size mid = lo + (hi - lo) / 2;
+
+      if(merge_rank(first, decomp, k, mid, comp) < diag)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+
+    splits[k] = lo;
+  }
+}
+
+
+template<typename RandomAccessIterator,
+         typename Size,
+         typename StrictWeakOrdering>
+struct run_head_compare
+{
+  RandomAccessIterator first;
+  const Size *cursors;
+  StrictWeakOrdering comp;
+
+  run_head_compare(RandomAccessIterator first, const Size *cursors, StrictWeakOrdering comp)
+    : first(first), cursors(cursors), comp(comp)
+  {}
+
+  // does the head of run a precede the head of run b?
+  bool operator()(Size a, Size b)
+  {
+    if(comp(first[cursors[b]], first[cursors[a]]))
+    {
+      return false;
+    }
+
+    return comp(first[cursors[a]], first[cursors[b]]) || a < b;
+  }
+};
+
+
+template<typename Size, typename Compare>
+void sift_down(Size *heap, Size size, Compare &precedes)
+{
+  Size parent = 0;
+
+  while(true)
+  {
+    Size child = 2 * parent + 1;
+
+    if(child >= size) break;
+
+    if(child + 1 < size && precedes(heap[child + 1], heap[child]))
+    {
+      ++child;
+    }
+
+    if(!precedes(heap[child], heap[parent])) break;
+
+    Size tmp = heap[parent];
+    heap[parent] = heap[child];
+    heap[child] = tmp;
+
+    parent = child;
+  }
+}
+
+
+// merges the sorted runs [first + run_firsts[k], first + run_lasts[k]) in
+// order through a binary heap of run heads, handing each (source, destination)
+// index pair to mover
+template<typename RandomAccessIterator,
+         typename Size,
+         typename StrictWeakOrdering,
+         typename MoveFunction>
+void multiway_merge(RandomAccessIterator first,
+                    Size num_runs,
+                    Size *run_firsts,
+                    const Size *run_lasts,
+                    Size *heap,
+                    Size result,
+                    StrictWeakOrdering comp,
+                    MoveFunction mover)
+{
+  run_head_compare<RandomAccessIterator,Size,StrictWeakOrdering> precedes(first, run_firsts, comp);
+
+  Size size = 0;
+
+  // insert each nonempty run, sifting it up
+  for(Size k = 0; k < num_runs; ++k)
+  {
+    if(run_firsts[k] == run_lasts[k]) continue;
+
+    Size child = size++;
+    heap[child] = k;
+
+    while(child > 0)
+    {
+      Size parent = (child - 1) / 2;
+
+      if(!precedes(heap[child], heap[parent])) break;
+
+      Size tmp = heap[parent];
+      heap[parent] = heap[child];
+      heap[child] = tmp;
+
+      child = parent;
+    }
+  }
+
+  while(size > 0)
+  {
+    Size k = heap[0];
+
+    mover(run_firsts[k], result);
+
+    ++result;
+    ++run_firsts[k];
+
+    if(run_firsts[k] == run_lasts[k])
+    {
+      heap[0] = heap[--size];
+    }
+
+    sift_down(heap, size, precedes);
+  }
+}
+
+
+template<typename InputIterator, typename OutputIterator>
+struct move_key
+{
+  InputIterator  input;
+  OutputIterator output;
+
+  move_key(InputIterator input, OutputIterator output)
+    : input(input), output(output)
+  {}
+
+  template<typename Size>
+  void operator()(Size src, Size dst)
+  {
+    output[dst] = input[src];
+  }
+};
+
+
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator1, typename OutputIterator2>
+struct move_key_value
+{
+  InputIterator1  keys_input;
+  InputIterator2  values_input;
+  OutputIterator1 keys_output;
+  OutputIterator2 values_output;
+
+  move_key_value(InputIterator1 keys_input, InputIterator2 values_input, OutputIterator1 keys_output, OutputIterator2 values_output)
+    : keys_input(keys_input), values_input(values_input), keys_output(keys_output), values_output(values_output)
+  {}
+
+  template<typename Size>
+  void operator()(Size src, Size dst)
+  {
+    keys_output[dst]   = keys_input[src];
+    values_output[dst] = values_input[src];
+  }
+};
+
+
+// merges the sorted intervals of decomp held in keys into P disjoint
+// intervals of the output, one per thread, in a single pass
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Decomposition,
+         typename StrictWeakOrdering,
+         typename MoveFunction>
+void multiway_merge_intervals(execution_policy<DerivedPolicy> &exec,
+                              RandomAccessIterator keys,
+                              const Decomposition &decomp,
+                              StrictWeakOrdering comp,
+                              MoveFunction mover)
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  const IndexType num_runs = decomp.size();
+
+  // row i holds the split of each run at the start of output interval i
+  thrust::detail::temporary_array<IndexType,DerivedPolicy> splits(0, exec, (num_runs + 1) * num_runs);
+
+  IndexType *split_table = thrust::raw_pointer_cast(splits.data());
+
+  for(IndexType k = 0; k < num_runs; ++k)
+  {
+    split_table[k] = 0;
+    split_table[num_runs * num_runs + k] = decomp[k].size();
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(IndexType i = 1; i < num_runs; i++)
+  {
+    multiway_merge_path(keys, decomp, decomp[i].begin(), split_table + i * num_runs, wrapped_comp);
+  }
+
+  // every thread needs a cursor, an end and a heap slot per run
+  thrust::detail::temporary_array<IndexType,DerivedPolicy> scratch(0, exec, 3 * num_runs * num_runs);
+
+  IndexType *scratch_ptr = thrust::raw_pointer_cast(scratch.data());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(IndexType i = 0; i < num_runs; i++)
+  {
+    IndexType *run_firsts = scratch_ptr + 3 * i * num_runs;
+    IndexType *run_lasts  = run_firsts + num_runs;
+    IndexType *heap       = run_lasts  + num_runs;
+
+    // convert run-relative splits into absolute positions
+    for(IndexType k = 0; k < num_runs; ++k)
+    {
+      run_firsts[k] = decomp[k].begin() + split_table[i * num_runs + k];
+      run_lasts[k]  = decomp[k].begin() + split_table[(i + 1) * num_runs + k];
+    }
+
+    multiway_merge(keys, num_runs, run_firsts, run_lasts, heap, decomp[i].begin(), wrapped_comp, mover);
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      KeyType;
+
+  if(first == last)
+    return;
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::omp::detail::default_decomposition(exec, static_cast<IndexType>(last - first));
+
+  const IndexType num_intervals = decomp.size();
+
+  // every thread sorts its own tile
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(IndexType i = 0; i < num_intervals; i++)
+  {
+    thrust::stable_sort(thrust::seq,
+                        first + decomp[i].begin(),
+                        first + decomp[i].end(),
+                        comp);
+  }
+
+  if(num_intervals == 1)
+    return;
+
+  // merge all tiles at once from a copy back into place
+  thrust::detail::temporary_array<KeyType,DerivedPolicy> keys(exec, first, last);
+
+  KeyType *keys_ptr = thrust::raw_pointer_cast(keys.data());
+
+  sort_detail::multiway_merge_intervals(exec,
+                                        keys_ptr,
+                                        decomp,
+                                        comp,
+                                        sort_detail::move_key<KeyType*,RandomAccessIterator>(keys_ptr, first));
+}
+
+
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename StrictWeakOrdering>
-void inplace_merge(execution_policy<DerivedPolicy> &exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+
+  const IndexType n         = last - first;
+  const IndexType num_tiles = default_decomposition(exec, static_cast<IndexType>(n)).size();
+
+  if(n < radix_sort_threshold || num_tiles == 1)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<false>(tile_loop(tuning_of(exec).team_size()), exec, first, static_cast<int*>(0), n, num_tiles, comp);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+
+  if(keys_first == keys_last)
+    return;
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::omp::detail::default_decomposition(exec, static_cast<IndexType>(keys_last - keys_first));
 
-  thrust::detail::temporary_array<value_type,DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type,DerivedPolicy> b(exec, middle, last);
+  const IndexType num_intervals = decomp.size();
 
-  thrust::merge(thrust::seq, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+  // every thread sorts its own tile
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(IndexType i = 0; i < num_intervals; i++)
+  {
+    thrust::stable_sort_by_key(thrust::seq,
+                               keys_first + decomp[i].begin(),
+                               keys_first + decomp[i].end(),
+                               values_first + decomp[i].begin(),
+                               comp);
+  }
+
+  if(num_intervals == 1)
+    return;
+
+  // merge all tiles at once from a copy back into place
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   keys(exec, keys_first, keys_last);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> values(exec, values_first, values_first + (keys_last - keys_first));
+
+  KeyType   *keys_ptr   = thrust::raw_pointer_cast(keys.data());
+  ValueType *values_ptr = thrust::raw_pointer_cast(values.data());
+
+  sort_detail::multiway_merge_intervals(exec,
+                                        keys_ptr,
+                                        decomp,
+                                        comp,
+                                        sort_detail::move_key_value<KeyType*,ValueType*,RandomAccessIterator1,RandomAccessIterator2>(keys_ptr, values_ptr, keys_first, values_first));
 }
 
 
@@ -70,30 +489,25 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator1,
          typename RandomAccessIterator2,
          typename StrictWeakOrdering>
-void inplace_merge_by_key(execution_policy<DerivedPolicy> &exec,
-                          RandomAccessIterator1 first1,
-                          RandomAccessIterator1 middle1,
-                          RandomAccessIterator1 last1,
-                          RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::true_type)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
-
-  RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1   - first1);
-
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> rhs2(exec, middle2, last2);
-
-  thrust::merge_by_key(thrust::seq,
-                       lhs1.begin(), lhs1.end(),
-                       rhs1.begin(), rhs1.end(),
-                       lhs2.begin(), rhs2.begin(),
-                       first1, first2,
-                       comp);
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+
+  const IndexType n         = keys_last - keys_first;
+  const IndexType num_tiles = default_decomposition(exec, static_cast<IndexType>(n)).size();
+
+  if(n < radix_sort_threshold || num_tiles == 1)
+  {
+    thrust::stable_sort_by_key(thrust::seq, keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<true>(tile_loop(tuning_of(exec).team_size()), exec, keys_first, values_first, n, num_tiles, comp);
 }
 
 
@@ -120,64 +534,9 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
   , "OpenMP compiler support is not enabled"
   );
 
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
-
-  if(first == last)
-    return;
-
-  THRUST_PRAGMA_OMP(parallel)
-  {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
-
-    // process id
-    IndexType p_i = omp_get_thread_num();
-
-    // every thread sorts its own tile
-    if(p_i < decomp.size())
-    {
-      thrust::stable_sort(thrust::seq,
-                          first + decomp[p_i].begin(),
-                          first + decomp[p_i].end(),
-                          comp);
-    }
-
-    THRUST_PRAGMA_OMP(barrier)
-
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
-
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
 
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
-
-    while(nseg>1)
-    {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge(exec,
-                                   first + decomp[a].begin(),
-                                   first + decomp[b].end(),
-                                   first + decomp[c].end(),
-                                   comp);
-
-        b = c;
-        c += h;
-      }
-
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
-      THRUST_PRAGMA_OMP(barrier)
-    }
-  }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  sort_detail::stable_sort(exec, first, last, comp, sort_detail::use_radix_sort<KeyType,StrictWeakOrdering>());
 }
 
 
@@ -203,66 +562,9 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
   , "OpenMP compiler support is not enabled"
   );
 
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
-
-  if(keys_first == keys_last)
-    return;
-
-  THRUST_PRAGMA_OMP(parallel)
-  {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(keys_last - keys_first, 1, omp_get_num_threads());
-
-    // process id
-    IndexType p_i = omp_get_thread_num();
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
 
-    // every thread sorts its own tile
-    if(p_i < decomp.size())
-    {
-      thrust::stable_sort_by_key(thrust::seq,
-                                 keys_first + decomp[p_i].begin(),
-                                 keys_first + decomp[p_i].end(),
-                                 values_first + decomp[p_i].begin(),
-                                 comp);
-    }
-
-    THRUST_PRAGMA_OMP(barrier)
-
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
-
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
-
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
-
-    while(nseg>1)
-    {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge_by_key(exec,
-                                          keys_first + decomp[a].begin(),
-                                          keys_first + decomp[b].end(),
-                                          keys_first + decomp[c].end(),
-                                          values_first + decomp[a].begin(),
-                                          comp);
-
-        b = c;
-        c += h;
-      }
-
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
-      THRUST_PRAGMA_OMP(barrier)
-    }
-  }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, sort_detail::use_radix_sort<KeyType,StrictWeakOrdering>());
 }
 
 
@@ -0,0 +1,262 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file tuning.h
+ *  \brief Thread count and loop schedule selection for the OpenMP backend.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+
+#include <cstddef>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// the number of threads in each parallel region of an algorithm
+struct num_threads
+{
+  explicit num_threads(int count)
+    : count(count)
+  {}
+
+  int count;
+};
+
+
+enum schedule_kind
+{
+  schedule_static,
+  schedule_dynamic,
+  schedule_guided
+};
+
+
+// how the iterations of element-wise loops are handed to threads; a zero
+// chunk size selects OpenMP's default for the kind
+struct schedule
+{
+  explicit schedule(schedule_kind kind, std::size_t chunk_size = 0)
+    : kind(kind), chunk_size(chunk_size)
+  {}
+
+  schedule_kind kind;
+  std::size_t   chunk_size;
+};
+
+
+struct tuning
+{
+  // zero selects the OpenMP defaults
+  int           thread_count;
+  schedule_kind kind;
+  std::size_t   chunk_size;
+
+  tuning()
+    : thread_count(0), kind(schedule_static), chunk_size(0)
+  {}
+
+  void set(const num_threads &n) { thread_count = n.count; }
+
+  void set(const schedule &s)
+  {
+    kind       = s.kind;
+    chunk_size = s.chunk_size;
+  }
+
+  // the team size of a parallel region
+  int team_size() const
+  {
+    if(thread_count > 0)
+    {
+      return thread_count;
+    }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  // the number of intervals a range is decomposed into
+  int num_intervals() const
+  {
+    if(thread_count > 0)
+    {
+      return thread_count;
+    }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    return omp_get_num_procs();
+#else
+    return 1;
+#endif
+  }
+};
+
+
+template<typename Derived>
+struct execute_with_tuning_base : execution_policy<Derived>
+{
+private:
+  tuning m_tuning;
+
+public:
+  execute_with_tuning_base() {}
+
+  // accepts any mix of num_threads and schedule; later arguments override
+  // earlier ones
+  template<typename... Args>
+  Derived with(Args&&... args) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+
+    int expand[] = {0, (result.m_tuning.set(args), 0)...};
+    (void) expand;
+
+    return result;
+  }
+
+private:
+  friend tuning get_tuning(const execute_with_tuning_base &exec)
+  {
+    return exec.m_tuning;
+  }
+};
+
+
+struct execute_with_tuning : execute_with_tuning_base<execute_with_tuning>
+{};
+
+
+template<typename Derived>
+tuning get_tuning(execution_policy<Derived> &)
+{
+  return tuning();
+}
+
+
+// entry point for algorithms
+template<typename Derived>
+tuning tuning_of(execution_policy<Derived> &exec)
+{
+  return get_tuning(thrust::detail::derived_cast(exec));
+}
+
+
+// runs body(i) for every i in [0, n) with the tuning's team size and schedule
+template<typename Size, typename Body>
+void tuned_parallel_for(const tuning &t, Size n, Body body)
+{
+  const int team_size = t.team_size();
+
+  // OpenMP requires a positive chunk size for every kind but static
+  const Size chunk = t.chunk_size ? static_cast<Size>(t.chunk_size) : Size(1);
+
+  // each thread gets its own copy of body; when it is shared, the compiler
+  // reloads its members after every store through them
+  switch(t.kind)
+  {
+    case schedule_dynamic:
+      THRUST_PRAGMA_OMP(parallel for num_threads(team_size) schedule(dynamic, chunk) firstprivate(body))
+      for(Size i = 0; i < n; ++i)
+      {
+        body(i);
+      }
+      break;
+    case schedule_guided:
+      THRUST_PRAGMA_OMP(parallel for num_threads(team_size) schedule(guided, chunk) firstprivate(body))
+      for(Size i = 0; i < n; ++i)
+      {
+        body(i);
+      }
+      break;
+    default:
+      if(t.chunk_size)
+      {
+        THRUST_PRAGMA_OMP(parallel for num_threads(team_size) schedule(static, chunk) firstprivate(body))
+        for(Size i = 0; i < n; ++i)
+        {
+          body(i);
+        }
+      }
+      else
+      {
+        THRUST_PRAGMA_OMP(parallel for num_threads(team_size) firstprivate(body))
+        for(Size i = 0; i < n; ++i)
+        {
+          body(i);
+        }
+      }
+      break;
+  }
+
+  (void) team_size;
+  (void) chunk;
+}
+
+
+} // end detail
+
+
+using thrust::system::omp::detail::num_threads;
+using thrust::system::omp::detail::schedule_kind;
+using thrust::system::omp::detail::schedule_static;
+using thrust::system::omp::detail::schedule_dynamic;
+using thrust::system::omp::detail::schedule_guided;
+using thrust::system::omp::detail::schedule;
+
+
+} // end omp
+} // end system
+
+
+namespace omp
+{
+
+
+using thrust::system::omp::num_threads;
+using thrust::system::omp::schedule_kind;
+using thrust::system::omp::schedule_static;
+using thrust::system::omp::schedule_dynamic;
+using thrust::system::omp::schedule_guided;
+using thrust::system::omp::schedule;
+
+
+} // end omp
+THRUST_NAMESPACE_END
+
@@ -25,7 +25,17 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/omp/detail/unique_by_key.h>
 #include <thrust/system/detail/generic/unique_by_key.h>
+#include <thrust/system/omp/detail/compact_intervals.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/unique.h>
+#include <thrust/distance.h>
 #include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -47,8 +57,62 @@ template<typename DerivedPolicy,
                   ForwardIterator2 values_first,
                   BinaryPredicate binary_pred)
 {
-  // omp prefers generic::unique_by_key to cpp::unique_by_key
-  return thrust::system::detail::generic::unique_by_key(exec,keys_first,keys_last,values_first,binary_pred);
+  typedef typename thrust::iterator_difference<ForwardIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(keys_first, keys_last);
+
+  if(n == 0)
+    return thrust::make_pair(keys_first, values_first);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_intervals = decomp.size();
+
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> starts(0, exec, num_intervals);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_intervals + 1);
+
+  difference_type *starts_ptr  = thrust::raw_pointer_cast(starts.data());
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  // decide whether each interval begins a new group before any interval
+  // overwrites the key its successor compares against
+  thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_binary_pred(binary_pred);
+
+  starts_ptr[0] = 0;
+
+  for(difference_type i = 1; i < num_intervals; ++i)
+  {
+    const difference_type begin = decomp[i].begin();
+
+    starts_ptr[i] = wrapped_binary_pred(keys_first[begin - 1], keys_first[begin]) ? begin + 1 : begin;
+  }
+
+  // unique each interval in place
+  THRUST_PRAGMA_OMP(parallel for num_threads(tuning_of(exec).team_size()))
+  for(difference_type i = 0; i < num_intervals; i++)
+  {
+    ForwardIterator1 keys_begin = keys_first + decomp[i].begin();
+    ForwardIterator1 keys_end   = thrust::unique_by_key(thrust::seq,
+                                                        keys_begin,
+                                                        keys_first + decomp[i].end(),
+                                                        values_first + decomp[i].begin(),
+                                                        binary_pred).first;
+
+    offsets_ptr[i + 1] = (keys_end - keys_first) - starts_ptr[i];
+  }
+
+  // scan the counts serially; there is one per thread
+  offsets_ptr[0] = 0;
+
+  for(difference_type i = 0; i < num_intervals; ++i)
+  {
+    offsets_ptr[i + 1] += offsets_ptr[i];
+  }
+
+  thrust::system::omp::detail::compact_intervals(exec, keys_first, starts_ptr, offsets_ptr, decomp);
+  thrust::system::omp::detail::compact_intervals(exec, values_first, starts_ptr, offsets_ptr, decomp);
+
+  return thrust::make_pair(keys_first + offsets_ptr[num_intervals], values_first + offsets_ptr[num_intervals]);
 } // end unique_by_key()
 
 
@@ -67,6 +67,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/system/omp/detail/scatter.h>
 #include <thrust/system/omp/detail/sequence.h>
 #include <thrust/system/omp/detail/set_operations.h>
+#include <thrust/system/omp/detail/shuffle.h>
 #include <thrust/system/omp/detail/sort.h>
 #include <thrust/system/omp/detail/swap_ranges.h>
 #include <thrust/system/omp/detail/tabulate.h>
@@ -145,10 +146,52 @@ struct tag : thrust::system::omp::execution_policy<tag> { unspecified };
  *
  *  // 0 1 2 is printed to standard output in some unspecified order
  *  \endcode
+ *
+ *  \p par.with() returns a copy of the policy which carries tuning for the parallel regions of
+ *  every algorithm it is passed to. It accepts a \p thrust::omp::num_threads, the team size of
+ *  every parallel region and the number of intervals ranges are divided into, and a
+ *  \p thrust::omp::schedule for loops which visit individual elements, such as those of
+ *  \p for_each and \p transform. Later arguments override earlier ones, and the result also
+ *  supports \p with(). Without tuning, algorithms use OpenMP's defaults.
+ *
+ *  \code
+ *  thrust::for_each(thrust::omp::par.with(thrust::omp::num_threads(8),
+ *                                         thrust::omp::schedule(thrust::omp::schedule_dynamic, 1024)),
+ *                   vec.begin(), vec.end(), printf_functor());
+ *  \endcode
  */
 static const unspecified par;
 
 
+/*! \p thrust::omp::num_threads requests that the parallel regions of an algorithm use a team of
+ *  \p count threads. Pass it to \p thrust::omp::par.with().
+ */
+struct num_threads
+{
+  explicit num_threads(int count);
+};
+
+
+/*! \p thrust::omp::schedule_kind names the OpenMP loop schedules.
+ */
+enum schedule_kind
+{
+  schedule_static,
+  schedule_dynamic,
+  schedule_guided
+};
+
+
+/*! \p thrust::omp::schedule requests an OpenMP loop schedule and chunk size for the loops of an
+ *  algorithm which visit individual elements. A \p chunk_size of zero selects OpenMP's default
+ *  for \p kind. Pass it to \p thrust::omp::par.with().
+ */
+struct schedule
+{
+  explicit schedule(schedule_kind kind, std::size_t chunk_size = 0);
+};
+
+
 /*! \}
  */
 
@@ -88,6 +88,16 @@ using universal_allocator = thrust::mr::stateless_resource_allocator<
   T, thrust::system::omp::universal_memory_resource
 >;
 
+/*! \p omp::first_touch_allocator allocates storage with
+ *  \p omp::first_touch_memory_resource, which places large allocations on
+ *  the NUMA nodes of the threads of the \p omp system that will work on
+ *  them.
+ */
+template<typename T>
+using first_touch_allocator = thrust::mr::stateless_resource_allocator<
+  T, thrust::system::omp::first_touch_memory_resource
+>;
+
 }} // namespace system::omp
 
 /*! \namespace thrust::omp
@@ -99,6 +109,7 @@ using thrust::system::omp::malloc;
 using thrust::system::omp::free;
 using thrust::system::omp::allocator;
 using thrust::system::omp::universal_allocator;
+using thrust::system::omp::first_touch_allocator;
 } // namespace omp
 
 THRUST_NAMESPACE_END
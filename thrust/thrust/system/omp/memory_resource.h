@@ -31,6 +31,8 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/mr/fancy_pointer_resource.h>
 
 #include <thrust/system/omp/pointer.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/first_touch_resource.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system { namespace omp
@@ -48,6 +50,28 @@ namespace detail
         thrust::mr::new_delete_resource,
         thrust::omp::universal_pointer<void>
     > universal_native_resource;
+
+    // the pages are split between the threads like the elements of a range by the algorithms of
+    // the OpenMP system, with a static schedule
+    struct page_toucher
+    {
+        static void touch(char * p, std::size_t pages, std::size_t page_size)
+        {
+            // use a signed type for the iteration variable or suffer the consequences of warnings
+            std::ptrdiff_t signed_pages = pages;
+
+            THRUST_PRAGMA_OMP(parallel for schedule(static))
+            for (std::ptrdiff_t i = 0; i < signed_pages; ++i)
+            {
+                p[i * page_size] = 0;
+            }
+        }
+    };
+
+    typedef thrust::mr::fancy_pointer_resource<
+        thrust::system::detail::internal::first_touch_resource<page_toucher>,
+        thrust::omp::pointer<void>
+    > first_touch_native_resource;
 } // namespace detail
 //! \endcond
 
@@ -66,6 +90,15 @@ typedef detail::native_resource memory_resource;
 typedef detail::universal_native_resource universal_memory_resource;
 /*! An alias for \p omp::universal_memory_resource. */
 typedef detail::native_resource universal_host_pinned_memory_resource;
+/*! A memory resource for the OpenMP system that places the memory of large
+ *  allocations on the NUMA nodes of the threads that will work on it. Every
+ *  page of an allocation of at least 256 KiB is written to by the threads of
+ *  the OpenMP system as soon as it is allocated, each thread writing to the
+ *  pages that hold the elements it processes in a parallel algorithm, and the
+ *  operating system places a page on the node of the thread that first writes
+ *  to it. Uses \p mr::new_delete_resource and tags it with \p omp::pointer.
+ */
+typedef detail::first_touch_native_resource first_touch_memory_resource;
 
 /*! \}
  */
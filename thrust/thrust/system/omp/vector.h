@@ -77,12 +77,30 @@ using vector = thrust::detail::vector_base<T, Allocator>;
 template <typename T, typename Allocator = thrust::system::omp::universal_allocator<T>>
 using universal_vector = thrust::detail::vector_base<T, Allocator>;
 
+/*! \p omp::first_touch_vector is a \p omp::vector whose elements are
+ *  placed on the NUMA nodes of the threads of the \p omp system that
+ *  process them in parallel algorithms, rather than all on the node of the
+ *  thread that allocated the vector. Large vectors benefit from it on systems
+ *  with several NUMA nodes, when they are initialized and later processed by
+ *  parallel algorithms of the \p omp system.
+ *
+ *  \tparam T The element type of the \p omp::first_touch_vector.
+ *  \tparam Allocator The allocator type of the \p omp::first_touch_vector.
+ *          Defaults to \p omp::first_touch_allocator.
+ *
+ *  \see omp::first_touch_memory_resource
+ *  \see omp::vector
+ */
+template <typename T, typename Allocator = thrust::system::omp::first_touch_allocator<T>>
+using first_touch_vector = thrust::detail::vector_base<T, Allocator>;
+
 }} // namespace system::omp
 
 namespace omp
 {
 using thrust::system::omp::vector;
 using thrust::system::omp::universal_vector;
+using thrust::system::omp::first_touch_vector;
 }
 
 THRUST_NAMESPACE_END
@@ -14,6 +14,10 @@
  *  limitations under the License.
  */
 
+/*! \file adjacent_difference.h
+ *  \brief TBB implementation of adjacent_difference.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
@@ -24,7 +28,6 @@
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/tbb/detail/execution_policy.h>
-#include <thrust/system/detail/generic/adjacent_difference.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -34,6 +37,7 @@ namespace tbb
 namespace detail
 {
 
+
 template<typename DerivedPolicy,
          typename InputIterator,
          typename OutputIterator,
@@ -42,14 +46,13 @@ template<typename DerivedPolicy,
                                      InputIterator first,
                                      InputIterator last,
                                      OutputIterator result,
-                                     BinaryFunction binary_op)
-{
-  // tbb prefers generic::adjacent_difference to cpp::adjacent_difference
-  return thrust::system::detail::generic::adjacent_difference(exec, first, last, result, binary_op);
-} // end adjacent_difference()
+                                     BinaryFunction binary_op);
+
 
-} // end detail
-} // end tbb
-} // end system
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
 THRUST_NAMESPACE_END
 
+#include <thrust/system/tbb/detail/adjacent_difference.inl>
+
@@ -0,0 +1,184 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <tbb/blocked_range.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace adjacent_difference_detail
+{
+
+
+// the number of elements differenced by one task when no grain is requested
+const static int chunk_size = 1 << 14;
+
+
+// the output may alias the input only when it begins at the same element;
+// without raw pointers to compare, assume that it does
+template<typename InputIterator, typename OutputIterator>
+bool may_alias(InputIterator, OutputIterator)
+{
+  return true;
+}
+
+template<typename T, typename U>
+bool may_alias(T *first, U *result)
+{
+  return static_cast<const volatile void*>(first) == static_cast<const volatile void*>(result);
+}
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputType,
+         typename Size,
+         typename BinaryFunction>
+struct body
+{
+  RandomAccessIterator1 first;
+  RandomAccessIterator2 result;
+  const InputType *predecessors;
+  Size n;
+  Size chunk_size;
+  bool may_alias;
+  mutable BinaryFunction binary_op;
+
+  body(RandomAccessIterator1 first, RandomAccessIterator2 result, const InputType *predecessors,
+       Size n, Size chunk_size, bool may_alias, BinaryFunction binary_op)
+    : first(first), result(result), predecessors(predecessors),
+      n(n), chunk_size(chunk_size), may_alias(may_alias), binary_op(binary_op)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size chunk = r.begin(); chunk != r.end(); ++chunk)
+    {
+      Size begin = chunk * chunk_size;
+      Size end   = thrust::min<Size>(n, begin + chunk_size);
+
+      // the input before each later chunk was saved before any chunk was written
+      InputType prev = chunk == 0 ? InputType(first[0]) : predecessors[chunk - 1];
+
+      if(chunk == 0)
+      {
+        result[0] = prev;
+        ++begin;
+      }
+
+      if(may_alias)
+      {
+        // carry the previous input, which may already have been overwritten
+        for(Size i = begin; i < end; ++i)
+        {
+          InputType curr = first[i];
+          result[i] = binary_op(curr, prev);
+          prev = curr;
+        }
+      }
+      else if(begin < end)
+      {
+        // index both neighbours directly so that a chunk over raw pointers
+        // is a plain loop the compiler can vectorize
+        result[begin] = binary_op(first[begin], prev);
+
+        for(Size i = begin + 1; i < end; ++i)
+        {
+          result[i] = binary_op(first[i], first[i - 1]);
+        }
+      }
+    }
+  }
+}; // end body
+
+
+} // end adjacent_difference_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator adjacent_difference(execution_policy<DerivedPolicy> &exec,
+                                     InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result,
+                                     BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_value<InputIterator>::type      InputType;
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  Size n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return result;
+  }
+
+  typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<InputIterator>  Iterator1;
+  typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<OutputIterator> Iterator2;
+
+  Iterator1 raw_first  = thrust::detail::try_unwrap_contiguous_iterator(first);
+  Iterator2 raw_result = thrust::detail::try_unwrap_contiguous_iterator(result);
+
+  const tuning t = tuning_of(exec);
+  const Size chunk_size = static_cast<Size>(t.grain_size_or(adjacent_difference_detail::chunk_size));
+  const Size num_chunks = (n + chunk_size - 1) / chunk_size;
+
+  // an in-place difference only needs the last input of each chunk to be
+  // saved, rather than a copy of the whole input
+  thrust::detail::temporary_array<InputType, DerivedPolicy> predecessors(exec, num_chunks - 1);
+
+  for(Size chunk = 1; chunk < num_chunks; ++chunk)
+  {
+    predecessors[chunk - 1] = raw_first[chunk * chunk_size - 1];
+  }
+
+  typedef adjacent_difference_detail::body<Iterator1,Iterator2,InputType,Size,BinaryFunction> Body;
+  Body adjacent_difference_body(raw_first, raw_result, thrust::raw_pointer_cast(predecessors.data()),
+                                n, chunk_size, adjacent_difference_detail::may_alias(raw_first, raw_result),
+                                binary_op);
+  tuned_parallel_for(t, ::tbb::blocked_range<Size>(0, num_chunks), adjacent_difference_body);
+
+  return result + n;
+}
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
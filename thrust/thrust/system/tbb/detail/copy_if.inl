@@ -27,6 +27,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/system/tbb/detail/copy_if.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
+#include <thrust/system/tbb/detail/tuning.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_scan.h>
 
@@ -103,11 +104,12 @@ struct body
 
 } // end copy_if_detail
 
-template<typename InputIterator1,
+template<typename DerivedPolicy,
+         typename InputIterator1,
          typename InputIterator2,
          typename OutputIterator,
          typename Predicate>
-  OutputIterator copy_if(tag,
+  OutputIterator copy_if(execution_policy<DerivedPolicy> &exec,
                          InputIterator1 first,
                          InputIterator1 last,
                          InputIterator2 stencil,
@@ -122,7 +124,8 @@ template<typename InputIterator1,
   if (n != 0)
   {
     Body body(first, stencil, result, pred);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), body);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_scan(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), body);
     thrust::advance(result, body.sum);
   }
 
@@ -27,8 +27,10 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/distance.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
 
+#include <thrust/system/tbb/detail/tuning.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 
@@ -77,12 +79,16 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
 {
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0,n), for_each_detail::make_body<Size>(first,f));
+  const tuning t = tuning_of(exec);
+
+  // visit raw pointers rather than system references when the range is contiguous
+  tuned_parallel_for(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)),
+                     for_each_detail::make_body<Size>(thrust::detail::try_unwrap_contiguous_iterator(first), f));
 
   // return the end of the range
   return first + n;
@@ -14,6 +14,10 @@
  *  limitations under the License.
  */
 
+/*! \file inner_product.h
+ *  \brief TBB implementation of inner_product.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
@@ -23,7 +27,36 @@
 #else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
 _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/tbb/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputType,
+         typename BinaryFunction1,
+         typename BinaryFunction2>
+  OutputType inner_product(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           OutputType init,
+                           BinaryFunction1 binary_op1,
+                           BinaryFunction2 binary_op2);
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
 
-// this system inherits inner_product
-#include <thrust/system/cpp/detail/inner_product.h>
+#include <thrust/system/tbb/detail/inner_product.inl>
 
@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace inner_product_detail
+{
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OutputType,
+         typename BinaryFunction1,
+         typename BinaryFunction2>
+struct body
+{
+  RandomAccessIterator1 first1;
+  RandomAccessIterator2 first2;
+  OutputType sum;
+  bool first_call;  // TBB can invoke operator() multiple times on the same body
+  thrust::detail::wrapped_function<BinaryFunction1,OutputType> binary_op1;
+  thrust::detail::wrapped_function<BinaryFunction2,OutputType> binary_op2;
+
+  // note: we only initalize sum with init to avoid calling OutputType's default constructor
+  body(RandomAccessIterator1 first1, RandomAccessIterator2 first2, OutputType init,
+       BinaryFunction1 binary_op1, BinaryFunction2 binary_op2)
+    : first1(first1), first2(first2), sum(init), first_call(true),
+      binary_op1(binary_op1), binary_op2(binary_op2)
+  {}
+
+  // note: we only initalize sum with b.sum to avoid calling OutputType's default constructor
+  body(body& b, ::tbb::split)
+    : first1(b.first1), first2(b.first2), sum(b.sum), first_call(true),
+      binary_op1(b.binary_op1), binary_op2(b.binary_op2)
+  {}
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size> &r)
+  {
+    // we assume that blocked_range specifies a contiguous range of integers
+
+    if (r.empty()) return; // nothing to do
+
+    // index both sequences directly so that a chunk over raw pointers is a
+    // plain loop the compiler can vectorize
+    OutputType temp = binary_op2(first1[r.begin()], first2[r.begin()]);
+
+    for (Size i = r.begin() + 1; i != r.end(); ++i)
+      temp = binary_op1(temp, binary_op2(first1[i], first2[i]));
+
+    if (first_call)
+    {
+      // first time body has been invoked
+      first_call = false;
+      sum = temp;
+    }
+    else
+    {
+      // body has been previously invoked, accumulate temp into sum
+      sum = binary_op1(sum, temp);
+    }
+  } // end operator()()
+
+  void join(body& b)
+  {
+    sum = binary_op1(sum, b.sum);
+  }
+}; // end body
+
+} // end inner_product_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputType,
+         typename BinaryFunction1,
+         typename BinaryFunction2>
+  OutputType inner_product(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           OutputType init,
+                           BinaryFunction1 binary_op1,
+                           BinaryFunction2 binary_op2)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  Size n = thrust::distance(first1, last1);
+
+  if (n == 0)
+  {
+    return init;
+  }
+  else
+  {
+    // reduce over raw pointers rather than a zip of the two sequences when
+    // they are contiguous
+    typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<InputIterator1> Iterator1;
+    typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<InputIterator2> Iterator2;
+
+    typedef typename inner_product_detail::body<Iterator1,Iterator2,OutputType,BinaryFunction1,BinaryFunction2> Body;
+    Body inner_product_body(thrust::detail::try_unwrap_contiguous_iterator(first1),
+                            thrust::detail::try_unwrap_contiguous_iterator(first2),
+                            init, binary_op1, binary_op2);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_reduce(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), inner_product_body);
+    return binary_op1(init, inner_product_body.sum);
+  }
+}
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -30,6 +30,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/merge.h>
 #include <thrust/binary_search.h>
 #include <thrust/detail/seq.h>
+#include <thrust/system/tbb/detail/tuning.h>
 #include <tbb/parallel_for.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -234,7 +235,7 @@ template<typename DerivedPolicy,
          typename InputIterator2,
          typename OutputIterator,
          typename StrictWeakOrdering>
-OutputIterator merge(execution_policy<DerivedPolicy> &,
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
                      InputIterator1 first1,
                      InputIterator1 last1,
                      InputIterator2 first2,
@@ -244,10 +245,12 @@ OutputIterator merge(execution_policy<DerivedPolicy> &,
 {
   typedef typename merge_detail::range<InputIterator1,InputIterator2,OutputIterator,StrictWeakOrdering> Range;
   typedef          merge_detail::body                                                                   Body;
-  Range range(first1, last1, first2, last2, result, comp);
+  const tuning t = tuning_of(exec);
+
+  Range range(first1, last1, first2, last2, result, comp, t.grain_size_or(1024));
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  tuned_parallel_for(t, range, body);
 
   thrust::advance(result, thrust::distance(first1, last1) + thrust::distance(first2, last2));
 
@@ -263,7 +266,7 @@ template <typename DerivedPolicy,
           typename OutputIterator2,
           typename StrictWeakOrdering>
 thrust::pair<OutputIterator1,OutputIterator2>
-  merge_by_key(execution_policy<DerivedPolicy> &,
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
                InputIterator1 keys_first1,
                InputIterator1 keys_last1,
                InputIterator2 keys_first2,
@@ -277,10 +280,12 @@ thrust::pair<OutputIterator1,OutputIterator2>
   typedef typename merge_by_key_detail::range<InputIterator1,InputIterator2,InputIterator3,InputIterator4,OutputIterator1,OutputIterator2,StrictWeakOrdering> Range;
   typedef          merge_by_key_detail::body                                                                                                                  Body;
 
-  Range range(keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp);
+  const tuning t = tuning_of(exec);
+
+  Range range(keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp, t.grain_size_or(1024));
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  tuned_parallel_for(t, range, body);
 
   thrust::advance(keys_result,   thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
   thrust::advance(values_result, thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
@@ -29,6 +29,8 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
 #include <thrust/reduce.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/system/tbb/detail/tuning.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_reduce.h>
 
@@ -105,7 +107,7 @@ template<typename DerivedPolicy,
          typename InputIterator,
          typename OutputType,
          typename BinaryFunction>
-  OutputType reduce(execution_policy<DerivedPolicy> &,
+  OutputType reduce(execution_policy<DerivedPolicy> &exec,
                     InputIterator begin,
                     InputIterator end,
                     OutputType init,
@@ -121,9 +123,13 @@ template<typename DerivedPolicy,
   }
   else
   {
-    typedef typename reduce_detail::body<InputIterator,OutputType,BinaryFunction> Body;
-    Body reduce_body(begin, init, binary_op);
-    ::tbb::parallel_reduce(::tbb::blocked_range<Size>(0,n), reduce_body);
+    // reduce raw pointers rather than system references when the input is contiguous
+    typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<InputIterator> Iterator;
+
+    typedef typename reduce_detail::body<Iterator,OutputType,BinaryFunction> Body;
+    Body reduce_body(thrust::detail::try_unwrap_contiguous_iterator(begin), init, binary_op);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_reduce(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), reduce_body);
     return binary_op(init, reduce_body.sum);
   }
 }
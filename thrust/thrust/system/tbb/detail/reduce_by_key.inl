@@ -31,6 +31,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/detail/minmax.h>
 #include <thrust/detail/temporary_array.h>
 #include <thrust/detail/range/tail_flags.h>
+#include <thrust/system/tbb/detail/tuning.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 
@@ -277,8 +278,8 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   difference_type n = keys_last - keys_first;
   if(n == 0) return thrust::make_pair(keys_result, values_result);
 
-  // XXX this value is a tuning opportunity
-  const difference_type parallelism_threshold = 10000;
+  // a requested grain replaces the default minimum interval size
+  const difference_type parallelism_threshold = static_cast<difference_type>(tuning_of(exec).grain_size_or(10000));
 
   if(n < parallelism_threshold)
   {
@@ -292,7 +293,7 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   // generate O(P) intervals of sequential work
   // XXX oversubscribing is a tuning opportunity
   const unsigned int subscription_rate = 1;
-  difference_type interval_size = thrust::min<difference_type>(parallelism_threshold, thrust::max<difference_type>(n, n / (subscription_rate * p)));
+  difference_type interval_size = thrust::max<difference_type>(parallelism_threshold, reduce_by_key_detail::divide_ri(n, subscription_rate * p));
   difference_type num_intervals = reduce_by_key_detail::divide_ri(n, interval_size);
 
   // decompose the input into intervals of size N / num_intervals
@@ -314,7 +315,8 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   typedef typename reduce_by_key_detail::partial_sum_type<Iterator2,BinaryFunction>::type carry_type;
   thrust::detail::temporary_array<carry_type, DerivedPolicy> carries(0, exec, num_intervals - 1);
 
-  // force grainsize == 1 with simple_partioner()
+  // force grainsize == 1 with simple_partioner(); each body takes one whole interval,
+  // so the partitioner of the policy's tuning has nothing to balance and isn't used
   ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_intervals, 1),
     reduce_by_key_detail::make_serial_reduce_by_key_body(keys_first, values_first, interval_output_offsets.begin(), keys_result, values_result, carries.begin(), n, interval_size, num_intervals, binary_pred, binary_op),
     ::tbb::simple_partitioner());
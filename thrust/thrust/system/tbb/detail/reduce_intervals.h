@@ -31,6 +31,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/detail/minmax.h>
 #include <thrust/system/cpp/memory.h>
 #include <thrust/reduce.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
 #include <cassert>
 
 THRUST_NAMESPACE_BEGIN
@@ -106,7 +107,14 @@ template<typename DerivedPolicy, typename RandomAccessIterator1, typename Size,
 
   Size num_intervals = reduce_intervals_detail::divide_ri(n, interval_size);
 
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_intervals, 1), reduce_intervals_detail::make_body(first, result, Size(n), interval_size, binary_op), ::tbb::simple_partitioner());
+  // reduce raw pointers rather than system references when the input is contiguous;
+  // each body reduces one whole interval, chosen by the caller, so the partitioner
+  // of the policy's tuning has nothing to balance and isn't used
+  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_intervals, 1),
+                      reduce_intervals_detail::make_body(thrust::detail::try_unwrap_contiguous_iterator(first),
+                                                         thrust::detail::try_unwrap_contiguous_iterator(result),
+                                                         Size(n), interval_size, binary_op),
+                      ::tbb::simple_partitioner());
 }
 
 
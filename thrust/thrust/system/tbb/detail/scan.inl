@@ -25,12 +25,12 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #endif // !_CCCL_COMPILER_NVHPC
 #include <thrust/system/tbb/detail/scan.h>
 #include <thrust/distance.h>
-#include <thrust/advance.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/detail/type_traits/function_traits.h>
 #include <thrust/detail/type_traits/iterator/is_output_iterator.h>
+#include <thrust/system/tbb/detail/tuning.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_scan.h>
 
@@ -198,10 +198,11 @@ struct exclusive_body
 
 } // end scan_detail
 
-template<typename InputIterator,
+template<typename DerivedPolicy,
+         typename InputIterator,
          typename OutputIterator,
          typename BinaryFunction>
-  OutputIterator inclusive_scan(tag,
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -219,19 +220,19 @@ template<typename InputIterator,
   {
     typedef typename scan_detail::inclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, *first);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_scan(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), scan_body);
   }
 
-  thrust::advance(result, n);
-
-  return result;
+  return result + n;
 }
 
-template<typename InputIterator,
+template<typename DerivedPolicy,
+         typename InputIterator,
          typename OutputIterator,
          typename InitialValueType,
          typename BinaryFunction>
-  OutputIterator exclusive_scan(tag,
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -250,12 +251,11 @@ template<typename InputIterator,
   {
     typedef typename scan_detail::exclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, init);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_scan(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), scan_body);
   }
 
-  thrust::advance(result, n);
-
-  return result;
+  return result + n;
 }
 
 } // end namespace detail
@@ -0,0 +1,294 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/tbb/detail/scan_by_key.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+// The summary of a range is the sum of its last segment, and whether that sum
+// is closed, i.e. whether the segment begins inside the range, so that the
+// sum doesn't depend on what comes before the range. The first and last keys
+// of the range tell whether the ranges on either side of a boundary belong to
+// the same segment; they are copied as soon as a range is visited, because
+// the output may overwrite the keys.
+//
+// An exclusive scan is handled as an inclusive scan of the values, with init
+// combined into the first value of each segment.
+template<bool Exclusive,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename KeyType,
+         typename ValueType>
+struct body
+{
+  InputIterator1 keys;
+  InputIterator2 values;
+  OutputIterator output;
+  thrust::detail::wrapped_function<BinaryPredicate,bool>      binary_pred;
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> binary_op;
+  ValueType init;
+  ValueType sum;
+  KeyType first_key;
+  KeyType last_key;
+  bool closed;
+  bool first_call;
+
+  body(InputIterator1 keys, InputIterator2 values, OutputIterator output, BinaryPredicate binary_pred, BinaryFunction binary_op, KeyType dummy_key, ValueType init)
+    : keys(keys), values(values), output(output), binary_pred(binary_pred), binary_op(binary_op), init(init), sum(init), first_key(dummy_key), last_key(dummy_key), closed(false), first_call(true)
+  {}
+
+  body(body& b, ::tbb::split)
+    : keys(b.keys), values(b.values), output(b.output), binary_pred(b.binary_pred), binary_op(b.binary_op), init(b.init), sum(b.sum), first_key(b.first_key), last_key(b.last_key), closed(false), first_call(true)
+  {}
+
+  // the sum of a segment beginning with value
+  template<typename T>
+  ValueType begin_segment(const T &value)
+  {
+    return Exclusive ? binary_op(init, value) : ValueType(value);
+  }
+
+  // appends the summary of the range following this one
+  void join_right(const ValueType &right_sum, bool right_closed, const KeyType &right_first_key, const KeyType &right_last_key)
+  {
+    bool boundary = !binary_pred(last_key, right_first_key);
+
+    if (right_closed)
+      sum = right_sum;
+    else if (boundary)
+      sum = Exclusive ? binary_op(init, right_sum) : right_sum;
+    else
+      sum = binary_op(sum, right_sum);
+
+    closed   = closed || boundary || right_closed;
+    last_key = right_last_key;
+  }
+
+  template<typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  {
+    KeyType   prev_key    = keys[r.begin()];
+    KeyType   range_first = prev_key;
+    bool      temp_closed = r.begin() == 0;
+    ValueType temp        = temp_closed ? begin_segment(values[r.begin()]) : ValueType(values[r.begin()]);
+
+    for (Size i = r.begin() + 1; i != r.end(); ++i)
+    {
+      KeyType key = keys[i];
+
+      if (binary_pred(prev_key, key))
+      {
+        temp = binary_op(temp, values[i]);
+      }
+      else
+      {
+        temp        = begin_segment(values[i]);
+        temp_closed = true;
+      }
+
+      prev_key = key;
+    }
+
+    if (first_call)
+    {
+      sum       = temp;
+      closed    = temp_closed;
+      first_key = range_first;
+      last_key  = prev_key;
+    }
+    else
+    {
+      join_right(temp, temp_closed, range_first, prev_key);
+    }
+
+    first_call = false;
+  }
+
+  template<typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
+  {
+    KeyType prev_key = last_key;
+
+    if (first_call)
+    {
+      first_key = keys[r.begin()];
+    }
+
+    for (Size i = r.begin(); i != r.end(); ++i)
+    {
+      // read the key before the output may overwrite it
+      KeyType key = keys[i];
+
+      bool head = (i == r.begin()) ? (first_call || !binary_pred(prev_key, key)) : !binary_pred(prev_key, key);
+
+      if (Exclusive)
+      {
+        if (head)
+          sum = init;
+
+        // temporary value allows in-situ scan
+        ValueType temp = binary_op(sum, values[i]);
+        output[i] = sum;
+        sum = temp;
+      }
+      else
+      {
+        if (head)
+          sum = values[i];
+        else
+          sum = binary_op(sum, values[i]);
+
+        output[i] = sum;
+      }
+
+      prev_key   = key;
+      first_call = false;
+    }
+
+    last_key = prev_key;
+    closed   = true;
+  }
+
+  void reverse_join(body& b)
+  {
+    // Only accumulate this functor's partial sum if this functor has been
+    // called at least once.
+    if (!first_call)
+    {
+      ValueType right_sum       = sum;
+      bool      right_closed    = closed;
+      KeyType   right_first_key = first_key;
+      KeyType   right_last_key  = last_key;
+
+      sum       = b.sum;
+      closed    = b.closed;
+      first_key = b.first_key;
+      last_key  = b.last_key;
+
+      join_right(right_sum, right_closed, right_first_key, right_last_key);
+    }
+  }
+
+  void assign(body& b)
+  {
+    sum       = b.sum;
+    closed    = b.closed;
+    first_key = b.first_key;
+    last_key  = b.last_key;
+  }
+};
+
+} // end scan_by_key_detail
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  using namespace thrust::detail;
+
+  using KeyType   = typename thrust::iterator_value<InputIterator1>::type;
+  using ValueType = typename thrust::iterator_value<InputIterator2>::type;
+
+  using Size = typename thrust::iterator_difference<InputIterator1>::type;
+  Size n = thrust::distance(first1, last1);
+
+  if (n != 0)
+  {
+    typedef typename scan_by_key_detail::body<false,InputIterator1,InputIterator2,OutputIterator,BinaryPredicate,BinaryFunction,KeyType,ValueType> Body;
+    Body scan_body(first1, first2, result, binary_pred, binary_op, *first1, *first2);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_scan(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), scan_body);
+  }
+
+  return result + n;
+}
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  using namespace thrust::detail;
+
+  using KeyType   = typename thrust::iterator_value<InputIterator1>::type;
+  using ValueType = T;
+
+  using Size = typename thrust::iterator_difference<InputIterator1>::type;
+  Size n = thrust::distance(first1, last1);
+
+  if (n != 0)
+  {
+    typedef typename scan_by_key_detail::body<true,InputIterator1,InputIterator2,OutputIterator,BinaryPredicate,BinaryFunction,KeyType,ValueType> Body;
+    Body scan_body(first1, first2, result, binary_pred, binary_op, *first1, init);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_scan(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), scan_body);
+  }
+
+  return result + n;
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/tbb/detail/shuffle.h>
+#include <thrust/shuffle.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <thrust/system/detail/generic/shuffle.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace shuffle_detail
+{
+
+// scans the number of indices the bijection maps into [0, m), to know where to write the element
+// each of them is mapped to; like copy_if with the bijection as the stencil
+template<typename RandomIterator,
+         typename OutputIterator>
+struct body
+{
+
+  RandomIterator first;
+  OutputIterator result;
+  thrust::system::detail::generic::feistel_bijection bijection;
+  std::uint64_t m;
+  std::uint64_t sum;
+
+  body(RandomIterator first, OutputIterator result, thrust::system::detail::generic::feistel_bijection bijection, std::uint64_t m)
+    : first(first), result(result), bijection(bijection), m(m), sum(0)
+  {}
+
+  body(body& b, ::tbb::split)
+    : first(b.first), result(b.result), bijection(b.bijection), m(b.m), sum(0)
+  {}
+
+  void operator()(const ::tbb::blocked_range<std::uint64_t>& r, ::tbb::pre_scan_tag)
+  {
+    for (std::uint64_t i = r.begin(); i != r.end(); ++i)
+    {
+      sum += bijection(i) < m;
+    }
+  }
+
+  void operator()(const ::tbb::blocked_range<std::uint64_t>& r, ::tbb::final_scan_tag)
+  {
+    OutputIterator iter = result + sum;
+
+    for (std::uint64_t i = r.begin(); i != r.end(); ++i)
+    {
+      std::uint64_t key = bijection(i);
+
+      if (key < m)
+      {
+        *iter = first[key];
+        ++sum;
+        ++iter;
+      }
+    }
+  }
+
+  void reverse_join(body& b)
+  {
+    sum = b.sum + sum;
+  }
+
+  void assign(body& b)
+  {
+    sum = b.sum;
+  }
+}; // end body
+
+} // end shuffle_detail
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename OutputIterator,
+         typename URBG>
+  void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                    RandomIterator first,
+                    RandomIterator last,
+                    OutputIterator result,
+                    URBG &&g)
+{
+  // the same permutation as the generic implementation: the bijection permutes [0, n), where n is
+  // the power of two above m, and the indices it maps into [0, m) are kept in order
+  std::uint64_t m = thrust::distance(first, last);
+  thrust::system::detail::generic::feistel_bijection bijection(m, g);
+  std::uint64_t n = bijection.nearest_power_of_two();
+
+  typedef shuffle_detail::body<RandomIterator,OutputIterator> Body;
+
+  Body body(first, result, bijection, m);
+  const tuning t = tuning_of(exec);
+  tuned_parallel_scan(t, ::tbb::blocked_range<std::uint64_t>(0, n, t.grain_size_or(1)), body);
+} // end shuffle_copy()
+
+} // end detail
+} // end tbb
+} // end system
+THRUST_NAMESPACE_END
+
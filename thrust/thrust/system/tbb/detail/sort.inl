@@ -30,7 +30,14 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/merge.h>
 #include <thrust/sort.h>
 #include <thrust/detail/seq.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
+#include <tbb/task_arena.h>
+
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -78,7 +85,7 @@ void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterato
 
   difference_type n = thrust::distance(first1, last1);
 
-  if (n < threshold)
+  if (n < static_cast<difference_type>(tuning_of(exec).grain_size_or(threshold)))
   {
     thrust::stable_sort(thrust::seq, first1, last1, comp);
 
@@ -193,7 +200,7 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
   Iterator2 last2 = first2 + n;
   Iterator3 last3 = first3 + n;
 
-  if (n < threshold)
+  if (n < static_cast<difference_type>(tuning_of(exec).grain_size_or(threshold)))
   {
     thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
 
@@ -227,13 +234,73 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
 } // end namespace sort_detail
 
 
+namespace radix_sort_detail
+{
+
+
+// below this size the sequential radix sort of a single thread wins
+const static int threshold = 1 << 16;
+
+
+using thrust::system::detail::internal::radix_sort_detail::use_radix_sort;
+
+
+template<typename Body>
+struct tile_body
+{
+  Body body;
+
+  tile_body(Body body)
+    : body(body)
+  {}
+
+  template<typename Size>
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      body(i);
+    }
+  }
+};
+
+
+struct tile_loop
+{
+  template<typename Size, typename Body>
+  void operator()(Size num_tiles, Body body) const
+  {
+    // force grainsize == 1 with simple_partioner()
+    ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_tiles, 1),
+                        tile_body<Body>(body),
+                        ::tbb::simple_partitioner());
+  }
+};
+
+
+// one tile per thread of the current task arena, but never tiles smaller
+// than a requested grain
+template<typename DerivedPolicy, typename Size>
+Size num_tiles(execution_policy<DerivedPolicy> &exec, Size n)
+{
+  const Size p = thrust::max<Size>(1, ::tbb::this_task_arena::max_concurrency());
+  const Size g = static_cast<Size>(tuning_of(exec).grain_size_or(1));
+
+  return thrust::max<Size>(1, thrust::min<Size>(p, n / g));
+}
+
+
+} // end namespace radix_sort_detail
+
+
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename StrictWeakOrdering>
 void stable_sort(execution_policy<DerivedPolicy> &exec,
                  RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
 
@@ -243,6 +310,30 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
 }
 
 
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+
+  const difference_type n         = thrust::distance(first, last);
+  const difference_type num_tiles = radix_sort_detail::num_tiles(exec, n);
+
+  if(n < radix_sort_detail::threshold || num_tiles == 1)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<false>(radix_sort_detail::tile_loop(), exec, first, static_cast<int*>(0), n, num_tiles, comp);
+}
+
+
 template<typename DerivedPolicy,
          typename RandomAccessIterator1,
          typename RandomAccessIterator2,
@@ -251,7 +342,8 @@ template<typename DerivedPolicy,
                           RandomAccessIterator1 first1,
                           RandomAccessIterator1 last1,
                           RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+                          StrictWeakOrdering comp,
+                          thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
   typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
@@ -265,6 +357,62 @@ template<typename DerivedPolicy,
 }
 
 
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+  const difference_type n         = thrust::distance(first1, last1);
+  const difference_type num_tiles = radix_sort_detail::num_tiles(exec, n);
+
+  if(n < radix_sort_detail::threshold || num_tiles == 1)
+  {
+    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<true>(radix_sort_detail::tile_loop(), exec, first1, first2, n, num_tiles, comp);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  stable_sort(exec, first, last, comp, radix_sort_detail::use_radix_sort<key_type,StrictWeakOrdering>());
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  stable_sort_by_key(exec, first1, last1, first2, comp, radix_sort_detail::use_radix_sort<key_type,StrictWeakOrdering>());
+}
+
+
 } // end namespace detail
 } // end namespace tbb
 } // end namespace system
@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace transform_reduce_detail
+{
+
+template<typename RandomAccessIterator,
+         typename OutputType,
+         typename UnaryFunction,
+         typename BinaryFunction>
+struct body
+{
+  RandomAccessIterator first;
+  OutputType sum;
+  bool first_call;  // TBB can invoke operator() multiple times on the same body
+  thrust::detail::wrapped_function<UnaryFunction,OutputType> unary_op;
+  thrust::detail::wrapped_function<BinaryFunction,OutputType> binary_op;
+
+  // note: we only initalize sum with init to avoid calling OutputType's default constructor
+  body(RandomAccessIterator first, OutputType init, UnaryFunction unary_op, BinaryFunction binary_op)
+    : first(first), sum(init), first_call(true), unary_op(unary_op), binary_op(binary_op)
+  {}
+
+  // note: we only initalize sum with b.sum to avoid calling OutputType's default constructor
+  body(body& b, ::tbb::split)
+    : first(b.first), sum(b.sum), first_call(true), unary_op(b.unary_op), binary_op(b.binary_op)
+  {}
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size> &r)
+  {
+    // we assume that blocked_range specifies a contiguous range of integers
+
+    if (r.empty()) return; // nothing to do
+
+    // apply unary_op in the same loop as the reduction instead of through a
+    // transform_iterator, so that a chunk over raw pointers can be vectorized
+    OutputType temp = unary_op(first[r.begin()]);
+
+    for (Size i = r.begin() + 1; i != r.end(); ++i)
+      temp = binary_op(temp, unary_op(first[i]));
+
+    if (first_call)
+    {
+      // first time body has been invoked
+      first_call = false;
+      sum = temp;
+    }
+    else
+    {
+      // body has been previously invoked, accumulate temp into sum
+      sum = binary_op(sum, temp);
+    }
+  } // end operator()()
+
+  void join(body& b)
+  {
+    sum = binary_op(sum, b.sum);
+  }
+}; // end body
+
+} // end transform_reduce_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename UnaryFunction,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType transform_reduce(execution_policy<DerivedPolicy> &exec,
+                              InputIterator first,
+                              InputIterator last,
+                              UnaryFunction unary_op,
+                              OutputType init,
+                              BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  Size n = thrust::distance(first, last);
+
+  if (n == 0)
+  {
+    return init;
+  }
+  else
+  {
+    typedef thrust::detail::try_unwrap_contiguous_iterator_return_t<InputIterator> Iterator;
+
+    typedef typename transform_reduce_detail::body<Iterator,OutputType,UnaryFunction,BinaryFunction> Body;
+    Body transform_reduce_body(thrust::detail::try_unwrap_contiguous_iterator(first), init, unary_op, binary_op);
+    const tuning t = tuning_of(exec);
+    tuned_parallel_reduce(t, ::tbb::blocked_range<Size>(0, n, t.grain_size_or(1)), transform_reduce_body);
+    return binary_op(init, transform_reduce_body.sum);
+  }
+}
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
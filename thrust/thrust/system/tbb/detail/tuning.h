@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file tuning.h
+ *  \brief Grain size and partitioner selection for the TBB backend.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_COMPILER_NVHPC) && defined(_CCCL_USE_IMPLICIT_SYSTEM_DEADER)
+#pragma GCC system_header
+#else // ^^^ _CCCL_COMPILER_NVHPC ^^^ / vvv !_CCCL_COMPILER_NVHPC vvv
+_CCCL_IMPLICIT_SYSTEM_HEADER
+#endif // !_CCCL_COMPILER_NVHPC
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+
+#include <cstddef>
+#include <utility>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+// the minimum number of elements a parallel loop hands to one body
+struct grain
+{
+  explicit grain(std::size_t size)
+    : size(size)
+  {}
+
+  std::size_t size;
+};
+
+
+struct tuning
+{
+  enum partitioner_kind
+  {
+    auto_partitioner,
+    simple_partitioner,
+    static_partitioner,
+    affinity_partitioner
+  };
+
+  // zero selects each algorithm's own default
+  std::size_t                  grain_size;
+  partitioner_kind             partitioner;
+  ::tbb::affinity_partitioner *affinity;
+
+  tuning()
+    : grain_size(0), partitioner(auto_partitioner), affinity(0)
+  {}
+
+  void set(const grain &g)                       { grain_size = g.size; }
+  void set(const ::tbb::auto_partitioner &)      { partitioner = auto_partitioner; }
+  void set(const ::tbb::simple_partitioner &)    { partitioner = simple_partitioner; }
+  void set(const ::tbb::static_partitioner &)    { partitioner = static_partitioner; }
+
+  // an affinity_partitioner replays the mapping of its previous loop, so
+  // the caller's object must outlive the policy; a temporary never would
+  void set(::tbb::affinity_partitioner &ap)
+  {
+    partitioner = affinity_partitioner;
+    affinity    = &ap;
+  }
+
+  void set(::tbb::affinity_partitioner &&) = delete;
+
+  std::size_t grain_size_or(std::size_t default_grain_size) const
+  {
+    return grain_size ? grain_size : default_grain_size;
+  }
+};
+
+
+template<typename Derived>
+struct execute_with_tuning_base : execution_policy<Derived>
+{
+private:
+  tuning m_tuning;
+
+public:
+  execute_with_tuning_base() {}
+
+  // accepts any mix of grain and ::tbb partitioners; later arguments
+  // override earlier ones
+  template<typename... Args>
+  Derived with(Args&&... args) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+
+    int expand[] = {0, (result.m_tuning.set(std::forward<Args>(args)), 0)...};
+    (void) expand;
+
+    return result;
+  }
+
+private:
+  friend tuning get_tuning(const execute_with_tuning_base &exec)
+  {
+    return exec.m_tuning;
+  }
+};
+
+
+struct execute_with_tuning : execute_with_tuning_base<execute_with_tuning>
+{};
+
+
+template<typename Derived>
+tuning get_tuning(execution_policy<Derived> &)
+{
+  return tuning();
+}
+
+
+// entry point for algorithms
+template<typename Derived>
+tuning tuning_of(execution_policy<Derived> &exec)
+{
+  return get_tuning(thrust::detail::derived_cast(exec));
+}
+
+
+template<typename Range, typename Body>
+void tuned_parallel_for(const tuning &t, const Range &range, const Body &body)
+{
+  switch(t.partitioner)
+  {
+    case tuning::simple_partitioner:
+      ::tbb::parallel_for(range, body, ::tbb::simple_partitioner());
+      break;
+    case tuning::static_partitioner:
+      ::tbb::parallel_for(range, body, ::tbb::static_partitioner());
+      break;
+    case tuning::affinity_partitioner:
+      ::tbb::parallel_for(range, body, *t.affinity);
+      break;
+    default:
+      ::tbb::parallel_for(range, body, ::tbb::auto_partitioner());
+      break;
+  }
+}
+
+
+template<typename Range, typename Body>
+void tuned_parallel_reduce(const tuning &t, const Range &range, Body &body)
+{
+  switch(t.partitioner)
+  {
+    case tuning::simple_partitioner:
+      ::tbb::parallel_reduce(range, body, ::tbb::simple_partitioner());
+      break;
+    case tuning::static_partitioner:
+      ::tbb::parallel_reduce(range, body, ::tbb::static_partitioner());
+      break;
+    case tuning::affinity_partitioner:
+      ::tbb::parallel_reduce(range, body, *t.affinity);
+      break;
+    default:
+      ::tbb::parallel_reduce(range, body, ::tbb::auto_partitioner());
+      break;
+  }
+}
+
+
+// parallel_scan only accepts the simple and auto partitioners
+template<typename Range, typename Body>
+void tuned_parallel_scan(const tuning &t, const Range &range, Body &body)
+{
+  if(t.partitioner == tuning::simple_partitioner)
+  {
+    ::tbb::parallel_scan(range, body, ::tbb::simple_partitioner());
+  }
+  else
+  {
+    ::tbb::parallel_scan(range, body, ::tbb::auto_partitioner());
+  }
+}
+
+
+} // end detail
+
+
+using thrust::system::tbb::detail::grain;
+
+
+} // end tbb
+} // end system
+
+
+namespace tbb
+{
+
+
+using thrust::system::tbb::grain;
+
+
+} // end tbb
+THRUST_NAMESPACE_END
+
@@ -67,6 +67,7 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/system/tbb/detail/scatter.h>
 #include <thrust/system/tbb/detail/sequence.h>
 #include <thrust/system/tbb/detail/set_operations.h>
+#include <thrust/system/tbb/detail/shuffle.h>
 #include <thrust/system/tbb/detail/sort.h>
 #include <thrust/system/tbb/detail/swap_ranges.h>
 #include <thrust/system/tbb/detail/tabulate.h>
@@ -145,10 +146,36 @@ struct tag : thrust::system::tbb::execution_policy<tag> { unspecified };
  *
  *  // 0 1 2 is printed to standard output in some unspecified order
  *  \endcode
+ *
+ *  \p par.with() returns a copy of the policy which carries tuning for the TBB loops of every
+ *  algorithm it is passed to. It accepts a \p thrust::tbb::grain, the minimum number of elements
+ *  handed to a single task, and any of <tt>::tbb::auto_partitioner</tt>,
+ *  <tt>::tbb::simple_partitioner</tt>, <tt>::tbb::static_partitioner</tt> or a
+ *  <tt>::tbb::affinity_partitioner</tt>, which is held by reference and must outlive the policy;
+ *  passing a temporary \p affinity_partitioner does not compile.
+ *  Later arguments override earlier ones, and the result also supports \p with().
+ *
+ *  Loops which hand one precomputed interval to each task, such as the ones of \p reduce_by_key,
+ *  always use <tt>::tbb::simple_partitioner</tt>, since there is nothing left for a partitioner
+ *  to balance.
+ *
+ *  \code
+ *  thrust::for_each(thrust::tbb::par.with(thrust::tbb::grain(65536), ::tbb::static_partitioner()),
+ *                   vec.begin(), vec.end(), printf_functor());
+ *  \endcode
  */
 static const unspecified par;
 
 
+/*! \p thrust::tbb::grain requests that the TBB loops of an algorithm never hand fewer than
+ *  \p size elements to a single task. Pass it to \p thrust::tbb::par.with().
+ */
+struct grain
+{
+  explicit grain(std::size_t size);
+};
+
+
 /*! \}
  */
 
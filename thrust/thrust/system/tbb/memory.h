@@ -90,6 +90,16 @@ using universal_allocator = thrust::mr::stateless_resource_allocator<
   T, thrust::system::tbb::universal_memory_resource
 >;
 
+/*! \p tbb::first_touch_allocator allocates storage with
+ *  \p tbb::first_touch_memory_resource, which places large allocations on
+ *  the NUMA nodes of the threads of the \p tbb system that will work on
+ *  them.
+ */
+template<typename T>
+using first_touch_allocator = thrust::mr::stateless_resource_allocator<
+  T, thrust::system::tbb::first_touch_memory_resource
+>;
+
 }} // namespace system::tbb
 
 /*! \namespace thrust::tbb
@@ -101,6 +111,7 @@ using thrust::system::tbb::malloc;
 using thrust::system::tbb::free;
 using thrust::system::tbb::allocator;
 using thrust::system::tbb::universal_allocator;
+using thrust::system::tbb::first_touch_allocator;
 } // namsespace tbb
 
 THRUST_NAMESPACE_END
@@ -31,6 +31,11 @@ _CCCL_IMPLICIT_SYSTEM_HEADER
 #include <thrust/mr/fancy_pointer_resource.h>
 
 #include <thrust/system/tbb/pointer.h>
+#include <thrust/system/detail/internal/first_touch_resource.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system { namespace tbb
@@ -48,6 +53,35 @@ namespace detail
         thrust::mr::new_delete_resource,
         thrust::tbb::universal_pointer<void>
     > universal_native_resource;
+
+    // the pages are split evenly between the worker threads, in contiguous blocks
+    struct page_toucher
+    {
+        struct body
+        {
+            char * p;
+            std::size_t page_size;
+
+            void operator()(const ::tbb::blocked_range<std::size_t> & r) const
+            {
+                for (std::size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    p[i * page_size] = 0;
+                }
+            }
+        };
+
+        static void touch(char * p, std::size_t pages, std::size_t page_size)
+        {
+            body b = { p, page_size };
+            ::tbb::parallel_for(::tbb::blocked_range<std::size_t>(0, pages), b, ::tbb::static_partitioner());
+        }
+    };
+
+    typedef thrust::mr::fancy_pointer_resource<
+        thrust::system::detail::internal::first_touch_resource<page_toucher>,
+        thrust::tbb::pointer<void>
+    > first_touch_native_resource;
 } // namespace detail
 //! \endcond
 
@@ -66,6 +100,15 @@ typedef detail::native_resource memory_resource;
 typedef detail::universal_native_resource universal_memory_resource;
 /*! An alias for \p tbb::universal_memory_resource. */
 typedef detail::native_resource universal_host_pinned_memory_resource;
+/*! A memory resource for the TBB system that places the memory of large
+ *  allocations on the NUMA nodes of the threads that will work on it. Every
+ *  page of an allocation of at least 256 KiB is written to by the threads of
+ *  the TBB system as soon as it is allocated, each thread writing to the
+ *  pages that hold the elements it processes in a parallel algorithm, and the
+ *  operating system places a page on the node of the thread that first writes
+ *  to it. Uses \p mr::new_delete_resource and tags it with \p tbb::pointer.
+ */
+typedef detail::first_touch_native_resource first_touch_memory_resource;
 
 /*! \} // memory_resources
  */
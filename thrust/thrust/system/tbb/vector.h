@@ -77,12 +77,30 @@ using vector = thrust::detail::vector_base<T, Allocator>;
 template <typename T, typename Allocator = thrust::system::tbb::universal_allocator<T>>
 using universal_vector = thrust::detail::vector_base<T, Allocator>;
 
+/*! \p tbb::first_touch_vector is a \p tbb::vector whose elements are
+ *  placed on the NUMA nodes of the threads of the \p tbb system that
+ *  process them in parallel algorithms, rather than all on the node of the
+ *  thread that allocated the vector. Large vectors benefit from it on systems
+ *  with several NUMA nodes, when they are initialized and later processed by
+ *  parallel algorithms of the \p tbb system.
+ *
+ *  \tparam T The element type of the \p tbb::first_touch_vector.
+ *  \tparam Allocator The allocator type of the \p tbb::first_touch_vector.
+ *          Defaults to \p tbb::first_touch_allocator.
+ *
+ *  \see tbb::first_touch_memory_resource
+ *  \see tbb::vector
+ */
+template <typename T, typename Allocator = thrust::system::tbb::first_touch_allocator<T>>
+using first_touch_vector = thrust::detail::vector_base<T, Allocator>;
+
 }} // namespace system::tbb
 
 namespace tbb
 {
 using thrust::system::tbb::vector;
 using thrust::system::tbb::universal_vector;
+using thrust::system::tbb::first_touch_vector;
 }
 
 THRUST_NAMESPACE_END